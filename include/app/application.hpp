@@ -3,51 +3,296 @@
 
 #include "audio/audio_manager.hpp"
 #include "codec/opus_codec.hpp"
+#include "codec/opus_packetizer.hpp"
 #include "streaming/slicer.hpp"
 #include "streaming/collector.hpp"
+#include "streaming/feedback.hpp"
+#include "streaming/bitrate_controller.hpp"
 #include "network/udp_sender.hpp"
 #include "network/udp_receiver.hpp"
 #include "processing/echo_canceller.hpp"
 #include "processing/noise_suppressor.hpp"
+#include "processing/delay_estimator.hpp"
+#include "processing/voice_activity_detector.hpp"
+#include "core/spsc_ring_buffer.hpp"
 #include <string>
 #include <memory>
 #include <vector>
+#include <array>
 #include <cstdint>
-#include <mutex>
+#include <thread>
+#include <atomic>
 
 namespace app {
+    struct ApplicationOptions {
+        // true: PortAudio callback'i sadece ham frame'leri kuyruğa atar; AEC, NS,
+        // encode ve gönderme ayrı bir capture thread'inde yapılır.
+        // false: tüm işleme eskisi gibi callback içinde yapılır.
+        bool threaded_capture = true;
+        int capture_cpu = -1;           // Capture thread'inin sabitleneceği CPU (-1: sabitleme yok)
+        size_t capture_queue_frames = 32; // Kuyruk kapasitesi (frame, 10ms)
+
+        // Eko giderici ayarları. Uzun oda kuyrukları (100-250 ms, 4800-12000 tap)
+        // için PartitionedBlock motoru kullanılmalı.
+        processing::EchoCanceller::Engine echo_engine = processing::EchoCanceller::Engine::TimeDomainNlms;
+        size_t echo_filter_length = 512;  // Toplu gecikme hizalandığında sadece oda yanıtı (~10 ms)
+        float echo_step_size = 0.1f;
+
+        // Hoparlör -> mikrofon toplu gecikmesini (PortAudio gecikmeleri + yayılım)
+        // tahmin edip eko referansını hizalar
+        bool echo_delay_estimation = true;
+        int max_echo_delay_ms = 250;
+
+        // Konuşma tespiti: sessiz frame'lerde NS ve Opus encode atlanır, sadece her
+        // comfort_noise_interval_ms'de bir DTX (comfort noise) işareti gönderilir.
+        // false: her frame kodlanıp gönderilir.
+        bool voice_activity_detection = true;
+        int comfort_noise_interval_ms = 200;
+
+        // Bir pakette gönderilen ses süresi (10, 20, 30, 40, 50 veya 60 ms). 10 ms'nin
+        // üstünde kodlanmış 10 ms frame'ler tek Opus paketinde birleştirilir: başlık yükü
+        // ve paket hızı düşer, gecikme ve kayıptaki boşluk paket süresi kadar artar.
+        // Çalışırken set_packet_duration_ms ile değiştirilebilir.
+        int packet_duration_ms = 10;
+
+        // Alıcı geri bildirimi: her feedback_interval_ms'de karşı tarafa kayıp, jitter ve alım
+        // hızı raporu gönderilir. adaptive_bitrate ile gelen raporlar bitrate, beklenen
+        // kayıp, FEC ve (capture thread'inin yüküne göre) karmaşıklığı ayarlar; false ise
+        // encoder sabit ayarlarla çalışır ama rapor gönderimi sürer.
+        bool adaptive_bitrate = true;
+        int feedback_interval_ms = 250;
+        streaming::BitrateController::Options bitrate_control;
+
+        // Gönderim tarafı tıkanıklık kontrolü: karşı taraf her arrival_feedback_interval_ms'de
+        // medya paketlerinin geliş zamanlarını geri gönderir; sender kuyruk gecikmesinin
+        // eğiliminden hedef hız çıkarır ve paketleri bu hıza göre pacer'dan geçirir.
+        // adaptive_bitrate ile encoder bitrate'i, başlıklar düşülmüş hedefi de aşmaz.
+        bool congestion_control = true;
+        int arrival_feedback_interval_ms = 50;
+        network::DelayBasedController::Options congestion_rate;
+
+        // Uygulama seviyesi FEC: her fec_media_packets medya datagramına fec_parity_packets
+        // parite paketi eklenir; karşı taraf bir gruptan parite sayısı kadar (ardışık da
+        // olsa) kaybı oynatmadan önce geri kurar (1: XOR, fazlası Reed–Solomon). Gönderim
+        // hızı yaklaşık (K + R) / K katına çıkar; tıkanıklık kontrolünde encoder'ın payı buna
+        // göre küçülür. fec_parity_packets = 0 kapalıdır. Çalışırken set_fec ile değiştirilebilir.
+        int fec_media_packets = 5;
+        int fec_parity_packets = 0;
+
+        // Ağ G/Ç yolu. IoUring mevcut değilse soket yoluna dönülür.
+        network::IoBackend io_backend = network::IoBackend::Socket;
+    };
+
+    // Capture thread'i boyutlandırmak için istatistikler
+    struct CapturePipelineStats {
+        size_t queue_depth = 0;          // Anlık kuyruk derinliği (frame)
+        size_t max_queue_depth = 0;      // Gözlenen en yüksek derinlik
+        uint64_t frames_processed = 0;
+        uint64_t frames_dropped = 0;     // Kuyruk dolu olduğu için atılan frame'ler
+        double avg_process_us = 0.0;     // Frame başına ortalama işleme süresi
+        double max_process_us = 0.0;     // Frame başına en yüksek işleme süresi
+        uint64_t frames_silent = 0;      // VAD'ın sessiz bulduğu (kodlanmayan) frame'ler
+        uint64_t comfort_noise_sent = 0; // Gönderilen comfort noise işaretleri
+    };
+
+    // Alma tarafı istatistikleri
+    struct PlayoutStats {
+        streaming::JitterBufferStats jitter;
+        uint64_t frames_recovered = 0;   // Bir sonraki paketin FEC verisiyle kurtarılan kayıp frame'ler
+        uint64_t frames_concealed = 0;   // FEC olmadığı için PLC ile gizlenen kayıp frame'ler
+        core::BufferPoolStats packet_pool;  // Alım buffer havuzu doluluğu ve boşalmaları
+        // Paketin çekirdeğe ulaşmasından callback'e kadar geçen süre: ağ jitter'ından
+        // ayrı olarak alım thread'inin zamanlama gecikmesi
+        double avg_receive_delay_us = 0.0;
+        double max_receive_delay_us = 0.0;
+    };
+
+    // Gönderim tarafı hız kontrolü (karşı tarafın raporlarına göre)
+    struct RateControlStats {
+        streaming::EncoderSettings encoder;  // Uygulanan kodlayıcı ayarları
+        double remote_loss_percent = 0.0;    // Son rapordaki aralık kaybı
+        double remote_jitter_ms = 0.0;
+        double remote_receive_kbps = 0.0;    // Karşı tarafın aldığı payload hızı
+        uint64_t reports_sent = 0;
+        uint64_t reports_received = 0;
+        double target_rate_kbps = 0.0;       // Gecikme tabanlı hedef (başlıklar dahil, 0: kapalı)
+        double pacer_queue_delay_ms = 0.0;   // Son paketin pacer kuyruğunda beklediği süre
+        uint64_t pacer_dropped = 0;          // Pacer kuyruğu dolu olduğu için atılan paketler
+    };
+
     class Application : private core::NonCopyable {
     public:
-        Application();
+        explicit Application(const ApplicationOptions& options = ApplicationOptions());
         ~Application();
         void run(const std::string& target_ip, int send_port, int listen_port);
 
+        CapturePipelineStats capture_stats() const;
+        PlayoutStats playout_stats() const;
+        RateControlStats rate_control_stats() const;
+
+        // Herhangi bir thread'den çağrılabilir; bir sonraki paketten itibaren geçerlidir.
+        // Süre 10 ms'nin katı değilse veya aralık dışındaysa false döner.
+        bool set_packet_duration_ms(int duration_ms);
+        int packet_duration_ms() const;
+
+        // Herhangi bir thread'den çağrılabilir; bir sonraki FEC grubundan itibaren geçerlidir.
+        // Aralık dışındaysa false döner.
+        bool set_fec(int media_packets, int parity_packets);
+
     private:
-        // Ses akışını yöneten callback'ler
-        void on_audio_input(const std::vector<int16_t>& input_data);
-        void on_audio_output(std::vector<int16_t>& output_data);
+        static constexpr size_t FRAME_SAMPLES =
+            audio::AudioManager::FRAMES_PER_BUFFER * audio::AudioManager::NUM_CHANNELS;
+        // Kodlanmış bir frame'in bölündüğü en fazla paket (gönderim yolu stack'te çalışır)
+        static constexpr size_t MAX_SLICE_SIZE = 1200;
+        static constexpr size_t MAX_PACKETS_PER_FRAME =
+            (codec::OpusCodec::MAX_PACKET_BYTES + MAX_SLICE_SIZE - 1) / MAX_SLICE_SIZE;
+        // Alıcının slotları (io_uring'de çekirdeğe verilen 2 batch'lik halka), jitter
+        // buffer'ın tüm slotları ve oynatılan paket aynı anda tutulabilir
+        static constexpr size_t PACKET_POOL_BUFFERS =
+            2 * network::UdpReceiver::DEFAULT_BATCH_SIZE + streaming::Collector::DEFAULT_CAPACITY + 1;
+
+        // Bir PortAudio callback'inin mikrofon ve hoparlör verisi. Aynı kuyrukta
+        // taşındıkları için capture thread'i eko referansını doğru sırada görür.
+        struct CaptureFrame {
+            std::array<int16_t, FRAME_SAMPLES> capture;
+            std::array<int16_t, FRAME_SAMPLES> reference;
+            bool has_capture;
+        };
+
+        // Ses akışını yöneten callback'ler (PortAudio thread'inde, allocation yapmadan çalışır)
+        void on_audio_input(const int16_t* input_data, size_t frame_count);
+        void on_audio_output(int16_t* output_data, size_t frame_count);
+
+        // Mikrofon frame'ini işler (AEC, VAD, NS, encode, gönderme)
+        void process_capture_frame(int16_t* samples, size_t sample_count);
+        void send_payload(const uint8_t* payload, size_t size, uint32_t timestamp, size_t frame_count = 1);
+        // Birleştirilmeyi bekleyen frame'leri tek paket olarak gönderir
+        void flush_packet();
+
+        // Alım raporunu karşı tarafa gönderir ve gelen raporları kodlayıcıya uygular.
+        // Frame'leri işleyen (encoder'ı süren) thread'de çalışırlar.
+        void send_feedback();
+        void send_arrival_feedback();
+        void send_control(streaming::ControlType type, const uint8_t* payload, size_t size);
+        void apply_feedback();
+        void apply_encoder_settings(const streaming::EncoderSettings& settings);
+
+        // Ham mikrofon ve hoparlör frame'leriyle gecikme tahminini günceller
+        void update_echo_delay(const int16_t* capture, const int16_t* reference, size_t sample_count);
+
+        // Capture thread'i
+        void start_capture_thread();
+        void stop_capture_thread();
+        void capture_loop();  // Frame başına işleme gerçek zamanlı (allocation denetimli) bölümdedir
+
+        // Ağdan gelen paketleri jitter buffer'a ekler (network thread'i)
+        void on_packet_received(const core::PooledPacket& packet);
+        // Medya datagramını (gerekirse frame'lerine bölerek) jitter buffer'a ekler.
+        // recovered: FEC ile geri kuruldu; geliş zamanı ve kayıp istatistiklerine girmez
+        streaming::Collector::InsertResult receive_media(const core::PooledPacket& packet, bool recovered);
 
-        // Ağdan gelen veriyi işleyen callback'ler
-        void on_packet_received(core::Packet packet);
-        void on_audio_collected(const std::vector<uint8_t>& encoded_data);
+        // Playback ring'inde en az target_samples olana kadar jitter buffer'dan paket
+        // çekip çözer. Threaded modda capture thread'inde, aksi halde PortAudio
+        // callback'inde çalışır; ring'in tek üreticisidir.
+        void run_playout(size_t target_samples);
+
+        // Normal: paketi çöz, Fec: kayıp frame'i verilen (sonraki) paketin FEC verisinden
+        // çöz, Conceal: Opus PLC (paket yok)
+        enum class DecodeMode { Normal, Fec, Conceal };
+        bool decode_to_playback(const uint8_t* encoded_data, size_t size, DecodeMode mode = DecodeMode::Normal);
 
         // Ses altyapısı
         std::unique_ptr<audio::AudioManager> audio_manager_;
 
         // Ses işleme ve iletim bileşenleri
         std::unique_ptr<codec::OpusCodec>       codec_;
+        std::unique_ptr<codec::OpusPacketizer>  packetizer_;
         std::unique_ptr<streaming::Slicer>      slicer_;
         std::unique_ptr<network::UdpSender>     sender_;
+        // Alıcı ve jitter buffer'ın paylaştığı datagram havuzu; ikisinden de uzun yaşar
+        std::unique_ptr<core::BufferPool>       packet_pool_;
         std::unique_ptr<network::UdpReceiver>   receiver_;
         std::unique_ptr<streaming::Collector>   collector_;
+        std::unique_ptr<streaming::BitrateController> bitrate_controller_;
         
         // Ses işleme modülleri
         std::unique_ptr<processing::EchoCanceller> echo_canceller_;
         std::unique_ptr<processing::NoiseSuppressor> noise_suppressor_;
+        std::unique_ptr<processing::DelayEstimator> delay_estimator_; // Devre dışıysa nullptr
+        std::unique_ptr<processing::VoiceActivityDetector> voice_detector_; // Devre dışıysa nullptr
         
-        // Ağdan gelen ve çalınacak olan ses verisi için güvenli buffer
-        std::vector<int16_t> playback_buffer_;
-        std::mutex playback_mutex_;
+        const ApplicationOptions options_;
+
+        // Mikrofon verisinin işlendiği önceden ayrılmış buffer (1 frame)
+        std::vector<int16_t> capture_buffer_;
+        // Kodlanmış frame'in yazıldığı önceden ayrılmış buffer (frame'leri işleyen thread)
+        std::vector<uint8_t> encode_buffer_;
+        // Birleştirilmiş çok frame'li paket (frame'leri işleyen thread, tek dilim boyunda)
+        std::vector<uint8_t> packet_buffer_;
+        // Playback ring'i sarmalandığında decoder çıktısı için ara buffer (oynatma tarafı)
+        std::vector<int16_t> decode_buffer_;
+        bool playout_active_ = false;  // İlk paket çözüldükten sonra boşluklar PLC ile doldurulur
+        std::atomic<uint64_t> frames_recovered_{0};
+        std::atomic<uint64_t> frames_concealed_{0};
+        size_t received_packet_frames_ = 1;  // Karşı tarafın paket başına frame sayısı (ağ thread'i)
+        // Alım gecikmesi takibi (sadece ağ thread'i yazar)
+        std::atomic<uint64_t> packets_received_{0};
+        std::atomic<uint64_t> total_receive_delay_ns_{0};
+        std::atomic<uint64_t> max_receive_delay_ns_{0};
+
+        // Callback'ten capture thread'ine giden kilitsiz kuyruk
+        core::SpscRingBuffer<CaptureFrame> capture_queue_;
+        CaptureFrame pending_frame_{};  // Sadece ses thread'i tarafından doldurulur
+        CaptureFrame worker_frame_{};   // Sadece capture thread'i tarafından kullanılır
+        std::thread capture_thread_;
+        std::atomic<bool> capture_running_{false};
+
+        std::atomic<size_t> max_queue_depth_{0};
+        std::atomic<uint64_t> frames_processed_{0};
+        std::atomic<uint64_t> total_process_ns_{0};
+        std::atomic<uint64_t> max_process_ns_{0};
+
+        // Sessizlik ve comfort noise takibi (sadece frame'leri işleyen thread yazar)
+        const uint64_t comfort_noise_interval_frames_;
+        uint64_t frames_since_comfort_noise_ = 0;
+        uint32_t capture_timestamp_ = 0;  // Gönderilen paketlerin zaman damgası (sample)
+        std::atomic<uint64_t> silent_frames_{0};
+        std::atomic<uint64_t> comfort_noise_sent_{0};
+
+        // Geri bildirim: alım sayaçları ağ thread'inde güncellenir, rapor frame'leri işleyen
+        // thread'de üretilip gönderilir. Gelen raporlar ağ thread'inden kilitsiz kuyrukla
+        // encoder'ı süren thread'e geçer.
+        streaming::ReceptionMonitor reception_monitor_;
+        core::SpscRingBuffer<streaming::ReceiverReport> feedback_queue_;
+        const uint64_t feedback_interval_frames_;
+        uint64_t frames_since_feedback_ = 0;
+        uint32_t feedback_sequence_ = 0;
+        uint64_t load_frames_processed_ = 0;  // Karmaşıklık kararı için önceki yük örneği
+        uint64_t load_process_ns_ = 0;
+        std::atomic<int> encoder_bitrate_bps_{0};
+        std::atomic<int> encoder_loss_percent_{0};
+        std::atomic<bool> encoder_fec_{false};
+        std::atomic<int> encoder_complexity_{0};
+        std::atomic<uint32_t> remote_fraction_lost_{0};
+        std::atomic<uint32_t> remote_jitter_us_{0};
+        std::atomic<uint32_t> remote_receive_bps_{0};
+        std::atomic<uint64_t> reports_sent_{0};
+        std::atomic<uint64_t> reports_received_{0};
+
+        // Geliş zamanı geri bildirimi: ağ thread'i medya paketlerinin geliş zamanlarını
+        // kuyruğa atar, frame'leri işleyen thread toplayıp gönderir. Karşı tarafın geri
+        // bildirimi ağ thread'inden doğrudan sender'a verilir.
+        core::SpscRingBuffer<streaming::ArrivalFeedback::Entry> arrival_queue_;
+        const uint64_t arrival_feedback_interval_frames_;
+        uint64_t frames_since_arrival_feedback_ = 0;
+        int rate_limit_bps_ = 0;  // Kontrolcüye verilen son gecikme tabanlı sınır
+        std::atomic<int> fec_media_packets_{0};
+        std::atomic<int> fec_parity_packets_{0};
+
+        // Çözülmüş ve çalınacak olan ses verisi için kilitsiz buffer. Gecikmeyi jitter
+        // buffer belirler; bu ring sadece birkaç frame'lik aktarım tamponudur.
+        // Üretici: run_playout, tüketici: PortAudio callback'i.
+        core::SpscRingBuffer<int16_t> playback_buffer_;
     };
 }
 
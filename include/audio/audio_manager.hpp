@@ -3,16 +3,18 @@
 
 #include "core/non_copyable.hpp"
 #include <portaudio.h>
-#include <vector>
 #include <functional>
+#include <cstddef>
 #include <cstdint>
 #include <atomic>
 
 namespace audio {
     class AudioManager : private core::NonCopyable {
     public:
-        using InputCallback = std::function<void(const std::vector<int16_t>&)>;
-        using OutputCallback = std::function<void(std::vector<int16_t>&)>;
+        // Callback'ler PortAudio buffer'ları üzerinde doğrudan çalışır (kopya ve allocation yok).
+        // 'frame_count' kanal başına frame sayısıdır; buffer'lar frame_count * NUM_CHANNELS örnek içerir.
+        using InputCallback = std::function<void(const int16_t* input, size_t frame_count)>;
+        using OutputCallback = std::function<void(int16_t* output, size_t frame_count)>;
 
         static constexpr int SAMPLE_RATE = 48000;
         static constexpr int NUM_CHANNELS = 1;
@@ -2,6 +2,7 @@
 #define VOICE_ENGINE_I_AUDIO_DECODER_HPP
 
 #include <vector>
+#include <cstddef>
 #include <cstdint>
 
 namespace codec {
@@ -9,7 +10,11 @@ namespace codec {
     public:
         virtual ~IAudioDecoder() = default;
         virtual std::vector<int16_t> decode(const std::vector<uint8_t>& encoded_data) = 0;
+
+        // Çağıranın buffer'ına (en fazla max_samples, tüm kanallar) çözer, yazılan
+        // sample sayısını döndürür (hata: 0). Heap allocation yapmaz.
+        virtual size_t decode(const uint8_t* encoded_data, size_t size, int16_t* out, size_t max_samples) = 0;
     };
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -2,6 +2,7 @@
 #define VOICE_ENGINE_I_AUDIO_ENCODER_HPP
 
 #include <vector>
+#include <cstddef>
 #include <cstdint>
 
 namespace codec {
@@ -9,7 +10,11 @@ namespace codec {
     public:
         virtual ~IAudioEncoder() = default;
         virtual std::vector<uint8_t> encode(const std::vector<int16_t>& pcm_data) = 0;
+
+        // Çağıranın buffer'ına kodlar, yazılan byte sayısını döndürür (hata veya DTX: 0).
+        // Heap allocation yapmaz.
+        virtual size_t encode(const int16_t* pcm_data, size_t sample_count, uint8_t* out, size_t capacity) = 0;
     };
 }
 
-#endif
\ No newline at end of file
+#endif
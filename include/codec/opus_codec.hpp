@@ -12,14 +12,50 @@ namespace codec {
     public:
         OpusCodec(int sample_rate = 48000, int channels = 1);
         ~OpusCodec();
+        // Bir Opus paketinin alabileceği en büyük boyut (encode çıkış buffer'ı için)
+        static constexpr size_t MAX_PACKET_BYTES = 4000;
+
         std::vector<uint8_t> encode(const std::vector<int16_t>& pcm_data) override;
         std::vector<int16_t> decode(const std::vector<uint8_t>& encoded_data) override;
+
+        // Allocation'sız sürümler. Vektör sürümleri bunların üzerine kuruludur.
+        // encode: frame_samples()'dan kısa giriş sıfırla doldurulur, uzun giriş kırpılır.
+        size_t encode(const int16_t* pcm_data, size_t sample_count, uint8_t* out, size_t capacity) override;
+        size_t decode(const uint8_t* encoded_data, size_t size, int16_t* out, size_t max_samples) override;
+
+        // Kayıp frame kurtarma. sample_count, kayıp sürenin tüm kanallardaki sample
+        // sayısıdır (2.5 ms'nin katı).
+        // decode_fec: kayıp frame'i bir sonraki paketin in-band FEC (LBRR) verisinden
+        // çözer. Paket CELT-only ise FEC taşımaz ve 0 döner; çağıran conceal()'a düşmeli.
+        size_t decode_fec(const uint8_t* next_packet, size_t size, int16_t* out, size_t sample_count);
+        // conceal: Opus PLC (NULL payload). DTX sonrasında comfort noise üretir.
+        size_t conceal(int16_t* out, size_t sample_count);
+
+        // Sessizlik (DTX) frame'i: son kodlanan paketin TOC byte'ı ve boş payload.
+        // Decoder bunu kayıp/DTX olarak yorumlar ve comfort noise üretir; encoder
+        // çalıştırılmaz.
+        std::vector<uint8_t> comfort_noise_frame() const;
+        size_t comfort_noise_frame(uint8_t* out, size_t capacity) const;
+
+        // Kodlayıcı ayarları (alıcı geri bildirimine göre çalışırken değişir). Opus encoder
+        // thread-safe değildir: encode() ile aynı thread'den çağrılmalıdır; bir sonraki
+        // frame'den itibaren geçerlidir. Encoder reddederse false döner.
+        bool set_bitrate(int bits_per_second);
+        bool set_packet_loss_percent(int percent);
+        bool set_inband_fec(bool enabled);
+        bool set_complexity(int complexity);
+
+        size_t frame_samples() const { return static_cast<size_t>(frame_size_ * channels_); }
+        // Tek bir paketin çözülebileceği en fazla sample (60 ms, tüm kanallar)
+        size_t max_decoded_samples() const { return frame_samples() * 6; }
     private:
         OpusEncoder* encoder_;
         OpusDecoder* decoder_;
         const int sample_rate_;
         const int channels_;
         const int frame_size_;
+        uint8_t last_toc_;  // Son paketin TOC'u, tek frame (code 0) olarak
+        std::vector<int16_t> pad_buffer_;  // Kısa girişleri frame boyutuna tamamlamak için
     };
 }
 
@@ -0,0 +1,99 @@
+#ifndef VOICE_ENGINE_OPUS_PACKETIZER_HPP
+#define VOICE_ENGINE_OPUS_PACKETIZER_HPP
+
+#include "core/non_copyable.hpp"
+#include <opus/opus.h>
+#include <atomic>
+#include <algorithm>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace codec {
+    // Kodlanmış 10 ms Opus frame'lerini opus_repacketizer ile tek pakette (20/40/60 ms)
+    // birleştirir ve alıcıda tekrar tek frame'lik paketlere böler.
+    //
+    // Paket başına IP/UDP/uygulama başlıkları (~40 byte) 10 ms'lik düşük bitrate'li bir
+    // frame'in kendisinden büyüktür; N frame'i tek pakette göndermek başlık yükünü ve
+    // paket hızını N'e böler, karşılığında N-1 frame kadar gecikme ve kayıpta N frame'lik
+    // boşluk getirir. Encoder her zaman 10 ms çalışır: VAD/DTX kararları ve in-band FEC
+    // frame başına kalır, paket süresi encoder'ı yeniden yapılandırmadan değişebilir.
+    //
+    // add/ready/flush sadece frame'leri kodlayan thread'den çağrılır;
+    // set_frames_per_packet herhangi bir thread'den çağrılabilir ve sıradaki
+    // ready() kontrolünden itibaren geçerlidir.
+    class OpusPacketizer : private core::NonCopyable {
+    public:
+        static constexpr size_t MAX_FRAMES = 6;           // 60 ms (10 ms frame)
+        static constexpr size_t MAX_FRAME_BYTES = 1275;   // Tek bir Opus frame'inin sınırı
+
+        struct Packet {
+            size_t size = 0;        // Yazılan byte (0: bekleyen frame yok veya hata)
+            size_t frames = 0;      // Paketteki frame sayısı
+            uint32_t timestamp = 0; // İlk frame'in zaman damgası
+        };
+
+        // max_packet_bytes: birleştirilen paketin üst sınırı. Alıcıda parçalanıp
+        // birleştirilmesin diye genelde tek bir dilime (MTU) eşit tutulur; sınırı aşacak
+        // frame bir sonraki pakete kalır, tek başına aşan frame hiç eklenmez.
+        explicit OpusPacketizer(size_t max_packet_bytes, size_t frames_per_packet = 1);
+        ~OpusPacketizer();
+
+        void set_frames_per_packet(size_t frames);  // [1, MAX_FRAMES] aralığına çekilir
+        size_t frames_per_packet() const { return frames_per_packet_.load(std::memory_order_relaxed); }
+        size_t pending_frames() const { return pending_; }
+
+        // Kodlanmış tek frame'lik (code 0) paketi bekleyenlere ekler. Frame mevcut
+        // paketle birleştirilemiyorsa (farklı mod/bant genişliği, boyut sınırı) false
+        // döner ve hiçbir şey eklenmez; çağıran önce flush() etmelidir.
+        bool add(const uint8_t* frame, size_t size, uint32_t timestamp);
+        // Bekleyen frame sayısı hedefe ulaştı
+        bool ready() const { return pending_ > 0 && pending_ >= frames_per_packet(); }
+        // Bekleyen frame'leri tek paket olarak out'a yazar ve tamponu boşaltır
+        Packet flush(uint8_t* out, size_t capacity);
+
+        // Paketteki frame sayısı (geçersizse 0)
+        static size_t frame_count(const uint8_t* packet, size_t size);
+
+        // Çok frame'li paketi tek frame'lik (code 0) paketlere böler ve her biri için
+        // on_frame(index, data, size) çağırır; data sadece çağrı süresince geçerlidir.
+        // Frame sayısını, paket geçersizse 0 döndürür. Allocation yapmaz.
+        template <typename OnFrame>
+        static size_t split(const uint8_t* packet, size_t size, OnFrame&& on_frame) {
+            unsigned char toc = 0;
+            const unsigned char* frames[48];
+            opus_int16 sizes[48];
+            const int count = opus_packet_parse(packet, static_cast<opus_int32>(size), &toc, frames, sizes, nullptr);
+            if (count <= 0) {
+                return 0;
+            }
+            // Config ve stereo bitleri korunur, frame sayısı kodu 0'a çekilir
+            uint8_t single[1 + MAX_FRAME_BYTES];
+            single[0] = static_cast<uint8_t>(toc & 0xFC);
+            for (int i = 0; i < count; ++i) {
+                const size_t frame_size = static_cast<size_t>(sizes[i]);
+                std::copy(frames[i], frames[i] + frame_size, single + 1);
+                on_frame(static_cast<size_t>(i), static_cast<const uint8_t*>(single), frame_size + 1);
+            }
+            return static_cast<size_t>(count);
+        }
+
+    private:
+        static constexpr size_t SLOT_BYTES = 1 + MAX_FRAME_BYTES;  // TOC + frame
+
+        // Birleştirilen paketin başlık yükü için güvenli üst sınır (code 3 VBR: TOC,
+        // frame sayısı byte'ı ve frame başına en çok 2 byte uzunluk)
+        static size_t overhead(size_t frames) { return 2 + 2 * frames; }
+
+        OpusRepacketizer* repacketizer_;
+        const size_t max_packet_bytes_;
+        std::atomic<size_t> frames_per_packet_;
+        // Repacketizer frame'lere işaretçi tutar; frame'ler out()'a kadar burada yaşar
+        std::vector<uint8_t> storage_;
+        size_t pending_ = 0;
+        size_t pending_bytes_ = 0;
+        uint32_t timestamp_ = 0;
+    };
+}
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef VOICE_ENGINE_BUFFER_POOL_HPP
+#define VOICE_ENGINE_BUFFER_POOL_HPP
+
+#include "core/non_copyable.hpp"
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+namespace core {
+    class BufferPool;
+
+    struct BufferPoolStats {
+        size_t capacity = 0;        // Havuzdaki toplam buffer
+        size_t in_use = 0;          // Şu an bir handle tarafından tutulan buffer
+        size_t peak_in_use = 0;
+        uint64_t acquired = 0;      // Başarılı acquire() çağrıları
+        uint64_t exhausted = 0;     // Havuz boşken yapılan acquire() çağrıları
+    };
+
+    // Havuzdan alınmış bir buffer'ın referans sayımlı handle'ı. Kopyalama sadece sayacı
+    // artırır; son handle bırakıldığında buffer havuza geri döner. Handle'lar farklı
+    // thread'lerde tutulabilir, ancak buffer içeriği yayınlandıktan sonra (ör. alıcı
+    // callback'inden sonra) sadece okunmalıdır. Havuz, tüm handle'larından uzun yaşamalıdır.
+    class PooledBuffer {
+    public:
+        PooledBuffer() = default;
+        PooledBuffer(const PooledBuffer& other);
+        PooledBuffer(PooledBuffer&& other) noexcept;
+        PooledBuffer& operator=(const PooledBuffer& other);
+        PooledBuffer& operator=(PooledBuffer&& other) noexcept;
+        ~PooledBuffer() { reset(); }
+
+        explicit operator bool() const { return pool_ != nullptr; }
+
+        uint8_t* data();
+        const uint8_t* data() const;
+        size_t capacity() const;
+
+        // Buffer'daki geçerli byte sayısı (ör. alınan datagram uzunluğu)
+        size_t size() const { return size_; }
+        void set_size(size_t size) { size_ = size; }
+
+        // Bu buffer'ı paylaşan handle sayısı (anlık değer)
+        uint32_t use_count() const;
+
+        void reset();
+
+    private:
+        friend class BufferPool;
+        PooledBuffer(BufferPool* pool, uint32_t index) : pool_(pool), index_(index) {}
+
+        BufferPool* pool_ = nullptr;
+        uint32_t index_ = 0;
+        size_t size_ = 0;
+    };
+
+    // Sabit sayıda, sabit boyutlu buffer'dan oluşan havuz. Tüm buffer'lar kurulumda tek
+    // blok olarak ayrılır; acquire() ve buffer'ın geri dönüşü kilitsizdir (Treiber yığını,
+    // ABA'ya karşı sürüm etiketli başlık) ve allocation yapmaz. Havuz boşsa acquire()
+    // boş bir handle döndürür; çağıran tarafın paketi atması beklenir.
+    class BufferPool : private NonCopyable {
+    public:
+        explicit BufferPool(size_t buffer_count, size_t buffer_size);
+
+        PooledBuffer acquire();
+
+        size_t buffer_size() const { return buffer_size_; }
+        size_t capacity() const { return buffer_count_; }
+        BufferPoolStats stats() const;
+
+    private:
+        friend class PooledBuffer;
+
+        struct Node {
+            std::atomic<uint32_t> references{0};
+            std::atomic<uint32_t> next{0};
+        };
+
+        static constexpr uint32_t EMPTY = 0xFFFFFFFFu;
+
+        uint8_t* buffer(uint32_t index) const { return storage_.get() + static_cast<size_t>(index) * buffer_size_; }
+        void add_reference(uint32_t index);
+        void release(uint32_t index);
+        void push_free(uint32_t index);
+
+        const size_t buffer_count_;
+        const size_t buffer_size_;
+        std::unique_ptr<uint8_t[]> storage_;
+        std::unique_ptr<Node[]> nodes_;
+
+        // Üst 32 bit sürüm etiketi, alt 32 bit yığının tepesindeki buffer
+        alignas(64) std::atomic<uint64_t> free_head_;
+
+        alignas(64) std::atomic<size_t> in_use_{0};
+        std::atomic<size_t> peak_in_use_{0};
+        std::atomic<uint64_t> acquired_{0};
+        std::atomic<uint64_t> exhausted_{0};
+    };
+}
+
+#endif
@@ -1,39 +1,162 @@
 #ifndef VOICE_ENGINE_PACKET_HPP
 #define VOICE_ENGINE_PACKET_HPP
 
+#include "core/buffer_pool.hpp"
 #include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 
 namespace core {
+    // Kablo formatı: [sequence_number (4)][timestamp (4)][fragment_index (1)]
+    // [fragment_count (1)][frame_size (2)][data], big-endian.
+    // timestamp, paketteki ilk sample'ın örnekleme hızındaki zamanıdır (RTP gibi);
+    // DTX boşluklarında da ilerlediği için jitter hesabı sıra numarasından bağımsızdır.
+    // sequence_number frame başına artar: bir frame'in parçaları aynı numarayı taşır ve
+    // fragment_index / fragment_count ile ayrılır. Parçalar eşit boyludur (son parça daha
+    // kısa olabilir), bu yüzden her parçanın frame içindeki yeri frame_size'dan hesaplanır.
+    // fragment_count == 0 medya taşımayan kontrol paketlerini (ör. alıcı raporu) işaretler;
+    // bunlarda fragment_index mesaj türüdür ve sıra numarası kendi sayacından gelir.
+    constexpr size_t PACKET_HEADER_SIZE = 12;
+    constexpr size_t MAX_FRAGMENTS = 255;
+
+    // Parçalı frame'de, son parça dışındaki parçaların boyu (ve parça i'nin offset'i i * stride)
+    constexpr size_t fragment_stride(size_t frame_size, size_t fragment_count) {
+        return (frame_size + fragment_count - 1) / fragment_count;
+    }
+    // Gönderim slotları ve alıcı buffer'ları için bir datagramın üst sınırı
+    constexpr size_t MAX_DATAGRAM_SIZE = 2048;
+
+    // Bir paketin sahiplik almayan görünümü. Alıcıda data alım buffer'ını, göndericide
+    // kodlanmış frame'i gösterir; sadece o buffer yaşadığı sürece geçerlidir. Başlık
+    // ayrı yazıldığı için payload kopyalanmadan scatter-gather (iovec) ile gönderilebilir.
+    struct PacketView {
+        uint32_t sequence_number = 0;
+        uint32_t timestamp = 0;
+        uint8_t fragment_index = 0;
+        uint8_t fragment_count = 1;
+        uint16_t frame_size = 0;  // Parçalı frame'in toplam boyu (tek parçada kullanılmaz)
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+
+        size_t wire_size() const { return PACKET_HEADER_SIZE + size; }
+        bool fragmented() const { return fragment_count > 1; }
+        bool control() const { return fragment_count == 0; }
+
+        // PACKET_HEADER_SIZE byte yazar
+        void write_header(uint8_t* out) const {
+            write_u32(out, sequence_number);
+            write_u32(out + 4, timestamp);
+            out[8] = fragment_index;
+            out[9] = fragment_count;
+            out[10] = static_cast<uint8_t>(frame_size >> 8);
+            out[11] = static_cast<uint8_t>(frame_size);
+        }
+
+        // Datagramı ayrıştırır; data, 'bytes' içini gösterir. Başlıktan kısa ise veya
+        // parça alanları tutarsızsa false. Kontrol paketleri geçerlidir (control()).
+        static bool parse(const uint8_t* bytes, size_t length, PacketView& view) {
+            if (length < PACKET_HEADER_SIZE) {
+                return false;
+            }
+            view.sequence_number = read_u32(bytes);
+            view.timestamp = read_u32(bytes + 4);
+            view.fragment_index = bytes[8];
+            view.fragment_count = bytes[9];
+            view.frame_size = static_cast<uint16_t>((bytes[10] << 8) | bytes[11]);
+            view.data = bytes + PACKET_HEADER_SIZE;
+            view.size = length - PACKET_HEADER_SIZE;
+            return view.control() || view.fragment_index < view.fragment_count;
+        }
+
+    private:
+        static void write_u32(uint8_t* bytes, uint32_t value) {
+            bytes[0] = static_cast<uint8_t>(value >> 24);
+            bytes[1] = static_cast<uint8_t>(value >> 16);
+            bytes[2] = static_cast<uint8_t>(value >> 8);
+            bytes[3] = static_cast<uint8_t>(value);
+        }
+
+        static uint32_t read_u32(const uint8_t* bytes) {
+            return (static_cast<uint32_t>(bytes[0]) << 24) |
+                   (static_cast<uint32_t>(bytes[1]) << 16) |
+                   (static_cast<uint32_t>(bytes[2]) << 8)  |
+                   (static_cast<uint32_t>(bytes[3]));
+        }
+    };
+
+    // Havuz buffer'ında duran bir paket: view, buffer'ın içini gösterir ve handle
+    // tutulduğu sürece geçerlidir. Alıcıdan jitter buffer'a kopyalanmadan taşınır.
+    // arrival, datagramın çekirdeğe ulaştığı an (SO_TIMESTAMPNS) ya da bu yoksa alıcının
+    // okuduğu andır; callback'e kadar geçen zamanlama gecikmesini içermez.
+    struct PooledPacket {
+        PacketView view;
+        PooledBuffer buffer;
+        std::chrono::steady_clock::time_point arrival{};
+    };
+
+    // Sahiplik alan paket (testler, araçlar ve vektör tabanlı API'ler için)
     struct Packet {
-        uint32_t sequence_number;
+        static constexpr size_t HEADER_SIZE = PACKET_HEADER_SIZE;
+        static constexpr size_t MAX_DATAGRAM_SIZE = core::MAX_DATAGRAM_SIZE;
+
+        uint32_t sequence_number = 0;
+        uint32_t timestamp = 0;
+        uint8_t fragment_index = 0;
+        uint8_t fragment_count = 1;
+        uint16_t frame_size = 0;
         std::vector<uint8_t> data;
 
+        PacketView view() const {
+            PacketView view;
+            view.sequence_number = sequence_number;
+            view.timestamp = timestamp;
+            view.fragment_index = fragment_index;
+            view.fragment_count = fragment_count;
+            view.frame_size = frame_size;
+            view.data = data.data();
+            view.size = data.size();
+            return view;
+        }
+
+        size_t wire_size() const { return HEADER_SIZE + data.size(); }
+
         std::vector<uint8_t> to_bytes() const {
-            std::vector<uint8_t> bytes;
-            bytes.reserve(4 + data.size());
-            bytes.push_back(sequence_number >> 24);
-            bytes.push_back(sequence_number >> 16);
-            bytes.push_back(sequence_number >> 8);
-            bytes.push_back(sequence_number);
-            bytes.insert(bytes.end(), data.begin(), data.end());
+            std::vector<uint8_t> bytes(wire_size());
+            write_to(bytes.data(), bytes.size());
             return bytes;
         }
 
+        // Önceden ayrılmış bir buffer'a yazar; yazılan byte sayısını, sığmazsa 0 döndürür
+        size_t write_to(uint8_t* out, size_t capacity) const {
+            if (capacity < wire_size()) {
+                return 0;
+            }
+            view().write_header(out);
+            std::copy(data.begin(), data.end(), out + HEADER_SIZE);
+            return wire_size();
+        }
+
         static Packet from_bytes(const std::vector<uint8_t>& bytes) {
+            return from_bytes(bytes.data(), bytes.size());
+        }
+
+        static Packet from_bytes(const uint8_t* bytes, size_t size) {
             Packet packet;
-            if (bytes.size() < 4) {
-                packet.sequence_number = 0;
+            PacketView view;
+            if (!PacketView::parse(bytes, size, view)) {
                 return packet;
             }
-            packet.sequence_number = (static_cast<uint32_t>(bytes[0]) << 24) |
-                                     (static_cast<uint32_t>(bytes[1]) << 16) |
-                                     (static_cast<uint32_t>(bytes[2]) << 8)  |
-                                     (static_cast<uint32_t>(bytes[3]));
-            packet.data.assign(bytes.begin() + 4, bytes.end());
+            packet.sequence_number = view.sequence_number;
+            packet.timestamp = view.timestamp;
+            packet.fragment_index = view.fragment_index;
+            packet.fragment_count = view.fragment_count;
+            packet.frame_size = view.frame_size;
+            packet.data.assign(view.data, view.data + view.size);
             return packet;
         }
     };
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,43 @@
+#ifndef VOICE_ENGINE_RT_ALLOC_GUARD_HPP
+#define VOICE_ENGINE_RT_ALLOC_GUARD_HPP
+
+// Gerçek zamanlı ses thread'inde heap allocation denetimi.
+//
+// VOICE_ENGINE_RT_ALLOC_CHECK tanımlıysa (Debug build'lerde varsayılan), global
+// operator new/delete değiştirilir ve ScopedRealtimeSection aktifken yapılan her
+// allocation programı mesajla birlikte abort eder. Tanımlı değilse sınıflar boştur
+// ve hiçbir maliyeti yoktur.
+
+namespace core {
+#ifdef VOICE_ENGINE_RT_ALLOC_CHECK
+    // Bu nesne yaşadığı sürece mevcut thread'de allocation yasaktır
+    class ScopedRealtimeSection {
+    public:
+        ScopedRealtimeSection();
+        ~ScopedRealtimeSection();
+        ScopedRealtimeSection(const ScopedRealtimeSection&) = delete;
+        ScopedRealtimeSection& operator=(const ScopedRealtimeSection&) = delete;
+    };
+
+    // Gerçek zamanlı bölüm içinde bilinçli olarak allocation'a izin verir
+    class ScopedAllocationAllowed {
+    public:
+        ScopedAllocationAllowed();
+        ~ScopedAllocationAllowed();
+        ScopedAllocationAllowed(const ScopedAllocationAllowed&) = delete;
+        ScopedAllocationAllowed& operator=(const ScopedAllocationAllowed&) = delete;
+    };
+#else
+    class ScopedRealtimeSection {
+    public:
+        ScopedRealtimeSection() {}
+    };
+
+    class ScopedAllocationAllowed {
+    public:
+        ScopedAllocationAllowed() {}
+    };
+#endif
+}
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef VOICE_ENGINE_SPSC_RING_BUFFER_HPP
+#define VOICE_ENGINE_SPSC_RING_BUFFER_HPP
+
+#include "core/non_copyable.hpp"
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+
+namespace core {
+    // False sharing'i önlemek için kullanılan cache line boyutu
+    constexpr size_t CACHE_LINE_SIZE = 64;
+
+    // Tek üretici / tek tüketici (SPSC) için sabit kapasiteli, kilitsiz ring buffer.
+    // push() yalnızca üretici thread'den, pop()/discard() yalnızca tüketici thread'den
+    // çağrılmalıdır. Her iki taraf da wait-free'dir: döngü, kilit veya allocation yoktur.
+    //
+    // Taşma politikası:
+    //  - DropNewest: sığmayan yeni örnekler atılır (kısmi yazma), overflow sayacı artar.
+    //  - RejectBlock: blok tamamen sığmıyorsa hiç yazılmaz.
+    // Eski örneklerin atılması (gecikme sınırı) tüketici tarafında discard() ile yapılır.
+    template <typename T>
+    class SpscRingBuffer : private NonCopyable {
+        static_assert(std::is_trivially_copyable<T>::value, "SpscRingBuffer trivially copyable tip gerektirir");
+
+    public:
+        enum class OverflowPolicy {
+            DropNewest,
+            RejectBlock
+        };
+
+        explicit SpscRingBuffer(size_t min_capacity, OverflowPolicy policy = OverflowPolicy::DropNewest)
+            : capacity_(round_up_pow2(min_capacity)),
+              mask_(capacity_ - 1),
+              policy_(policy),
+              storage_(capacity_) {}
+
+        // Üretici: en fazla 'count' örnek yazar, yazılan örnek sayısını döndürür.
+        size_t push(const T* data, size_t count) {
+            const size_t write = write_index_.load(std::memory_order_relaxed);
+            size_t free_space = capacity_ - (write - cached_read_index_);
+            if (free_space < count) {
+                cached_read_index_ = read_index_.load(std::memory_order_acquire);
+                free_space = capacity_ - (write - cached_read_index_);
+            }
+
+            size_t to_write = std::min(count, free_space);
+            if (to_write < count && policy_ == OverflowPolicy::RejectBlock) {
+                to_write = 0;
+            }
+            if (to_write < count) {
+                overflow_count_.fetch_add(count - to_write, std::memory_order_relaxed);
+            }
+            if (to_write == 0) {
+                return 0;
+            }
+
+            const size_t offset = write & mask_;
+            const size_t first = std::min(to_write, capacity_ - offset);
+            std::copy(data, data + first, storage_.data() + offset);
+            std::copy(data + first, data + to_write, storage_.data());
+
+            write_index_.store(write + to_write, std::memory_order_release);
+            return to_write;
+        }
+
+        // Üretici: doğrudan yazılabilecek, sarmalanmayan boş bölgenin başını döndürür ve
+        // uzunluğunu 'contiguous'a yazar. Yazılan örnekler commit_write() ile yayınlanır;
+        // böylece örn. decoder çıktısı ara buffer olmadan ring'e yazılabilir.
+        T* write_region(size_t& contiguous) {
+            const size_t write = write_index_.load(std::memory_order_relaxed);
+            cached_read_index_ = read_index_.load(std::memory_order_acquire);
+            const size_t free_space = capacity_ - (write - cached_read_index_);
+            const size_t offset = write & mask_;
+            contiguous = std::min(free_space, capacity_ - offset);
+            return storage_.data() + offset;
+        }
+
+        // Üretici: write_region()'dan alınan bölgenin ilk 'count' örneğini yayınlar.
+        void commit_write(size_t count) {
+            const size_t write = write_index_.load(std::memory_order_relaxed);
+            write_index_.store(write + count, std::memory_order_release);
+        }
+
+        // Tüketici: en fazla 'count' örnek okur, okunan örnek sayısını döndürür.
+        size_t pop(T* data, size_t count) {
+            const size_t read = read_index_.load(std::memory_order_relaxed);
+            size_t available = cached_write_index_ - read;
+            if (available < count) {
+                cached_write_index_ = write_index_.load(std::memory_order_acquire);
+                available = cached_write_index_ - read;
+            }
+
+            const size_t to_read = std::min(count, available);
+            if (to_read == 0) {
+                return 0;
+            }
+
+            const size_t offset = read & mask_;
+            const size_t first = std::min(to_read, capacity_ - offset);
+            std::copy(storage_.data() + offset, storage_.data() + offset + first, data);
+            std::copy(storage_.data(), storage_.data() + (to_read - first), data + first);
+
+            read_index_.store(read + to_read, std::memory_order_release);
+            return to_read;
+        }
+
+        // Tüketici: en eski 'count' örneği okumadan atar, atılan örnek sayısını döndürür.
+        size_t discard(size_t count) {
+            const size_t read = read_index_.load(std::memory_order_relaxed);
+            cached_write_index_ = write_index_.load(std::memory_order_acquire);
+            const size_t to_drop = std::min(count, cached_write_index_ - read);
+            read_index_.store(read + to_drop, std::memory_order_release);
+            return to_drop;
+        }
+
+        // Her iki thread'den de çağrılabilir; değer anlık bir tahmindir.
+        size_t size() const {
+            const size_t read = read_index_.load(std::memory_order_acquire);
+            const size_t write = write_index_.load(std::memory_order_acquire);
+            return write - read;
+        }
+
+        size_t capacity() const { return capacity_; }
+        uint64_t overflow_count() const { return overflow_count_.load(std::memory_order_relaxed); }
+
+    private:
+        static size_t round_up_pow2(size_t value) {
+            size_t result = 1;
+            while (result < value) {
+                result <<= 1;
+            }
+            return result;
+        }
+
+        const size_t capacity_;
+        const size_t mask_;
+        const OverflowPolicy policy_;
+        std::vector<T> storage_;
+
+        // Üretici tarafı (kendi cache line'ında)
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> write_index_{0};
+        size_t cached_read_index_ = 0;
+
+        // Tüketici tarafı (kendi cache line'ında)
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> read_index_{0};
+        size_t cached_write_index_ = 0;
+
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> overflow_count_{0};
+    };
+}
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef VOICE_ENGINE_FFT_HPP
+#define VOICE_ENGINE_FFT_HPP
+
+#include "core/non_copyable.hpp"
+#include <vector>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+
+namespace dsp {
+    // Gerçel girişli FFT (N = 2'nin kuvveti, N >= 4).
+    // N/2 noktalı kompleks radix-2 FFT + split adımı ile hesaplanır. Twiddle ve
+    // bit-reverse tabloları kurulumda bir kez hesaplanır; forward/inverse
+    // çağrıları trigonometrik fonksiyon çağırmaz ve allocation yapmaz.
+    //
+    // Spektrum formatı: eşlenik simetrik spektrumun sadece ilk N/2 + 1 bin'i
+    // (DC ... Nyquist) saklanır; diğer yarısı X[N-k] = conj(X[k]) ile tanımlıdır.
+    class RealFft : private core::NonCopyable {
+    public:
+        explicit RealFft(size_t size);
+
+        size_t size() const { return size_; }
+        size_t bins() const { return half_ + 1; }
+
+        // input: size() gerçel örnek, output: bins() kompleks bin (ölçeklenmemiş)
+        void forward(const float* input, std::complex<float>* output);
+
+        // input: bins() kompleks bin, output: size() gerçel örnek (1/N ile ölçeklenmiş)
+        void inverse(const std::complex<float>* input, float* output);
+
+    private:
+        void complex_fft(std::complex<float>* data, bool inverse);
+
+        const size_t size_;  // N
+        const size_t half_;  // M = N/2 (kompleks FFT boyutu)
+
+        std::vector<uint32_t> bit_reverse_;                // M noktalı bit-reverse permütasyonu
+        std::vector<std::complex<float>> stage_twiddles_;  // Her aşama için ardışık twiddle'lar (ileri)
+        std::vector<std::complex<float>> inverse_twiddles_; // Aynı tablo, eşlenik (ters)
+        std::vector<std::complex<float>> split_twiddles_;  // e^{-2πik/N}, k = 0..M
+        std::vector<std::complex<float>> work_;            // M kompleks çalışma alanı
+    };
+}
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef VOICE_ENGINE_KERNELS_HPP
+#define VOICE_ENGINE_KERNELS_HPP
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+
+namespace dsp {
+    // Çalışma zamanında seçilen SIMD seviyesi
+    enum class SimdLevel {
+        Scalar,
+        Sse41,
+        Avx2,
+        Avx512,
+        Neon
+    };
+
+    // Ses işleme aşamalarının ve paket FEC'inin ortak iç döngüleri. Her SIMD seviyesi bu
+    // tabloyu kendi fonksiyonlarıyla doldurur; seçim program başında CPUID ile bir kez yapılır.
+    //
+    // Eleman bazlı kerneller skaler referansla bit-bit aynı sonucu verir; toplama
+    // yapan kernellerde (dot, sum_squares) toplama sırası farklı olduğundan küçük
+    // yuvarlama farkları olabilir.
+    struct KernelTable {
+        // out[i] = in[i] / 32768
+        void (*int16_to_float)(const int16_t* in, float* out, size_t count);
+        // out[i] = int16(clamp(in[i] * 32768, -32768, 32767)), sıfıra doğru yuvarlama
+        void (*float_to_int16)(const float* in, int16_t* out, size_t count);
+        // Σ a[i] * b[i]
+        float (*dot)(const float* a, const float* b, size_t count);
+        // y[i] += alpha * x[i]
+        void (*axpy)(float alpha, const float* x, float* y, size_t count);
+        // out[i] = a[i] * b[i]
+        void (*multiply)(const float* a, const float* b, float* out, size_t count);
+        // y[i] += a[i] * b[i]
+        void (*multiply_accumulate)(const float* a, const float* b, float* y, size_t count);
+        // Σ in[i]², RMS hesabı için
+        float (*sum_squares_int16)(const int16_t* in, size_t count);
+        // bins[i] *= gains[i] (spektral kazanç)
+        void (*apply_gain)(std::complex<float>* bins, const float* gains, size_t count);
+        // y[i] += a[i] · b[i] (karmaşık; gerçek kısım ar·br − ai·bi, sanal ar·bi + ai·br)
+        void (*complex_multiply_accumulate)(const std::complex<float>* a, const std::complex<float>* b,
+                                            std::complex<float>* y, size_t count);
+        // y[i] += conj(a[i]) · b[i] (gerçek kısım ar·br + ai·bi, sanal ar·bi − ai·br)
+        void (*complex_conj_multiply_accumulate)(const std::complex<float>* a, const std::complex<float>* b,
+                                                 std::complex<float>* y, size_t count);
+        // out[i] += |in[i]|² (re·re + im·im)
+        void (*norm_accumulate)(const std::complex<float>* in, float* out, size_t count);
+        // out[i] ^= in[i] (XOR paritesi)
+        void (*xor_bytes)(const uint8_t* in, uint8_t* out, size_t count);
+        // out[i] ^= c · in[i], GF(2^8) çarpımı. tables: c'nin 0x0..0xF ile (ilk 16 byte) ve
+        // 0x00..0xF0 ile (son 16 byte) çarpımları; çarpım iki yarım byte aramasının XOR'udur
+        void (*gf256_multiply_add)(const uint8_t* tables, const uint8_t* in, uint8_t* out, size_t count);
+    };
+
+    // Bu makinede desteklenen en iyi seviyenin tablosu (ilk çağrıda seçilir)
+    const KernelTable& kernels();
+    SimdLevel simd_level();
+    const char* simd_level_name(SimdLevel level);
+
+    // Belirli bir seviyenin tablosu; derlenmemişse veya CPU desteklemiyorsa nullptr.
+    // Benchmark ve doğrulama araçları için.
+    const KernelTable* kernels_for(SimdLevel level);
+
+    namespace detail {
+        const KernelTable& scalar_kernels();
+#ifdef VOICE_ENGINE_HAVE_SSE41
+        const KernelTable& sse41_kernels();
+#endif
+#ifdef VOICE_ENGINE_HAVE_AVX2
+        const KernelTable& avx2_kernels();
+#endif
+#ifdef VOICE_ENGINE_HAVE_AVX512
+        const KernelTable& avx512_kernels();
+#endif
+#ifdef VOICE_ENGINE_HAVE_NEON
+        const KernelTable& neon_kernels();
+#endif
+    }
+}
+
+#endif
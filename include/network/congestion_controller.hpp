@@ -0,0 +1,146 @@
+#ifndef VOICE_ENGINE_CONGESTION_CONTROLLER_HPP
+#define VOICE_ENGINE_CONGESTION_CONTROLLER_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace network {
+    // Alıcının bildirdiği bir paketin geliş zamanı (alıcının saatinde, µs)
+    struct PacketArrival {
+        uint32_t sequence_number;
+        int64_t arrival_us;
+    };
+
+    enum class BandwidthUsage { Normal, Underusing, Overusing };
+
+    // Gönderici tarafı gecikme tabanlı tıkanıklık kontrolü (Google Congestion Control'ün
+    // gecikme tabanlı kısmı). Aynı BURST_US içinde gönderilen paketler bir grup sayılır;
+    // ardışık grupların geliş aralığı ile gönderim aralığının farkı darboğaz kuyruğundaki
+    // değişimdir. Bu farkların birikimi yumuşatılıp son TRENDLINE_WINDOW grupta doğrusal
+    // regresyonla eğimi bulunur (trendline). Ölçeklenmiş eğim uyarlanır eşiği en az
+    // OVERUSE_TIME_MS aşıp artmaya devam ederse aşırı kullanım, -eşiğin altındaysa eksik
+    // kullanım işaretlenir.
+    //
+    // Hedef hız AIMD ile ayarlanır: aşırı kullanımda alıcıya ulaşan hızın DECREASE_FACTOR
+    // katına iner, normalde artar (bağlantı kapasitesi tahmininden uzaksa saniyede
+    // %8 çarpımsal, yakınsa yanıt süresi başına bir paket toplamsal), eksik kullanımda
+    // kuyruk boşalırken beklenir. Hedef, alıcıya ulaşan hızın 1.5 katını geçmez.
+    // Hızlar IP/UDP başlıkları dahil kablodaki hızdır.
+    //
+    // Tek thread'den kullanılır.
+    class DelayBasedController {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        struct Options {
+            int min_bitrate_bps = 16000;
+            int start_bitrate_bps = 96000;   // 10 ms'lik 64 kbps Opus + başlıklar
+            int max_bitrate_bps = 256000;
+        };
+
+        static constexpr size_t IP_UDP_HEADER_BYTES = 28;
+        static constexpr int64_t BURST_US = 5000;
+        static constexpr size_t TRENDLINE_WINDOW = 20;
+        static constexpr double TRENDLINE_SMOOTHING = 0.9;
+        static constexpr double TRENDLINE_GAIN = 4.0;
+        static constexpr double OVERUSE_TIME_MS = 10.0;
+        static constexpr double INITIAL_THRESHOLD = 12.5;
+        static constexpr double THRESHOLD_UP = 0.0087;     // Eşiğin eğime yaklaşma hızları
+        static constexpr double THRESHOLD_DOWN = 0.039;
+        static constexpr double DECREASE_FACTOR = 0.85;
+        static constexpr double INCREASE_PER_SECOND = 0.08;
+        static constexpr double ACKED_RATE_HEADROOM = 1.5;
+        static constexpr int64_t ACKED_RATE_WINDOW_US = 500000;
+        static constexpr size_t HISTORY_SIZE = 1024;       // Gönderilmiş paket kaydı (sıra numarasına göre)
+
+        explicit DelayBasedController(const Options& options);
+
+        // Gönderilen medya paketi (parçalı frame'in parçaları aynı sıra numarasıyla
+        // ayrı ayrı bildirilebilir; boyları toplanır)
+        void on_packet_sent(uint32_t sequence_number, size_t wire_bytes, Clock::time_point now);
+        // Alıcının geri bildirimi (geliş sırasıyla). Hedef değiştiyse true.
+        bool on_feedback(const PacketArrival* arrivals, size_t count, Clock::time_point now);
+
+        int target_bitrate_bps() const { return static_cast<int>(target_bps_); }
+        int acked_bitrate_bps() const { return static_cast<int>(acked_bps_); }
+        BandwidthUsage usage() const { return usage_; }
+        double trend() const { return modified_trend_; }
+        double threshold() const { return threshold_; }
+
+    private:
+        struct SentPacket {
+            uint32_t sequence_number = 0;
+            bool valid = false;
+            int64_t send_us = 0;
+            size_t wire_bytes = 0;
+        };
+
+        struct PacketGroup {
+            bool valid = false;
+            int64_t first_send_us = 0;
+            int64_t last_send_us = 0;
+            int64_t last_arrival_us = 0;
+        };
+
+        struct AckedPacket {
+            int64_t arrival_us = 0;
+            size_t wire_bytes = 0;
+        };
+
+        void on_group_delta(double delay_delta_ms, double send_delta_ms, int64_t arrival_us);
+        void detect(double send_delta_ms, int64_t arrival_us);
+        void update_threshold(double modified_trend, int64_t arrival_us);
+        void update_acked_rate(int64_t arrival_us, size_t wire_bytes);
+        void update_target(int64_t now_us, double response_time_ms);
+
+        const Options options_;
+        double target_bps_;
+
+        std::array<SentPacket, HISTORY_SIZE> history_{};
+        PacketGroup current_group_;
+        PacketGroup previous_group_;
+
+        // Trendline
+        std::array<std::pair<double, double>, TRENDLINE_WINDOW> window_{};  // (geliş ms, yumuşatılmış gecikme)
+        size_t window_start_ = 0;
+        size_t window_size_ = 0;
+        size_t delta_count_ = 0;
+        bool has_first_arrival_ = false;
+        int64_t first_arrival_us_ = 0;
+        double accumulated_delay_ms_ = 0.0;
+        double smoothed_delay_ms_ = 0.0;
+        double modified_trend_ = 0.0;
+        double previous_trend_ = 0.0;
+
+        // Aşırı kullanım dedektörü
+        double threshold_ = INITIAL_THRESHOLD;
+        int64_t last_threshold_update_us_ = -1;
+        double time_over_using_ms_ = -1.0;
+        int overuse_count_ = 0;
+        BandwidthUsage usage_ = BandwidthUsage::Normal;
+
+        // Alıcıya ulaşan hız (son ACKED_RATE_WINDOW_US)
+        std::array<AckedPacket, 256> acked_{};
+        size_t acked_start_ = 0;
+        size_t acked_size_ = 0;
+        size_t acked_bytes_ = 0;
+        bool has_acked_start_ = false;
+        int64_t acked_start_us_ = 0;
+        double acked_bps_ = 0.0;             // 0: pencere henüz dolmadı
+
+        // AIMD
+        enum class RateState { Hold, Increase, Decrease };
+        RateState rate_state_ = RateState::Increase;
+        bool has_rate_update_ = false;
+        int64_t last_rate_update_us_ = 0;
+        bool has_decrease_ = false;
+        int64_t last_decrease_us_ = 0;
+        double link_capacity_bps_ = 0.0;      // Son düşüşlerde alınan hızın ortalaması (0: bilinmiyor)
+        double link_capacity_variance_ = 0.4; // Normalize varyans
+    };
+}
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef VOICE_ENGINE_EVENT_LOOP_HPP
+#define VOICE_ENGINE_EVENT_LOOP_HPP
+
+#ifdef VOICE_ENGINE_HAVE_EPOLL
+
+#include "core/non_copyable.hpp"
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace network {
+    // Tek thread'de çok sayıda soketi dinleyen edge-triggered epoll döngüsü.
+    //
+    // Soketler non-blocking olmalıdır. Edge-triggered modda handler, soket okunabilir
+    // hale geldiğinde bir kez çağrılır ve EAGAIN alana kadar okumaya devam etmelidir;
+    // aksi halde kuyrukta kalan datagramlar için yeni bildirim gelmez. Handler'lar
+    // döngü thread'inde çalışır ve kısa tutulmalıdır.
+    //
+    // stop() ve remove() her thread'den çağrılabilir; döngü bir eventfd ile hemen
+    // uyandırılır. remove() başka bir thread'den çağrılırsa, çalışmakta olan handler
+    // bitene kadar bekler; döndükten sonra handler'ın bir daha çağrılmayacağı garantidir.
+    class EventLoop : private core::NonCopyable {
+    public:
+        using Handler = std::function<void()>;
+        static constexpr int MAX_EVENTS = 64;
+
+        EventLoop();
+        ~EventLoop();
+
+        bool add(int fd, Handler on_readable);
+        void remove(int fd);
+
+        // stop() çağrılana kadar çağıran thread'de çalışır
+        void run();
+        // Döngüyü kendi thread'inde başlatır; cpu >= 0 ise thread o CPU'ya sabitlenir
+        bool start(int cpu = -1);
+        void stop();
+
+        bool running() const { return running_; }
+        size_t size() const;
+
+    private:
+        struct Registration {
+            int fd;
+            Handler handler;
+        };
+
+        void loop();
+        void wake();
+        void dispatch(int fd);
+
+        int epoll_fd_ = -1;
+        int wake_fd_ = -1;
+
+        mutable std::mutex mutex_;
+        std::condition_variable iteration_done_;
+        std::unordered_map<int, std::shared_ptr<Registration>> registrations_;
+        uint64_t iteration_ = 0;  // Tamamlanan epoll_wait + dağıtım turu
+
+        std::atomic<bool> running_{false};
+        std::atomic<std::thread::id> loop_thread_id_{};
+        std::thread thread_;
+    };
+}
+
+#endif
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef VOICE_ENGINE_IO_BACKEND_HPP
+#define VOICE_ENGINE_IO_BACKEND_HPP
+
+namespace network {
+    // UdpSender / UdpReceiver'ın kullandığı G/Ç yolu
+    enum class IoBackend {
+        Socket,   // Klasik soket çağrıları (sendmmsg/recvmmsg, epoll)
+        IoUring   // io_uring (VOICE_ENGINE_HAVE_IO_URING); yoksa Socket'e dönülür
+    };
+
+    // io_uring ile derlendiyse ve çekirdek bir ring kurulmasına izin veriyorsa true
+    // (seccomp veya kernel.io_uring_disabled ile kapatılmış olabilir). Sonuç önbelleğe alınır.
+    bool io_uring_available();
+
+    inline const char* to_string(IoBackend backend) {
+        return backend == IoBackend::IoUring ? "io_uring" : "socket";
+    }
+}
+
+#endif
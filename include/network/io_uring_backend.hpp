@@ -0,0 +1,95 @@
+#ifndef VOICE_ENGINE_IO_URING_BACKEND_HPP
+#define VOICE_ENGINE_IO_URING_BACKEND_HPP
+
+#include "network/io_backend.hpp"
+
+#ifdef VOICE_ENGINE_HAVE_IO_URING
+
+#include "core/non_copyable.hpp"
+#include "core/packet.hpp"
+#include <liburing.h>
+#include <netinet/in.h>
+#include <functional>
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace network {
+    // UdpSender'ın io_uring yolu. Bir send() çağrısındaki paketler SENDMSG SQE'leri olarak
+    // hazırlanır (başlık + payload iovec'i, sendmmsg yolu ile aynı düzen) ve tek bir
+    // io_uring_enter ile gönderilip tamamlanmaları beklenir; çağıranın payload'ları
+    // döndükten sonra serbest bırakılabilir. Kurulum başarısızsa std::runtime_error atar.
+    class UringSendRing : private core::NonCopyable {
+    public:
+        explicit UringSendRing(size_t batch_size);
+        ~UringSendRing();
+
+        // En fazla batch_size paket gönderir; gönderilen paket sayısını, ring kullanılamaz
+        // hale geldiyse -1 döndürür (çağıran soket yoluna dönmelidir)
+        int send(int socket, const sockaddr_in& address, const core::PacketView* packets, size_t count);
+
+    private:
+        uint8_t* header(size_t index) { return headers_.data() + index * core::PACKET_HEADER_SIZE; }
+
+        io_uring ring_{};
+        const size_t batch_size_;
+        std::vector<uint8_t> headers_;
+        std::vector<msghdr> messages_;
+        std::vector<iovec> iovecs_;  // Mesaj başına 2: başlık + payload
+    };
+
+    // UdpReceiver'ın io_uring yolu. Havuz buffer'ları sağlanan buffer halkası (provided
+    // buffer ring) olarak çekirdeğe kaydedilir ve soket üzerinde tek bir multishot
+    // RECVMSG beklemede tutulur: her datagram, sistem çağrısı olmadan çekirdeğin seçtiği
+    // buffer'a yazılır ve bir CQE üretir. Callback'ten sonra buffer tek sahibindeyse
+    // halkaya geri verilir, paylaşıldıysa yerine havuzdan yenisi konur. Havuz boşken
+    // halka boşalırsa istek sonlanır ve buffer bulununca yeniden kurulur.
+    class UringReceiveRing : private core::NonCopyable {
+    public:
+        using OnPacketReceived = std::function<void(const core::PooledPacket&)>;
+
+        // buffer_count 2'nin kuvvetine yuvarlanır; havuz buffer'ları en az
+        // MAX_DATAGRAM_SIZE olmalıdır. Kurulum başarısızsa std::runtime_error atar.
+        UringReceiveRing(int socket, size_t buffer_count, core::BufferPool& pool);
+        ~UringReceiveRing();
+
+        // stop() çağrılana kadar çağıran thread'de tamamlananları işler. Çekirdek multishot
+        // RECVMSG'yi desteklemiyorsa false döner (çağıran soket yoluna dönmelidir).
+        bool run(const OnPacketReceived& callback);
+        // Her thread'den çağrılabilir; run() hemen döner
+        void stop();
+
+        uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    private:
+        static constexpr int BUFFER_GROUP = 0;
+
+        bool provide(uint16_t id);       // Slota buffer koyar (gerekirse havuzdan alır)
+        void arm_receive();
+        void arm_wakeup();
+        void refill();
+        bool handle_receive(const io_uring_cqe* cqe, const OnPacketReceived& callback);
+
+        const int socket_;
+        core::BufferPool& pool_;
+        io_uring ring_{};
+        io_uring_buf_ring* buffer_ring_ = nullptr;
+        const unsigned buffer_count_;
+        std::vector<core::PooledBuffer> buffers_;  // Buffer ID'si ile indekslenir
+        std::vector<uint16_t> missing_;            // Havuz boşken buffer'sız kalan ID'ler
+        size_t pending_provided_ = 0;             // Henüz yayınlanmamış halka eklemeleri
+        bool receive_armed_ = false;
+
+        msghdr receive_message_{};  // Multishot RECVMSG şablonu (adres/kontrol alanı yok)
+        int wake_fd_ = -1;
+        uint64_t wake_value_ = 0;
+        std::atomic<bool> running_{false};
+        std::atomic<uint64_t> dropped_{0};
+        core::PooledPacket packet_;
+    };
+}
+
+#endif
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef VOICE_ENGINE_PACER_HPP
+#define VOICE_ENGINE_PACER_HPP
+
+#include <chrono>
+#include <cstddef>
+
+namespace network {
+    // Token bucket: kova rate_bps hızında, en fazla burst_bytes dolar. Kova borçlu değilse
+    // (token >= 0) bir sonraki paket boyu ne olursa olsun gönderilebilir ve tokenlar
+    // paket boyu kadar azalır; böylece kovadan büyük paketler de beklemeden sırasını alır,
+    // ortalama hız yine rate_bps'i geçmez. Tek thread'den kullanılır.
+    class Pacer {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        Pacer(double rate_bps, size_t burst_bytes);
+
+        void set_rate(double rate_bps);
+        double rate_bps() const { return rate_bps_; }
+
+        bool can_send(Clock::time_point now);
+        void on_sent(size_t bytes) { tokens_ -= static_cast<double>(bytes); }
+        // Borcun kapanacağı an (kova doluysa şimdi)
+        Clock::time_point next_send_time() const;
+
+    private:
+        void refill(Clock::time_point now);
+
+        double rate_bps_;
+        const double burst_bytes_;
+        double tokens_;
+        Clock::time_point last_refill_{};
+        bool started_ = false;
+    };
+}
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef VOICE_ENGINE_SHARDED_UDP_RECEIVER_HPP
+#define VOICE_ENGINE_SHARDED_UDP_RECEIVER_HPP
+
+#ifdef VOICE_ENGINE_HAVE_EPOLL
+
+#include "core/non_copyable.hpp"
+#include "core/buffer_pool.hpp"
+#include "network/event_loop.hpp"
+#include "network/udp_receiver.hpp"
+#include <functional>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace network {
+    struct ShardStats {
+        int cpu = -1;               // Shard thread'inin sabitlendiği CPU (-1: sabitleme yok)
+        uint64_t received = 0;      // Callback'e verilen paketler
+        uint64_t dropped = 0;       // Havuz boşken atılan datagramlar
+        core::BufferPoolStats pool;
+    };
+
+    // Aynı porta SO_REUSEPORT ile bağlanan N soketten alım. Her shard'ın kendi soketi,
+    // buffer havuzu ve bir CPU'ya sabitlenmiş event loop thread'i vardır.
+    //
+    // Çekirdek, gelen datagramı kaynak/hedef adres-port dörtlüsünün hash'iyle bir sokete
+    // dağıtır; bir oturumun akışı (aynı uzak adres:port) soket grubu değişmediği sürece hep
+    // aynı shard'a düşer. Callback shard'ın thread'inde çalıştığından, oturum başına durum
+    // (ör. jitter buffer) shard'a ait tutulursa kilit gerektirmez. pin_threads ile shard i
+    // cpus[i]'ye sabitlenir ve soketine SO_INCOMING_CPU ile aynı CPU verilir: paketi o
+    // CPU'da işlenen (RSS kuyruğu o CPU'ya bağlı) akışlar tercihen bu shard'a gider ve
+    // ağ kesmesi ile uygulama aynı çekirdekte kalır.
+    class ShardedUdpReceiver : private core::NonCopyable {
+    public:
+        using OnPacketReceived = std::function<void(size_t shard, const core::PooledPacket&)>;
+
+        struct Options {
+            size_t shards = 0;               // 0: çevrimiçi CPU sayısı
+            std::vector<int> cpus;           // Shard başına CPU; boşsa 0..shards-1
+            bool pin_threads = true;         // Thread'leri sabitle ve SO_INCOMING_CPU ayarla
+            size_t batch_size = UdpReceiver::DEFAULT_BATCH_SIZE;
+            size_t pool_buffers = 0;         // Shard başına; 0: 4 * batch_size
+        };
+
+        explicit ShardedUdpReceiver(const Options& options);
+        ~ShardedUdpReceiver();
+
+        // Soketlerden biri açılamazsa açılanlar kapatılır ve false döner
+        bool start(int port, OnPacketReceived callback);
+        void stop();
+
+        size_t shard_count() const { return shards_.size(); }
+        ShardStats stats(size_t shard) const;
+
+    private:
+        struct Shard {
+            int cpu = -1;
+            std::unique_ptr<core::BufferPool> pool;
+            std::unique_ptr<EventLoop> loop;
+            std::unique_ptr<UdpReceiver> receiver;
+            std::atomic<uint64_t> received{0};
+        };
+
+        std::vector<std::unique_ptr<Shard>> shards_;
+        OnPacketReceived on_packet_received_;
+        bool pin_threads_;
+        bool running_ = false;
+    };
+}
+
+#endif
+
+#endif
@@ -3,10 +3,14 @@
 
 #include "core/non_copyable.hpp"
 #include "core/packet.hpp"
+#include "network/io_backend.hpp"
 #include <string>
 #include <functional>
 #include <thread>
 #include <atomic>
+#include <vector>
+#include <memory>
+#include <chrono>
 
 #ifdef _WIN32
 #include <winsock2.h>
@@ -14,21 +18,100 @@
 #pragma comment(lib, "ws2_32.lib")
 #else
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 #endif
 
 namespace network {
+    class EventLoop;
+    class UringReceiveRing;
+
+    // UDP alıcı. batch_size > 1 ve recvmmsg mevcutsa (VOICE_ENGINE_HAVE_MMSG) tek sistem
+    // çağrısıyla birden fazla datagram alınır. Çekirdek desteklemiyorsa (ENOSYS) datagram
+    // başına recvfrom'a geri dönülür. Datagramlar doğrudan havuz buffer'larına alınır ve
+    // kopyalanmadan iletilir; callback handle'ı saklarsa alıcı o slot için havuzdan yeni
+    // bir buffer alır. Havuz boşken gelen datagramlar okunup atılır (dropped()).
+    //
+    // epoll mevcutsa (VOICE_ENGINE_HAVE_EPOLL) soket non-blocking açılır ve bir EventLoop'a
+    // kaydedilir; çok sayıda alıcı tek bir döngü thread'ini paylaşabilir ve callback'ler o
+    // thread'de çalışır. Döngü verilmezse alıcı kendi döngüsünü kendi thread'inde çalıştırır.
+    // epoll yoksa her alıcı kendi thread'inde bloklayarak okur.
+    //
+    // IoBackend::IoUring seçilirse (ve mevcutsa) alıcı kendi thread'inde bir io_uring
+    // halkası çalıştırır: havuz buffer'ları çekirdeğe kaydedilir ve datagramlar tek bir
+    // multishot RECVMSG ile, datagram başına sistem çağrısı olmadan alınır. Bu modda
+    // EventLoop kullanılmaz. Çekirdek desteklemiyorsa soket yoluna dönülür.
+    //
+    // SocketOptions::gro ile (VOICE_ENGINE_HAVE_UDP_GSO, toplu soket yolu) çekirdek aynı
+    // akışın ardışık datagramlarını UDP_GRO ile tek bir GRO_BUFFER_SIZE'lık buffer'a
+    // birleştirir; alıcı bunları segment boyuna göre ayırır ve her paketi aynı buffer
+    // handle'ı ile ayrı ayrı iletir. Bu modda havuz buffer'ları GRO_BUFFER_SIZE olmalıdır
+    // (kendi havuzu bu boyda yeniden kurulur); daha küçük havuzla GRO açılmaz.
+    //
+    // SocketOptions::timestamps ile (varsayılan, toplu soket yolu) SO_TIMESTAMPNS açılır
+    // ve her paketin arrival alanı çekirdeğin geliş zamanından steady_clock'a çevrilir;
+    // böylece jitter, thread zamanlama gecikmesinden bağımsız ölçülür. Zaman damgası
+    // alınamayan yollarda (io_uring, datagram başına okuma) arrival okuma anıdır.
     class UdpReceiver : private core::NonCopyable {
     public:
-        using OnPacketReceived = std::function<void(core::Packet)>;
-        UdpReceiver();
+        // Paket, callback süresince geçerlidir; daha uzun tutmak için handle kopyalanır.
+        using OnPacketReceived = std::function<void(const core::PooledPacket&)>;
+        static constexpr size_t DEFAULT_BATCH_SIZE = 32;
+        static constexpr size_t GRO_BUFFER_SIZE = 65535;  // Birleşik datagram üst sınırı
+
+        // pool verilmezse batch_size'ın iki (io_uring'de dört) katı buffer'lık özel bir
+        // havuz kullanılır; io_uring halkası 2 * batch_size buffer tutar.
+        // Verilen havuz ve döngü alıcıdan uzun yaşamalıdır; havuz MAX_DATAGRAM_SIZE'lık
+        // buffer'lar içermelidir. Paylaşılan döngüyü başlatmak/durdurmak sahibinin işidir.
+        explicit UdpReceiver(size_t batch_size = DEFAULT_BATCH_SIZE, core::BufferPool* pool = nullptr,
+                             EventLoop* loop = nullptr, IoBackend backend = IoBackend::Socket);
         ~UdpReceiver();
-        bool start(int port, OnPacketReceived callback);
+        // Bind'den önce uygulanan soket seçenekleri
+        struct SocketOptions {
+            bool reuse_port = false;  // SO_REUSEPORT: aynı portu paylaşan soket grubuna katıl
+            int incoming_cpu = -1;    // SO_INCOMING_CPU: bu CPU'da işlenen akışları tercih et
+            bool gro = false;         // UDP_GRO: ardışık datagramları tek buffer'da al
+            bool timestamps = true;   // SO_TIMESTAMPNS: çekirdek geliş zamanını ilet
+        };
+
+        bool start(int port, OnPacketReceived callback) { return start(port, std::move(callback), SocketOptions()); }
+        bool start(int port, OnPacketReceived callback, const SocketOptions& options);
         void stop();
+
+        bool batching() const { return batching_; }
+        bool gro() const { return gro_; }
+        bool timestamps() const { return timestamps_; }
+        core::BufferPoolStats pool_stats() const { return pool_->stats(); }
+        uint64_t dropped() const;
+        IoBackend backend() const { return backend_; }
+
     private:
+        // Bir grup datagram okur; okumaya devam edilmesi gerekiyorsa true, kuyruk boşsa
+        // (EAGAIN) veya hata oluştuysa false döner
+        bool read_once();
+        bool read_batched();
+        bool read_single();
+        bool discard_one();
+        bool handle_error(const char* call);
+        // Paylaşılan veya boş slotlara havuzdan buffer alır; baştan itibaren kullanıma
+        // hazır slot sayısını döndürür
+        size_t prepare_buffers(size_t count);
+        // segment_size > 0 ise buffer bu boyda ardışık datagramlar içerir (GRO)
+        void deliver(size_t index, size_t length, std::chrono::steady_clock::time_point arrival,
+                     size_t segment_size = 0);
+        bool enable_gro();
+        bool enable_timestamps();
+#ifdef VOICE_ENGINE_HAVE_IO_URING
+        void uring_loop();
+#endif
+#ifdef VOICE_ENGINE_HAVE_EPOLL
+        void on_readable();
+#else
         void receive_loop();
+#endif
+
 #ifdef _WIN32
         SOCKET socket_ = INVALID_SOCKET;
         WSADATA wsa_data_{};
@@ -36,9 +119,36 @@ namespace network {
         int socket_ = -1;
 #endif
         OnPacketReceived on_packet_received_;
-        std::thread receiver_thread_;
         std::atomic<bool> is_running_{false};
+#ifdef VOICE_ENGINE_HAVE_EPOLL
+        std::unique_ptr<EventLoop> own_loop_;
+        EventLoop* loop_ = nullptr;
+#else
+        std::thread receiver_thread_;
+#endif
+
+#ifdef VOICE_ENGINE_HAVE_IO_URING
+        std::unique_ptr<UringReceiveRing> uring_;
+        std::thread uring_thread_;
+#endif
+
+        const size_t batch_size_;
+        std::atomic<bool> batching_;
+        std::atomic<IoBackend> backend_{IoBackend::Socket};  // Fiilen kullanılan yol
+        std::unique_ptr<core::BufferPool> own_pool_;
+        core::BufferPool* pool_;
+        std::vector<core::PooledBuffer> buffers_;  // batch_size_ alım slotu
+        core::PooledPacket packet_;               // Callback'e verilen paket (slot buffer'ı taşınır)
+        std::vector<uint8_t> discard_buffer_;      // Havuz boşken atılacak datagram
+        std::atomic<uint64_t> dropped_{0};
+#ifdef VOICE_ENGINE_HAVE_MMSG
+        std::vector<mmsghdr> messages_;
+        std::vector<iovec> iovecs_;
+        std::vector<uint8_t> control_;             // Mesaj başına cmsg alanı (zaman damgası, GRO)
+#endif
+        bool gro_ = false;
+        bool timestamps_ = false;
     };
 }
 
-#endif
\ No newline at end of file
+#endif
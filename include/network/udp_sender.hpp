@@ -3,8 +3,15 @@
 
 #include "core/non_copyable.hpp"
 #include "core/packet.hpp"
+#include "core/spsc_ring_buffer.hpp"
+#include "network/io_backend.hpp"
+#include "network/congestion_controller.hpp"
+#include "network/pacer.hpp"
 #include <string>
 #include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
 
 #ifdef _WIN32
 #include <winsock2.h>
@@ -12,20 +19,110 @@
 #pragma comment(lib, "ws2_32.lib")
 #else
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 #endif
 
 namespace network {
+    // UDP gönderici. Her datagram iki parçadan (iovec) oluşur: önceden ayrılmış alana
+    // yazılan core::PACKET_HEADER_SIZE byte'lık başlık ve çağıranın buffer'ındaki payload;
+    // payload kopyalanmaz. batch_size > 1 ve sendmmsg mevcutsa (VOICE_ENGINE_HAVE_MMSG)
+    // birden fazla paket tek sistem çağrısıyla gönderilir; çekirdek desteklemiyorsa
+    // (ENOSYS) paket başına sendmsg'ye geri dönülür. IoBackend::IoUring seçilirse (ve
+    // mevcutsa) her send() çağrısı tek bir io_uring_enter ile gönderilir. Gönderim
+    // sırasında allocation yapılmaz.
+    //
+    // SocketOptions::gso ile (VOICE_ENGINE_HAVE_UDP_GSO, soket yolu) bir batch'teki aynı
+    // boydaki ardışık paketler tek bir büyük mesajda birleştirilir ve çekirdeğe UDP_SEGMENT
+    // ile segment boyu verilir: çekirdek, yığını bir kez geçip datagramlara en son (çoğu
+    // zaman NIC'te) böler. Bir mesajda en fazla MAX_SEGMENTS paket olur ve yalnızca son
+    // paket daha kısa olabilir. Destek connect() sırasında sınanır; gönderimde çekirdek veya
+    // ağ aygıtı reddederse (EIO/EINVAL) kalıcı olarak normal toplu gönderime dönülür.
+    //
+    // CongestionOptions::enabled ile send() paketleri hemen göndermez: payload önceden
+    // ayrılmış bir slota kopyalanıp kilitsiz kuyruğa atılır ve connect()'te başlayan
+    // pacing thread'i paketleri token bucket (Pacer) hızında gönderir; Slicer'ın bir
+    // frame'den çıkardığı parçalar art arda değil, aralıklı çıkar. Pacer hızı, alıcının
+    // geliş zamanı geri bildiriminden (on_transport_feedback) DelayBasedController'ın
+    // hesapladığı hedefin pacing_factor katıdır. max_queue_delay_ms'den uzun bekleyen
+    // paketler hız sınırına bakılmadan gönderilir; kuyruk doluysa yeni paket atılır.
+    // send() tek bir thread'den çağrılmalıdır.
+    class UringSendRing;
+
     class UdpSender : private core::NonCopyable {
     public:
-        UdpSender();
+        static constexpr size_t DEFAULT_BATCH_SIZE = 32;
+        static constexpr size_t MAX_SEGMENTS = 64;          // Çekirdeğin UDP_MAX_SEGMENTS sınırı
+        static constexpr size_t MAX_SEGMENTED_SIZE = 65507; // IPv4 UDP payload sınırı
+
+        // connect() sırasında uygulanan soket seçenekleri
+        struct SocketOptions {
+            bool gso = false;  // UDP_SEGMENT: aynı boydaki paketleri tek mesajda gönder
+        };
+
+        // Gönderim tarafı tıkanıklık kontrolü ve pacing
+        struct CongestionOptions {
+            bool enabled = false;
+            DelayBasedController::Options rate;
+            double pacing_factor = 1.5;     // Pacer hızı / hedef hız; kısa patlamalar için pay
+            int max_queue_delay_ms = 40;    // Sesin gecikmesi pacer'da bunu aşmaz
+            size_t queue_packets = 64;
+        };
+
+        explicit UdpSender(size_t batch_size = DEFAULT_BATCH_SIZE, IoBackend backend = IoBackend::Socket)
+            : UdpSender(batch_size, backend, CongestionOptions()) {}
+        UdpSender(size_t batch_size, IoBackend backend, const CongestionOptions& congestion);
         ~UdpSender();
-        bool connect(const std::string& ip_address, int port);
+        bool connect(const std::string& ip_address, int port) { return connect(ip_address, port, SocketOptions()); }
+        bool connect(const std::string& ip_address, int port, const SocketOptions& options);
+        void send(const core::PacketView& packet);
+        void send(const core::PacketView* packets, size_t count);
         void send(const core::Packet& packet);
         void send(const std::vector<core::Packet>& packets);
+
+        // Alıcının bildirdiği geliş zamanları (geliş sırasıyla). Tıkanıklık kontrolü
+        // kapalıysa yok sayılır; tek bir thread'den (ör. alıcı callback'i) çağrılmalıdır.
+        void on_transport_feedback(const PacketArrival* arrivals, size_t count);
+
+        bool batching() const { return batching_; }
+        bool gso() const { return gso_; }
+        IoBackend backend() const { return backend_; }
+
+        // Tıkanıklık kontrolü kapalıysa 0; herhangi bir thread'den okunabilir
+        bool congestion_control() const { return congestion_.enabled; }
+        int target_bitrate_bps() const { return target_bitrate_bps_.load(std::memory_order_relaxed); }
+        double pacer_queue_delay_ms() const { return pacer_queue_delay_us_.load(std::memory_order_relaxed) / 1000.0; }
+        uint64_t pacer_dropped() const { return pacer_dropped_.load(std::memory_order_relaxed); }
+
     private:
+        // Pacer kuyruğundaki paket: başlık alanları ve payload'ın slotu
+        struct QueuedPacket {
+            uint32_t sequence_number;
+            uint32_t timestamp;
+            uint8_t fragment_index;
+            uint8_t fragment_count;
+            uint16_t frame_size;
+            uint16_t size;
+            uint16_t slot;
+            Pacer::Clock::time_point enqueued;
+        };
+
+        // Paketleri hemen gönderir (pacing kapalıyken send(), açıkken pacing thread'i)
+        void transmit(const core::PacketView* packets, size_t count);
+        void enqueue(const core::PacketView* packets, size_t count);
+        void pacing_loop();
+        void stop_pacing();
+        uint8_t* slot(size_t index) { return slots_.data() + index * core::MAX_DATAGRAM_SIZE; }
+
+        void send_one(const core::PacketView& packet);
+        void send_batch(const core::PacketView* packets, size_t count);
+        // Hazırlanmış paketleri segmentli mesajlarla gönderir; gönderilen (veya atılan)
+        // paket sayısını döndürür. GSO reddedilirse ilk gönderilmemiş paketin indeksini verir.
+        size_t send_segmented(size_t prepared);
+        uint8_t* header(size_t index) { return headers_.data() + index * core::PACKET_HEADER_SIZE; }
+
 #ifdef _WIN32
         SOCKET socket_ = INVALID_SOCKET;
         WSADATA wsa_data_{};
@@ -33,7 +130,46 @@ namespace network {
         int socket_ = -1;
 #endif
         sockaddr_in server_address_{};
+
+        const size_t batch_size_;
+        bool batching_;
+        bool gso_ = false;
+        IoBackend backend_ = IoBackend::Socket;  // Fiilen kullanılan yol
+#ifdef VOICE_ENGINE_HAVE_IO_URING
+        std::unique_ptr<UringSendRing> uring_;
+#endif
+        std::vector<uint8_t> headers_;           // batch_size_ * PACKET_HEADER_SIZE
+        std::vector<core::PacketView> views_;    // Vektör API'si için dönüşüm alanı
+#ifdef VOICE_ENGINE_HAVE_MMSG
+        std::vector<mmsghdr> messages_;
+        std::vector<iovec> iovecs_;              // Mesaj başına 2: başlık + payload
+#endif
+#ifdef VOICE_ENGINE_HAVE_UDP_GSO
+        std::vector<mmsghdr> segment_messages_;  // iovecs_ üzerinde ardışık paket grupları
+        std::vector<size_t> segment_first_;      // Mesajın ilk paketinin indeksi
+        std::vector<uint8_t> segment_control_;   // Mesaj başına bir UDP_SEGMENT cmsg'si
+#endif
+
+        // Pacing (sadece congestion_.enabled iken ayrılır). Slot indeksleri iki kuyruk
+        // arasında dolaşır: gönderen boş slot alıp paketi kuyruğa atar, pacing thread'i
+        // paketi gönderince slotu geri verir.
+        const CongestionOptions congestion_;
+        std::unique_ptr<DelayBasedController> controller_;  // Pacing thread'i
+        std::unique_ptr<Pacer> pacer_;                      // Pacing thread'i
+        std::vector<uint8_t> slots_;
+        std::unique_ptr<core::SpscRingBuffer<QueuedPacket>> queue_;
+        std::unique_ptr<core::SpscRingBuffer<uint16_t>> free_slots_;
+        std::unique_ptr<core::SpscRingBuffer<PacketArrival>> feedback_;
+        std::vector<core::PacketView> paced_views_;
+        std::vector<uint16_t> paced_slots_;
+        QueuedPacket head_{};     // Kuyruktan alınmış, sırası gelmemiş paket
+        bool has_head_ = false;
+        std::thread pacing_thread_;
+        std::atomic<bool> pacing_running_{false};
+        std::atomic<int> target_bitrate_bps_{0};
+        std::atomic<int64_t> pacer_queue_delay_us_{0};  // Son gönderilen paketin kuyrukta beklediği süre
+        std::atomic<uint64_t> pacer_dropped_{0};
     };
 }
 
-#endif
\ No newline at end of file
+#endif
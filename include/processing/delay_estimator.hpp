@@ -0,0 +1,80 @@
+#ifndef VOICE_ENGINE_DELAY_ESTIMATOR_HPP
+#define VOICE_ENGINE_DELAY_ESTIMATOR_HPP
+
+#include "core/non_copyable.hpp"
+#include "dsp/fft.hpp"
+#include <vector>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+
+namespace processing {
+    // Hoparlör -> mikrofon toplu gecikme tahmincisi (GCC-PHAT).
+    //
+    // Referans ve mikrofon akışları 4x seyreltilir (48 kHz -> 12 kHz) ve her
+    // UPDATE_INTERVAL_MS'de bir, son ~340 ms'lik pencere üzerinden faz dönüşümlü
+    // genelleştirilmiş çapraz korelasyon hesaplanır. Çapraz spektrum güncellemeler
+    // arasında yumuşatılır; yeni bir gecikme ancak yeterli güvenle ve art arda
+    // STABLE_UPDATES kez aynı çıkarsa kabul edilir (histerezis).
+    //
+    // Sonuç, eko gidericinin referansını hizalamak için kullanılır; böylece adaptif
+    // filtre sadece oda yanıtını modeller, toplu gecikmeyi değil.
+    class DelayEstimator : private core::NonCopyable {
+    public:
+        static constexpr size_t DECIMATION = 4;
+        static constexpr int UPDATE_INTERVAL_MS = 100;
+        static constexpr int STABLE_UPDATES = 3;
+
+        explicit DelayEstimator(int sample_rate = 48000, int max_delay_ms = 250);
+
+        // Aynı callback'e ait mikrofon ve hoparlör örnekleri. capture nullptr ise
+        // sessizlik varsayılır. Kabul edilen gecikme değiştiyse true döner.
+        bool process(const int16_t* capture, const int16_t* reference, size_t count);
+
+        void reset();
+
+        bool has_estimate() const { return delay_ >= 0; }
+        // Kabul edilen gecikme (tam örnek hızında, DECIMATION çözünürlüğünde)
+        size_t delay_samples() const { return has_estimate() ? static_cast<size_t>(delay_) * DECIMATION : 0; }
+        // Son hesaplanan korelasyon tepesinin ortalamaya oranı
+        float confidence() const { return confidence_; }
+        size_t max_delay_samples() const { return max_lag_ * DECIMATION; }
+
+    private:
+        bool update();
+        void copy_history(const std::vector<float>& history, size_t length, float* out) const;
+
+        const size_t max_lag_;          // Seyreltilmiş örnek cinsinden en büyük gecikme
+        const size_t window_;           // Korelasyon penceresi (seyreltilmiş)
+        const size_t fft_size_;
+        const size_t update_interval_;  // Güncellemeler arası seyreltilmiş örnek
+        const size_t min_bin_;          // Bu bin'in altı (DC, uğultu) hesaba katılmaz
+
+        dsp::RealFft fft_;
+
+        // Seyreltilmiş geçmişler, dairesel (fft_size_ örnek)
+        std::vector<float> reference_history_;
+        std::vector<float> capture_history_;
+        size_t history_pos_;
+        size_t history_count_;
+
+        // Seyreltme akümülatörleri
+        float reference_acc_;
+        float capture_acc_;
+        size_t decimation_phase_;
+        size_t samples_since_update_;
+
+        // Çalışma alanları
+        std::vector<float> time_buffer_;
+        std::vector<std::complex<float>> reference_spectrum_;
+        std::vector<std::complex<float>> capture_spectrum_;
+        std::vector<std::complex<float>> cross_spectrum_;  // Yumuşatılmış Y · conj(X)
+
+        long delay_;            // Kabul edilen gecikme (seyreltilmiş), -1: henüz yok
+        long candidate_;
+        int candidate_count_;
+        float confidence_;
+    };
+}
+
+#endif
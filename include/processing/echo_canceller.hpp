@@ -1,26 +1,85 @@
 #ifndef VOICE_ENGINE_ECHO_CANCELLER_HPP
 #define VOICE_ENGINE_ECHO_CANCELLER_HPP
 
+#include "processing/partitioned_block_filter.hpp"
+#include "core/spsc_ring_buffer.hpp"
+#include "dsp/kernels.hpp"
 #include <vector>
 #include <cstdint>
 #include <mutex>
+#include <memory>
 
 namespace processing {
     class EchoCanceller {
     public:
-        explicit EchoCanceller(size_t filter_length = 1024, float step_size = 0.5f);
+        // TimeDomainNlms: örnek başına NLMS, kısa filtreler için (gecikme yok).
+        // PartitionedBlock: frekans domeni MDF, 100-250 ms'lik uzun eko kuyrukları için
+        // (PARTITION_BLOCK_SIZE örnek ek gecikme).
+        enum class Engine {
+            TimeDomainNlms,
+            PartitionedBlock
+        };
+
+        static constexpr size_t PARTITION_BLOCK_SIZE = 256;
+        // Referansa uygulanabilecek en büyük toplu gecikme (48 kHz'de 250 ms)
+        static constexpr size_t MAX_BULK_DELAY = 12000;
+
+        explicit EchoCanceller(size_t filter_length = 1024, float step_size = 0.5f,
+                               Engine engine = Engine::TimeDomainNlms);
         void on_playback(const std::vector<int16_t>& samples);
+        void on_playback(const int16_t* samples, size_t count);
         void process(std::vector<int16_t>& capture);
+        void process(int16_t* capture, size_t count);
         void reset();
 
+        // Mikrofon örneği n'nin referans akışındaki n - samples örneğiyle eşleşmesini
+        // sağlar (hoparlör -> mikrofon toplu gecikmesi). Her iki akış da başlangıçtan
+        // beri verilen örnek sayısıyla indekslenir. Filtre böylece sadece oda yanıtını
+        // modeller. Büyük değişikliklerde adaptasyon sıfırlanır.
+        void set_bulk_delay(size_t samples);
+        size_t bulk_delay() const { return bulk_delay_; }
+
+        // Mikrofon verisi olmadan geçen örnekler; referans hizası korunur
+        void skip_capture(size_t count);
+
+        Engine engine() const { return engine_; }
+
     private:
+        void process_time_domain(int16_t* capture, size_t count);
+        void push_history(float sample);
+        void process_partitioned(int16_t* capture, size_t count);
+        void take_reference(float* out, size_t count);
+        void reset_adaptation();
+
+        const Engine engine_;
         const size_t filter_length_;
         const float step_size_; // NLMS için 'mu'
         const float epsilon_;   // Stabilizasyon için küçük bir değer
 
         std::vector<float> filter_weights_;
-        std::vector<float> reference_buffer_; // Playback sinyali için buffer
-        
+
+        // Referans geçmişi, aynalanmış dairesel buffer (2 x filter_length_): her örnek
+        // hem history_pos_ hem history_pos_ + filter_length_ konumuna yazılır. Böylece
+        // en yeniden en eskiye filter_length_ örnek her zaman bitişik bir pencere
+        // olarak okunur ve kaydırma gerekmez.
+        std::vector<float> reference_history_;
+        size_t history_pos_ = 0;
+        double reference_power_ = 0.0;      // Penceredeki enerjinin artımlı takibi
+        size_t power_update_count_ = 0;     // Kayan hatayı sıfırlamak için sayaç
+
+        // on_playback ile gelen ve henüz mikrofon örnekleriyle eşleşmemiş referans örnekleri.
+        // process() her mikrofon örneği için bir referans örneği tüketir; hangisinin
+        // tüketileceği akış sayaçları ve toplu gecikmeden belirlenir.
+        core::SpscRingBuffer<float> reference_fifo_;
+        uint64_t reference_count_ = 0;  // on_playback ile gelen toplam referans örneği
+        uint64_t capture_count_ = 0;    // İşlenen (veya atlanan) toplam mikrofon örneği
+        size_t bulk_delay_ = 0;
+
+        std::unique_ptr<PartitionedBlockFilter> block_filter_; // PartitionedBlock motoru
+        std::vector<float> conversion_buffer_;                  // int16 <-> float dönüşümü
+        std::vector<float> capture_buffer_;                     // NLMS'te mikrofon / hata örnekleri
+        const dsp::KernelTable& kernels_;
+
         std::mutex mutex_;
     };
 }
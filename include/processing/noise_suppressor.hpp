@@ -1,6 +1,8 @@
 #ifndef VOICE_ENGINE_NOISE_SUPPRESSOR_HPP
 #define VOICE_ENGINE_NOISE_SUPPRESSOR_HPP
 
+#include "dsp/fft.hpp"
+#include "dsp/kernels.hpp"
 #include <vector>
 #include <cstdint>
 #include <complex>
@@ -10,12 +12,11 @@ namespace processing {
     public:
         explicit NoiseSuppressor(int frame_size = 512, float suppression_db = -20.0f);
         void process(std::vector<int16_t>& samples);
+        void process(int16_t* samples, size_t count);
         void reset();
 
     private:
         void process_frame();
-        void compute_fft(const std::vector<float>& input, std::vector<std::complex<float>>& output);
-        void compute_ifft(const std::vector<std::complex<float>>& input, std::vector<float>& output);
 
         const int frame_size_;
         const int hop_size_;
@@ -27,9 +28,12 @@ namespace processing {
         std::vector<float> frame_buffer_;
         std::vector<float> output_frame_buffer_;
         
-        std::vector<std::complex<float>> fft_buffer_;
+        dsp::RealFft fft_;
+        std::vector<std::complex<float>> fft_buffer_; // frame_size / 2 + 1 bin
         std::vector<float> magnitude_spectrum_;
         std::vector<float> noise_spectrum_;
+        std::vector<float> gain_spectrum_;
+        const dsp::KernelTable& kernels_;
 
         int input_buffer_pos_;
         int output_buffer_pos_;
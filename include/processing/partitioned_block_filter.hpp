@@ -0,0 +1,73 @@
+#ifndef VOICE_ENGINE_PARTITIONED_BLOCK_FILTER_HPP
+#define VOICE_ENGINE_PARTITIONED_BLOCK_FILTER_HPP
+
+#include "core/non_copyable.hpp"
+#include "dsp/fft.hpp"
+#include "dsp/kernels.hpp"
+#include <vector>
+#include <complex>
+#include <cstddef>
+
+namespace processing {
+    // Frekans domeninde bölümlenmiş blok adaptif filtre (PBFDAF / MDF).
+    //
+    // filter_length tap'lik filtre, block_size uzunluğunda P = ceil(L / B) bölüme
+    // ayrılır. Her B örnekte bir 2B noktalı FFT ile filtreleme ve normalize edilmiş
+    // frekans domeni güncellemesi yapılır; örnek başına maliyet O(P + log B)'dir.
+    // Gradient kısıtı (circular convolution düzeltmesi) her blokta sırayla tek bir
+    // bölüme uygulanır. Çıkış girişe göre block_size örnek gecikmelidir. Bin döngüleri
+    // (eko tahmini, referans gücü, ağırlık güncellemesi) dsp::KernelTable üzerinden çalışır.
+    class PartitionedBlockFilter : private core::NonCopyable {
+    public:
+        PartitionedBlockFilter(size_t filter_length, size_t block_size, float step_size);
+
+        // Hoparlör (referans) örnekleri, [-1, 1] aralığında
+        void push_reference(const float* samples, size_t count);
+
+        // Mikrofon örneklerini yerinde eko çıkarılmış sinyalle değiştirir
+        void process(float* capture, size_t count);
+
+        void reset();
+
+        size_t block_size() const { return block_size_; }
+        size_t partitions() const { return partitions_; }
+
+    private:
+        void process_block();
+        void pop_reference_block(float* out);
+
+        const size_t block_size_;   // B
+        const size_t fft_size_;     // N = 2B
+        const size_t bins_;         // B + 1
+        const size_t partitions_;   // P
+        const float step_size_;
+        const float epsilon_;
+
+        const dsp::KernelTable& kernels_;
+        dsp::RealFft fft_;
+
+        // Frekans domeni referans geçmişi ve filtre ağırlıkları: P x bins, düz dizi.
+        // Referans geçmişi dairesel tutulur; newest_partition_ en yeni bloğu gösterir.
+        std::vector<std::complex<float>> reference_spectra_;
+        std::vector<std::complex<float>> weights_;
+        size_t newest_partition_;
+        size_t constrain_partition_;
+
+        // Referans FIFO'su (on_playback ile process arasındaki hız farkı için)
+        std::vector<float> reference_fifo_;
+        size_t fifo_read_;
+        size_t fifo_size_;
+
+        // Blok çalışma alanları
+        std::vector<float> reference_window_;  // [önceki B | yeni B]
+        std::vector<float> capture_block_;
+        std::vector<float> output_block_;
+        std::vector<float> time_buffer_;       // N
+        std::vector<std::complex<float>> spectrum_;
+        std::vector<std::complex<float>> error_spectrum_;
+        std::vector<float> power_;             // Bin başına referans gücü (tüm bölümler)
+        size_t block_pos_;
+    };
+}
+
+#endif
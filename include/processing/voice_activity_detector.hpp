@@ -0,0 +1,61 @@
+#ifndef VOICE_ENGINE_VOICE_ACTIVITY_DETECTOR_HPP
+#define VOICE_ENGINE_VOICE_ACTIVITY_DETECTOR_HPP
+
+#include "core/non_copyable.hpp"
+#include "dsp/fft.hpp"
+#include "dsp/kernels.hpp"
+#include <vector>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+
+namespace processing {
+    // Frame bazlı konuşma tespiti.
+    //
+    // Karar üç bileşenden oluşur:
+    //  - Enerji: frame seviyesi uyarlanır bir gürültü tabanıyla karşılaştırılır
+    //    (taban düşüşleri hemen, yükselişleri yavaşça takip eder).
+    //  - Spektral düzlük: 300-4000 Hz bandında geometrik / aritmetik ortalama.
+    //    Harmonik konuşma düşük, durağan gürültü yüksek değer verir.
+    //  - Hangover: konuşma bittikten sonra HANGOVER_FRAMES boyunca aktif kalır ki
+    //    cümle sonları ve kelime arası sessizlikler kırpılmasın.
+    // Mutlak bir eşik yerine tabana göre karar verildiği için yumuşak başlangıçlar
+    // sabit bir RMS eşiğindeki gibi kesilmez.
+    class VoiceActivityDetector : private core::NonCopyable {
+    public:
+        static constexpr int HANGOVER_FRAMES = 20;  // 10 ms frame'lerle 200 ms
+
+        explicit VoiceActivityDetector(int sample_rate = 48000, size_t frame_size = 480);
+
+        // Bir frame'i analiz eder; konuşma (veya hangover) varsa true döner
+        bool process(const int16_t* samples, size_t count);
+        void reset();
+
+        bool active() const { return active_; }
+        float level_db() const { return level_db_; }          // Son frame seviyesi (dBFS)
+        float noise_floor_db() const { return noise_floor_db_; }
+        float flatness() const { return flatness_; }
+
+    private:
+        float spectral_flatness(const int16_t* samples, size_t count);
+
+        const size_t fft_size_;
+        const size_t low_bin_;
+        const size_t high_bin_;
+
+        dsp::RealFft fft_;
+        const dsp::KernelTable& kernels_;
+        std::vector<float> window_;
+        std::vector<float> frame_buffer_;
+        std::vector<std::complex<float>> spectrum_;
+
+        bool initialized_;
+        bool active_;
+        int hangover_;
+        float level_db_;
+        float noise_floor_db_;
+        float flatness_;
+    };
+}
+
+#endif
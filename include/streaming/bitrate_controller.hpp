@@ -0,0 +1,92 @@
+#ifndef VOICE_ENGINE_BITRATE_CONTROLLER_HPP
+#define VOICE_ENGINE_BITRATE_CONTROLLER_HPP
+
+#include "streaming/feedback.hpp"
+
+namespace streaming {
+    // Kodlayıcıya uygulanacak ayarlar
+    struct EncoderSettings {
+        int bitrate_bps = 64000;
+        int packet_loss_percent = 10;  // Encoder'ın FEC/sağlamlık için beklediği kayıp
+        bool inband_fec = true;
+        int complexity = 5;
+
+        bool operator==(const EncoderSettings& other) const {
+            return bitrate_bps == other.bitrate_bps && packet_loss_percent == other.packet_loss_percent &&
+                   inband_fec == other.inband_fec && complexity == other.complexity;
+        }
+        bool operator!=(const EncoderSettings& other) const { return !(*this == other); }
+    };
+
+    // Karşı tarafın raporlarından kodlayıcı ayarlarını türeten gönderici tarafı kontrolcü.
+    //
+    // Bitrate kayıp tabanlıdır (GCC'nin kayıp tabanlı denetleyicisi gibi): rapordaki
+    // kayıp HIGH_LOSS'un üstündeyse bitrate (1 - kayıp / 2) ile çarpılır, LOW_LOSS'un
+    // altındaysa INCREASE_FACTOR kadar artar, arada tutulur. Kayıpta karşı tarafın
+    // aldığı hız darboğazın kapasitesidir: bitrate bunun DRAIN_FACTOR katına da inerek
+    // dolu kuyruğu boşaltır ve bu hız tavan olarak hatırlanır. Aradaki kayıpta bitrate
+    // alınan hızın üstündeyse fazlası darboğazda atılıyordur; aynı şekilde inilir. Tavanın yakınında
+    // (CEILING_LOW..CEILING_HIGH) artış rapor başına ADDITIVE_INCREASE_BPS'e yavaşlar;
+    // aksi halde kuyruk her artışta yeniden dolup taşardı. Artış, jitter yükselirken
+    // (darboğazda kuyruk oluşuyor) bekletilir ve alınan hızın RECEIVE_RATE_HEADROOM
+    // katıyla sınırlanır. Az frame'li aralıklar (sessizlik / DTX) karar vermez.
+    // Beklenen kayıp ve FEC yumuşatılmış kayıptan, karmaşıklık kodlama thread'inin
+    // frame başına yükünden ayarlanır. Gönderim tarafında gecikme tabanlı bir kontrol
+    // varsa uygulanan bitrate onun sınırını da aşmaz (GCC'deki gibi iki tahminin küçüğü).
+    //
+    // Tek thread'den (kodlayıcıyı süren thread) kullanılır.
+    class BitrateController {
+    public:
+        struct Options {
+            int min_bitrate_bps = 12000;
+            int max_bitrate_bps = 64000;   // Başlangıç bitrate'i
+            int min_complexity = 1;
+            int max_complexity = 5;        // Başlangıç karmaşıklığı
+        };
+
+        static constexpr double HIGH_LOSS = 0.10;
+        static constexpr double LOW_LOSS = 0.02;
+        static constexpr double INCREASE_FACTOR = 1.05;
+        static constexpr double RECEIVE_RATE_HEADROOM = 1.5;
+        static constexpr double DRAIN_FACTOR = 0.9;
+        static constexpr double CEILING_LOW = 0.9;
+        static constexpr double CEILING_HIGH = 1.2;
+        static constexpr double ADDITIVE_INCREASE_BPS = 1000.0;
+        static constexpr double JITTER_RISE_MS = 5.0;      // Yumuşatılmış jitter'ın üstü: kuyruk
+        static constexpr double LOSS_SMOOTHING = 0.3;
+        static constexpr double FEC_ON_LOSS = 0.01;        // FEC histerezisi
+        static constexpr double FEC_OFF_LOSS = 0.005;
+        static constexpr int FEC_MIN_BITRATE_BPS = 16000;  // Altında LBRR ana akıştan fazla çalar
+        static constexpr int MAX_LOSS_PERCENT = 30;
+        static constexpr size_t MIN_EXPECTED_FRAMES = 10;
+        static constexpr double HIGH_ENCODE_LOAD = 0.5;    // Frame süresine oranla işleme süresi
+        static constexpr double LOW_ENCODE_LOAD = 0.25;
+
+        explicit BitrateController(const Options& options);
+
+        // Ayarlar değiştiyse true
+        bool on_report(const ReceiverReport& report);
+        // load: kodlama thread'inin frame başına işleme süresi / frame süresi
+        bool on_encode_load(double load);
+        // Gecikme tabanlı kontrolün izin verdiği payload hızı (0: sınır yok)
+        bool set_rate_limit(int bitrate_bps);
+
+        const EncoderSettings& settings() const { return settings_; }
+        double smoothed_loss() const { return smoothed_loss_; }
+
+    private:
+        // Uygulanan bitrate'i kayıp tabanlı bitrate ve sınırdan yeniden hesaplar
+        void update_bitrate();
+
+        const Options options_;
+        EncoderSettings settings_;
+        double bitrate_bps_;        // Kayıp tabanlı bitrate
+        int rate_limit_bps_ = 0;
+        double ceiling_bps_ = 0.0;  // Son kayıpta alınan hız (0: henüz kayıp yok)
+        double smoothed_loss_ = 0.0;
+        double smoothed_jitter_ms_ = 0.0;
+        bool has_jitter_ = false;
+    };
+}
+
+#endif
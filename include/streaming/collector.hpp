@@ -1,21 +1,215 @@
 #ifndef VOICE_ENGINE_COLLECTOR_HPP
 #define VOICE_ENGINE_COLLECTOR_HPP
 
+#include "core/non_copyable.hpp"
 #include "core/packet.hpp"
+#include "streaming/fec.hpp"
 #include <vector>
-#include <functional>
+#include <chrono>
+#include <mutex>
+#include <cstddef>
+#include <cstdint>
 
 namespace streaming {
-    class Collector {
+    struct JitterBufferStats {
+        uint64_t received = 0;      // Tampona kabul edilen paketler
+        uint64_t played = 0;        // Oynatılmak üzere çıkarılan paketler
+        uint64_t late = 0;          // Oynatma noktası geçtikten sonra gelen paketler
+        uint64_t lost = 0;          // Zamanında gelmediği için atlanan paketler
+        uint64_t duplicates = 0;
+        uint64_t discarded = 0;     // Gecikme kırpma, pencere taşması veya geçersiz boyut
+        uint64_t underruns = 0;     // Konuşma ortasında tamponun boşalması
+        uint64_t reassembled = 0;   // Parçalarından birleştirilen frame'ler
+        uint64_t incomplete = 0;    // Zaman aşımı veya oynatma noktası yüzünden eksik kalan frame'ler
+        uint64_t fec_parity_received = 0;
+        uint64_t fec_recovered = 0;      // Pariteden geri kurulan datagramlar
+        uint64_t fec_unrecoverable = 0;  // Parite yetmediği için kurulamayan datagramlar
+        size_t depth = 0;           // Tampondaki paket sayısı
+        double jitter_ms = 0.0;     // RFC 3550 geliş zamanı jitter'ı
+        double target_delay_ms = 0.0;
+    };
+
+    // Sıra numarasına göre çalışan uyarlanır jitter buffer.
+    //
+    // insert() ağ thread'inden, pop() oynatma hızında (her 10 ms frame için bir kez)
+    // başka bir thread'den çağrılır. Slotlar önceden ayrılır ve allocation yapılmaz.
+    // Havuz buffer'ındaki paketler (PooledPacket) kopyalanmadan, handle'ı tutularak
+    // saklanır; sadece görünüm olarak gelenler kendi havuzundan bir buffer'a kopyalanır.
+    // pop() tüketiciye payload'ın kendisini verir (ör. decoder doğrudan alım buffer'ından
+    // okur). Tüketici kilit bırakıldıktan sonra çalışır; buffer'ın handle'ı o sürece
+    // tutulur, böylece çözme sırasında insert() / recover() beklemez.
+    //
+    //  - Sıra numaraları 32-bit taşmaya karşı işaretli fark ile karşılaştırılır.
+    //  - Oynatma noktasından önceki paketler geç, aynı sıra numarası tekrar sayılır.
+    //  - Hedef gecikme, zaman damgalarından ölçülen jitter'ın JITTER_MULTIPLIER katıdır
+    //    ve [MIN_DELAY_MS, MAX_DELAY_MS] aralığında tutulur. Tampon boşaldığında
+    //    (konuşma sonu / DTX veya ağ kesintisi) yeniden dolum, en eski paket hedef
+    //    gecikme kadar bekleyene dek sürer; böylece gecikme her konuşma başında
+    //    güncel ağ koşullarına göre yeniden kurulur. Derinlik hedefi aşarsa en eski
+    //    paketler atılarak gecikme geri çekilir.
+    //  - Parçalı frame'ler (fragment_count > 1) önce REASSEMBLY_SLOTS'luk birleştirme
+    //    tablosuna girer: slot sıra numarasından bulunur ve parça, başlıktaki frame
+    //    boyundan hesaplanan offset'e doğrudan kopyalanır (sıra ve tekrar bağımsız, O(1)).
+    //    Tamamlanan frame tek bir paket gibi jitter buffer'a eklenir. İlk parçasından
+    //    REASSEMBLY_TIMEOUT_MS sonra tamamlanmamış, oynatma noktasının gerisinde kalmış
+    //    veya yerini daha yeni bir frame'e bırakması gereken birleştirmeler atılır.
+    //  - Gönderen birden fazla frame'i tek pakette yolluyorsa (set_packet_frames) paketler
+    //    frame'lerine bölünerek eklenir; alt gecikme sınırı bir paketin süresi artı bir
+    //    frame olur, aksi halde her paket gelmeden hemen önce tampon boşalırdı.
+    //  - Gönderen uygulama seviyesi FEC kullanıyorsa (Slicer::set_fec) datagramlar ve
+    //    parite paketleri recover()'dan da geçer; eksik datagramlar oynatma noktasına
+    //    gelmeden geri kurulur ve insert_recovered() ile eklenir. Geri kurulan paketin
+    //    geliş zamanı gerçek değildir, jitter tahminine girmez. Parite geldiği sürece alt
+    //    gecikme sınırı bir grubun süresini de kapsar; yoksa kurulan paketler geç kalırdı.
+    class Collector : private core::NonCopyable {
     public:
-        using OnDataCollected = std::function<void(const std::vector<uint8_t>&)>;
+        enum class InsertResult {
+            Accepted,
+            Partial,    // Parça saklandı, frame henüz tamamlanmadı
+            Duplicate,
+            Late,
+            Invalid
+        };
+
+        enum class Playout {
+            Frame,  // Bir paket çıkarıldı
+            Lost,   // Sıradaki paket yok ama daha yenileri var; kayıp kabul edildi.
+                    // Hemen ardından gelen paket varsa FEC için verilir (size > 0)
+                    // ama tüketilmez.
+            Empty   // Tampon boş veya dolum sürüyor
+        };
+
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr size_t MAX_PAYLOAD_SIZE = 1500;      // Tek paketlik frame
+        static constexpr size_t MAX_FRAME_SIZE = 7680;        // Birleştirilen frame (Opus 120 ms)
+        static constexpr size_t REASSEMBLY_SLOTS = 8;         // Aynı anda birleştirilen frame (2^n)
+        static constexpr double REASSEMBLY_TIMEOUT_MS = 100.0;
+        static constexpr size_t DEFAULT_CAPACITY = 64;
+        static constexpr double MIN_DELAY_MS = 20.0;
+        static constexpr double MAX_DELAY_MS = 400.0;
+        static constexpr double JITTER_MULTIPLIER = 4.0;
+        static constexpr size_t MAX_EXCESS_PACKETS = 3;  // Hedefin üstünde tolere edilen paket
+        static constexpr size_t FEC_EXPIRY_PACKETS = 4 * FecParityHeader::MAX_MEDIA;  // Paritesiz medya
 
-        void collect(const core::Packet& packet, const OnDataCollected& callback) {
-            if (callback) {
-                callback(packet.data);
+        explicit Collector(int sample_rate = 48000, size_t frame_samples = 480, size_t capacity = DEFAULT_CAPACITY);
+
+        // Payload'ı kopyalar
+        InsertResult insert(const core::PacketView& packet, Clock::time_point arrival);
+        // Buffer handle'ını tutar; payload kopyalanmaz
+        InsertResult insert(const core::PooledPacket& packet, Clock::time_point arrival);
+        InsertResult insert(const core::Packet& packet, Clock::time_point arrival) {
+            return insert(packet.view(), arrival);
+        }
+        // Geri kurulan datagram (veya çok frame'li paketin bir frame'i); payload kopyalanır
+        InsertResult insert_recovered(const core::PacketView& packet, Clock::time_point arrival);
+
+        // Ağdan gelen medya datagramı (frame'lerine bölünmeden önce) veya parite paketi.
+        // Geri kurulan datagramlar 'recovered'a yazılır ve sayıları döner; çağıran onları
+        // ağdan gelmiş gibi işleyip insert_recovered() ile ekler. Görünümler bir sonraki
+        // recover() çağrısına kadar geçerlidir; insert() ile aynı thread'den çağrılır.
+        size_t recover(const core::PacketView& datagram, core::PacketView* recovered, size_t max_recovered);
+
+        // Sıradaki paketi consume(Playout, const uint8_t* data, size_t size) ile verir.
+        // consume kilit dışında çağrılır; data, buffer handle'ı tutulduğu için consume
+        // dönene kadar geçerlidir.
+        template <typename Consume>
+        Playout pop(Clock::time_point now, Consume&& consume) {
+            core::PooledBuffer buffer;
+            const uint8_t* data = nullptr;
+            size_t size = 0;
+            Playout result;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                result = pop_locked(now, buffer, data, size);
             }
+            consume(result, data, size);
+            return result;
         }
+
+        // Sıradaki paketi 'out'a kopyalar (Frame durumunda size > 0)
+        Playout pop(uint8_t* out, size_t capacity, size_t& size, Clock::time_point now);
+
+        // Gelen paketlerin taşıdığı frame sayısı (1: her pakette tek frame)
+        void set_packet_frames(size_t frames);
+
+        JitterBufferStats stats() const;
+        void reset();
+
+    private:
+        struct Slot {
+            bool filled = false;
+            uint32_t sequence_number = 0;
+            uint32_t timestamp = 0;
+            Clock::time_point arrival{};
+            core::PooledBuffer buffer;
+            const uint8_t* data = nullptr;  // buffer içinde payload'ın başı
+            size_t size = 0;
+        };
+
+        struct Reassembly {
+            bool active = false;
+            uint32_t sequence_number = 0;
+            uint32_t timestamp = 0;
+            size_t fragment_count = 0;
+            size_t frame_size = 0;
+            size_t received = 0;
+            uint64_t received_mask[(core::MAX_FRAGMENTS + 63) / 64] = {};
+            Clock::time_point first_arrival{};
+            core::PooledBuffer buffer;
+        };
+
+        // data'yı içeren buffer'ın handle'ı 'buffer'a verilir (slot tampondan çıksa da geçerli kalır)
+        Playout pop_locked(Clock::time_point now, core::PooledBuffer& buffer, const uint8_t*& data, size_t& size);
+        // recovered: paket FEC ile geri kuruldu, geliş zamanı jitter tahminine girmez
+        InsertResult insert_locked(const core::PacketView& packet, const core::PooledBuffer* buffer,
+                                   Clock::time_point arrival, bool recovered);
+        InsertResult insert_fragment(const core::PacketView& packet, Clock::time_point arrival, bool recovered);
+        // Tam bir frame'i sıra numarasının slotuna yerleştirir
+        InsertResult store_locked(const core::PacketView& packet, const core::PooledBuffer* buffer,
+                                  Clock::time_point arrival, bool recovered);
+        void expire_fragments(Clock::time_point now);
+        void abandon(Reassembly& frame);
+        void release(Slot& slot);
+        void update_jitter(uint32_t timestamp, Clock::time_point arrival);
+        size_t target_packets() const;
+        double target_delay_ms() const;
+        void drop_oldest();
+
+        const int sample_rate_;
+        const uint32_t frame_samples_;
+        const double frame_ms_;
+        const size_t capacity_;
+        const size_t mask_;
+
+        mutable std::mutex mutex_;
+        std::vector<Slot> slots_;
+        // Görünüm olarak eklenen paketler için (capacity_ + 1: biri pop() tüketicisinde olabilir)
+        core::BufferPool copy_pool_;
+        std::vector<Reassembly> reassembly_;  // Sıra numarasıyla indekslenir
+        // Birleştirilen frame'ler; slotlar, birleştirmeler ve pop() tüketicisi aynı anda tutabilir
+        core::BufferPool frame_pool_;
+        FecDecoder fec_;
+
+        bool started_ = false;
+        bool buffering_ = true;
+        bool last_played_dtx_ = false;
+        bool has_last_played_ = false;
+        uint32_t last_played_timestamp_ = 0;  // Son oynatılan (veya kayıp) frame'in zamanı
+        uint32_t next_sequence_ = 0;
+        size_t depth_ = 0;
+        size_t packet_frames_ = 1;
+        size_t fec_frames_ = 0;          // Son parite grubunun süresi (frame)
+        size_t media_since_parity_ = 0;
+
+        // Jitter tahmini (sample cinsinden, RFC 3550 6.4.1)
+        bool has_transit_ = false;
+        Clock::time_point epoch_{};
+        double last_transit_ = 0.0;
+        double jitter_ = 0.0;
+
+        JitterBufferStats stats_;
     };
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,165 @@
+#ifndef VOICE_ENGINE_FEC_HPP
+#define VOICE_ENGINE_FEC_HPP
+
+#include "core/packet.hpp"
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace streaming {
+    // GF(2^8) aritmetiği (indirgeme polinomu x^8 + x^4 + x^3 + x^2 + 1, 0x11D)
+    namespace gf256 {
+        uint8_t multiply(uint8_t a, uint8_t b);
+        uint8_t inverse(uint8_t a);  // a != 0
+        // dsp::KernelTable::gf256_multiply_add'in beklediği 32 byte'lık yarım byte tabloları
+        void multiply_tables(uint8_t coefficient, uint8_t* tables);
+    }
+
+    // Uygulama seviyesi FEC. Gönderilen ardışık media_count medya datagramı (parçalar ve
+    // birleştirilmiş paketler dahil, kablodaki halleriyle) bir grup oluşturur; grup
+    // tamamlanınca parity_count parite paketi gönderilir. Gruptan herhangi parity_count
+    // datagram (medya veya parite) kaybolsa da kalanlardan hepsi geri kurulur: Opus'un
+    // in-band FEC'inin aksine ardışık kayıplara (Wi-Fi patlamaları) da dayanır.
+    //
+    // Korunan sembol [datagram boyu (2)][datagram (başlık + payload)]'dır ve grubun en uzun
+    // sembolüne sıfırla tamamlanır. parity_count == 1'de parite sembollerin XOR'udur;
+    // daha fazlasında Reed–Solomon: parite j = Σ C[j][i] · sembol_i, C Cauchy matrisi
+    // (C[j][i] = 1 / ((MAX_MEDIA + j) ⊕ i); GF(256)'da toplama XOR'dur). Cauchy
+    // matrisinin her kare alt matrisi tersinir olduğundan eksik sayısı kadar parite her
+    // zaman yeterlidir.
+    //
+    // Parite paketi bir kontrol paketidir (ControlType::FecParity); sıra numarası grup
+    // sayacıdır, zaman damgası grubun ilk datagramınınki. Payload:
+    //   [media_count (1)][parity_index (1)][parity_count (1)][symbol_size (2)]
+    //   [base_sequence (4)] + media_count x [sıra numarası farkı (1)][fragment_index (1)]
+    //   + [parite sembolü (symbol_size)]
+    struct FecParityHeader {
+        static constexpr size_t MAX_MEDIA = 16;
+        static constexpr size_t MAX_PARITY = 4;
+        static constexpr size_t HEADER_SIZE = 9;
+        static constexpr size_t ENTRY_SIZE = 2;
+        static constexpr size_t LENGTH_SIZE = 2;   // Sembolün başındaki datagram boyu
+        static constexpr size_t MAX_SYMBOL_SIZE =
+            core::MAX_DATAGRAM_SIZE - core::PACKET_HEADER_SIZE - HEADER_SIZE - MAX_MEDIA * ENTRY_SIZE;
+
+        struct Member {
+            uint32_t sequence_number;
+            uint8_t fragment_index;
+        };
+
+        size_t media_count = 0;
+        size_t parity_index = 0;
+        size_t parity_count = 0;
+        size_t symbol_size = 0;
+        Member members[MAX_MEDIA];
+
+        size_t wire_size() const { return HEADER_SIZE + media_count * ENTRY_SIZE; }
+        // wire_size() byte yazar; sığmazsa 0 döndürür
+        size_t write(uint8_t* out, size_t capacity) const;
+        // Sembol, payload'ın wire_size()'dan sonraki symbol_size byte'ıdır
+        static bool parse(const uint8_t* data, size_t size, FecParityHeader& header);
+
+        // Parite satırı j'nin medya i için katsayısı
+        static uint8_t coefficient(size_t parity_index, size_t media_index, size_t parity_count);
+    };
+
+    // Gönderici tarafı: datagramlar eklendikçe parite sembolleri artımlı biriktirilir
+    // (medya kopyalanmaz). Grup frame sınırında kapanır: bir frame'in parçaları aynı
+    // gruba girer, bu yüzden grup media_count'u parça sayısı kadar aşabilir (en çok
+    // MAX_MEDIA; sığmayan parçalar korunmaz). Tek thread'den kullanılır.
+    class FecEncoder {
+    public:
+        FecEncoder();
+
+        // Bir sonraki gruptan itibaren geçerli olur; parity_count == 0 FEC'i kapatır.
+        // Aralık dışıysa false.
+        bool configure(size_t media_count, size_t parity_count);
+
+        // Gönderilecek medya datagramı
+        void add(const core::PacketView& packet);
+        // Frame'in tüm datagramları eklendikten sonra çağrılır. Grup dolduysa parite
+        // paketleri hazırlanır ve sayıları döner; görünümler bir sonraki add() çağrısına
+        // kadar geçerlidir.
+        size_t end_frame();
+        const core::PacketView* parity() const { return parity_views_.data(); }
+
+    private:
+        void start_group();
+
+        size_t media_count_ = 0;
+        size_t parity_count_ = 0;
+        size_t pending_media_ = 0;   // configure() ile istenen, bir sonraki grupta uygulanacak
+        size_t pending_parity_ = 0;
+
+        FecParityHeader group_;      // media_count: gruba şimdiye kadar eklenen datagramlar
+        uint32_t group_sequence_ = 0;
+        uint32_t group_timestamp_ = 0;
+        std::vector<uint8_t> parity_;  // MAX_PARITY x MAX_DATAGRAM_SIZE (başlık + sembol)
+        std::array<core::PacketView, FecParityHeader::MAX_PARITY> parity_views_;
+    };
+
+    struct FecStats {
+        uint64_t parity_received = 0;
+        uint64_t recovered = 0;      // Pariteden geri kurulan datagramlar
+        uint64_t unrecoverable = 0;  // Grubu parite yetmediği için eksik kalan datagramlar
+    };
+
+    // Alıcı tarafı: gelen medya datagramları MEDIA_HISTORY'lik bir halkaya kopyalanır,
+    // parite paketleri gruplarına göre GROUP_HISTORY'lik tabloda tutulur. Bir grubun eksik
+    // datagram sayısı gelen paritelerin sayısına inince (medya veya parite gelişiyle)
+    // eksikler çözülür: bilinen semboller paritelerden çıkarılır ve kalan sistem, eksik
+    // sütunların katsayı matrisinin tersiyle çarpılır. Tek thread'den kullanılır.
+    class FecDecoder {
+    public:
+        static constexpr size_t MEDIA_HISTORY = 4 * FecParityHeader::MAX_MEDIA;
+        static constexpr size_t GROUP_HISTORY = 8;
+
+        FecDecoder();
+
+        // Medya ve parite datagramları; kurtarılanlar 'recovered'a yazılır (görünümler bir
+        // sonraki çağrıya kadar geçerlidir) ve sayıları döner
+        size_t on_media(const core::PacketView& packet, core::PacketView* recovered, size_t max_recovered);
+        size_t on_parity(const core::PacketView& packet, core::PacketView* recovered, size_t max_recovered);
+
+        const FecStats& stats() const { return stats_; }
+        // Son parite grubunun sıra numarası aralığı (frame cinsinden; 0: henüz parite yok)
+        size_t group_frames() const { return group_frames_; }
+        void reset();
+
+    private:
+        struct Datagram {
+            bool valid = false;
+            uint32_t sequence_number = 0;
+            uint8_t fragment_index = 0;
+            size_t size = 0;  // Başlık dahil
+            std::array<uint8_t, core::MAX_DATAGRAM_SIZE> bytes;
+        };
+
+        struct Group {
+            bool active = false;
+            bool resolved = false;      // Eksik kalmadı (veya geri kuruldu)
+            uint32_t sequence_number = 0;
+            FecParityHeader header;     // İlk gelen paritenin başlığı (üyeler ve boyutlar)
+            unsigned parity_mask = 0;   // Gelen parite indeksleri
+            size_t missing = 0;         // Son denemede bulunamayan üyeler
+            std::vector<uint8_t> symbols;  // MAX_PARITY x MAX_SYMBOL_SIZE
+        };
+
+        void remember(const core::PacketView& packet);
+        void remember(const uint8_t* datagram, size_t size, uint32_t sequence_number, uint8_t fragment_index);
+        const Datagram* find(const FecParityHeader::Member& member) const;
+        void retire(Group& group);
+        size_t try_recover(Group& group, core::PacketView* recovered, size_t max_recovered);
+
+        std::vector<Datagram> history_;
+        size_t history_next_ = 0;
+        std::vector<Group> groups_;
+        size_t groups_next_ = 0;
+        std::vector<uint8_t> work_;  // 2 x MAX_PARITY x MAX_SYMBOL_SIZE: sendromlar ve çözülen semboller
+        size_t group_frames_ = 0;
+        FecStats stats_;
+    };
+}
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef VOICE_ENGINE_FEEDBACK_HPP
+#define VOICE_ENGINE_FEEDBACK_HPP
+
+#include "core/non_copyable.hpp"
+#include "core/packet.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace streaming {
+    // Kontrol paketlerinin türü (başlıkta fragment_index, bkz. packet.hpp)
+    enum class ControlType : uint8_t {
+        ReceiverReport = 1,
+        ArrivalFeedback = 2,
+        FecParity = 3       // Uygulama seviyesi FEC paritesi (bkz. fec.hpp)
+    };
+
+    // Alıcının göndericiye periyodik raporu (RTCP RR benzeri). Medya ile aynı soket
+    // çiftinden, ters yönde kontrol paketi olarak gider. Kayıplar 10 ms'lik frame
+    // cinsindendir (birleştirilmiş paket frame sayısı kadar, parçalı frame bir kez sayılır).
+    struct ReceiverReport {
+        static constexpr size_t WIRE_SIZE = 21;
+
+        uint32_t highest_sequence = 0;     // Alınan en yüksek frame sıra numarası
+        uint32_t cumulative_lost = 0;      // Akışın başından beri kayıp frame'ler
+        uint32_t jitter_us = 0;            // Jitter buffer'ın geliş zamanı jitter'ı
+        uint32_t receive_bitrate_bps = 0;  // Aralıkta alınan payload (codec) bit hızı
+        uint16_t interval_ms = 0;          // Raporun kapsadığı süre
+        uint16_t expected = 0;             // Aralıkta beklenen frame sayısı
+        uint8_t fraction_lost = 0;         // Aralıktaki kayıp oranı (Q8, 256 = %100)
+
+        double loss() const { return fraction_lost / 256.0; }
+        double jitter_ms() const { return jitter_us / 1000.0; }
+
+        // WIRE_SIZE byte yazar (big-endian); sığmazsa 0 döndürür
+        size_t write(uint8_t* out, size_t capacity) const;
+        static bool parse(const uint8_t* data, size_t size, ReceiverReport& report);
+    };
+
+    // Medya paketlerinin alıcıya (çekirdeğe) ulaşma zamanları; göndericinin gecikme
+    // tabanlı tıkanıklık kontrolü, bunları kendi gönderim zamanlarıyla karşılaştırır.
+    // Zamanlar alıcının saatindedir, sadece farkları anlamlıdır. Kablo formatı:
+    // [referans zamanı µs (8)][taban sıra numarası (4)][adet (1)], ardından geliş
+    // sırasıyla paket başına [sıra farkı, işaretli (2)][referanstan geçen süre, TIME_UNIT_US (2)].
+    // Referans ve taban ilk paketindir.
+    struct ArrivalFeedback {
+        static constexpr size_t MAX_PACKETS = 64;
+        static constexpr size_t HEADER_SIZE = 13;
+        static constexpr size_t ENTRY_SIZE = 4;
+        static constexpr size_t MAX_WIRE_SIZE = HEADER_SIZE + MAX_PACKETS * ENTRY_SIZE;
+        static constexpr int64_t TIME_UNIT_US = 250;
+
+        struct Entry {
+            uint32_t sequence_number;
+            int64_t arrival_us;  // Kablodan okunurken TIME_UNIT_US'e yuvarlanmıştır
+        };
+
+        Entry packets[MAX_PACKETS];
+        size_t count = 0;
+
+        // Dolu ise veya paket ilkine göre formatın aralığı dışındaysa false; çağıran
+        // raporu gönderip yeni bir raporla devam eder
+        bool add(uint32_t sequence_number, int64_t arrival_us);
+        void clear() { count = 0; }
+        size_t wire_size() const { return HEADER_SIZE + count * ENTRY_SIZE; }
+
+        // wire_size() byte yazar (big-endian); sığmazsa 0 döndürür
+        size_t write(uint8_t* out, size_t capacity) const;
+        static bool parse(const uint8_t* data, size_t size, ArrivalFeedback& feedback);
+    };
+
+    // Gelen medya frame'lerinden alıcı raporu üretir; kayıp, RFC 3550 A.3'teki gibi
+    // beklenen (en yüksek - ilk sıra numarası) ile alınan frame farkıdır, tekrarlar ve
+    // sıra dışı gelişler aralık kaybını negatif yapabilir ve sıfıra çekilir.
+    //
+    // on_frames() ağ thread'inden, report() tek bir başka thread'den (raporu gönderen)
+    // çağrılır. Sayaçlar tek yazıcılı atomiklerdir, kilit yoktur.
+    class ReceptionMonitor : private core::NonCopyable {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        // sequence_number'dan başlayan 'frames' frame'lik paket alındı. Parçalı frame'in
+        // sadece bir parçası frames = 1 ile (diğerleri 0 ile) bildirilmelidir.
+        void on_frames(uint32_t sequence_number, size_t frames, size_t payload_bytes);
+
+        // Son rapordan bu yana geçen aralığın raporu. İlk çağrı sadece başlangıç
+        // noktasını kaydeder; henüz frame alınmadıysa da false döner.
+        bool report(Clock::time_point now, double jitter_ms, ReceiverReport& out);
+
+    private:
+        // Ağ thread'i
+        std::atomic<bool> started_{false};
+        uint64_t base_sequence_ = 0;              // started_ yayınlanmadan önce yazılır
+        std::atomic<uint64_t> highest_sequence_{0}; // 32-bit taşmalar sayılarak genişletilmiş
+        std::atomic<uint64_t> received_{0};
+        std::atomic<uint64_t> received_bytes_{0};
+
+        // Rapor thread'i
+        bool has_prior_ = false;
+        Clock::time_point prior_time_{};
+        uint64_t prior_expected_ = 0;
+        uint64_t prior_received_ = 0;
+        uint64_t prior_bytes_ = 0;
+    };
+}
+
+#endif
@@ -2,37 +2,126 @@
 #define VOICE_ENGINE_SLICER_HPP
 
 #include "core/packet.hpp"
+#include "streaming/fec.hpp"
 #include <vector>
 #include <cstdint>
 #include <atomic>
 #include <algorithm> // For std::min
 
 namespace streaming {
+    // Kodlanmış bir frame'i datagramlara böler. Frame tek bir sıra numarası alır; parçalar
+    // bu numarayı, kendi indekslerini, parça sayısını ve frame boyunu taşır (bkz. packet.hpp).
+    // Parçalar max_slice_size'ı aşmayacak en eşit boyda kesilir: son parça dışındakilerin
+    // boyu fragment_stride() olur, alıcı parçayı hangi sırayla gelirse gelsin yerine koyar.
+    // Birden fazla codec frame'i taşıyan paket (ör. 60 ms'lik Opus paketi) frame_count kadar
+    // sıra numarası tüketir; alıcı paketi böldüğünde frame i, sequence_number + i alır.
+    // set_fec ile üretilen datagramlar FEC gruplarına alınır; tamamlanan grubun parite
+    // paketleri parity() ile alınıp medyanın ardından gönderilir.
     class Slicer {
     public:
-        Slicer() : sequence_number_(0) {}
+        Slicer() : sequence_number_(0), fec_config_(0) {}
 
-        std::vector<core::Packet> slice(const std::vector<uint8_t>& data, size_t max_slice_size) {
-            std::vector<core::Packet> packets;
-            if (data.empty()) {
-                return packets;
+        // Uygulama seviyesi FEC (bkz. fec.hpp): her media_packets datagramlık gruba
+        // parity_packets parite paketi eklenir (0: kapalı, varsayılan). Herhangi bir
+        // thread'den çağrılabilir; bir sonraki gruptan itibaren geçerlidir. Aralık dışıysa false.
+        bool set_fec(size_t media_packets, size_t parity_packets) {
+            if (parity_packets > FecParityHeader::MAX_PARITY ||
+                (parity_packets > 0 && (media_packets == 0 || media_packets > FecParityHeader::MAX_MEDIA))) {
+                return false;
             }
+            fec_config_.store(static_cast<uint32_t>(media_packets << 8 | parity_packets));
+            return true;
+        }
 
-            for (size_t i = 0; i < data.size(); i += max_slice_size) {
-                core::Packet packet;
-                packet.sequence_number = sequence_number_++;
+        // Son slice() çağrısıyla tamamlanan grubun parite paketleri; görünümler bir sonraki
+        // slice() çağrısına kadar geçerlidir
+        size_t parity(core::PacketView* out, size_t max_packets) const {
+            const size_t count = std::min(parity_count_, max_packets);
+            std::copy(fec_.parity(), fec_.parity() + count, out);
+            return count;
+        }
 
-                auto start = data.begin() + i;
-                auto end = start + std::min(max_slice_size, data.size() - i);
-                packet.data.assign(start, end);
+        // timestamp: kodlanmış frame'in ilk sample'ının zamanı; tüm parçalara yazılır
+        std::vector<core::Packet> slice(const std::vector<uint8_t>& data, size_t max_slice_size, uint32_t timestamp = 0) {
+            return slice(data.data(), data.size(), max_slice_size, timestamp);
+        }
 
-                packets.push_back(packet);
+        std::vector<core::Packet> slice(const uint8_t* data, size_t size, size_t max_slice_size, uint32_t timestamp = 0) {
+            std::vector<core::Packet> packets;
+            const size_t count = fragment_count(data, size, max_slice_size);
+            parity_count_ = 0;
+            if (count == 0) {
+                return packets;
+            }
+
+            packets.resize(count);
+            core::PacketView views[core::MAX_FRAGMENTS];
+            slice_into(data, size, count, timestamp, views);
+            for (size_t i = 0; i < count; ++i) {
+                packets[i].sequence_number = views[i].sequence_number;
+                packets[i].timestamp = views[i].timestamp;
+                packets[i].fragment_index = views[i].fragment_index;
+                packets[i].fragment_count = views[i].fragment_count;
+                packets[i].frame_size = views[i].frame_size;
+                packets[i].data.assign(views[i].data, views[i].data + views[i].size);
             }
             return packets;
         }
 
+        // Allocation'sız sürüm: parçaların görünümlerini 'out'a yazar, payload kopyalanmaz
+        // (görünümler 'data' yaşadığı sürece geçerlidir). Parça sayısını, max_packets'a
+        // sığmazsa 0 döndürür.
+        size_t slice(const uint8_t* data, size_t size, size_t max_slice_size, uint32_t timestamp,
+                     core::PacketView* out, size_t max_packets, uint32_t frame_count = 1) {
+            const size_t count = fragment_count(data, size, max_slice_size);
+            parity_count_ = 0;
+            if (count == 0 || frame_count == 0 || count > max_packets) {
+                return 0;
+            }
+            slice_into(data, size, count, timestamp, out, frame_count);
+            return count;
+        }
+
     private:
+        static size_t fragment_count(const uint8_t* data, size_t size, size_t max_slice_size) {
+            if (!data || size == 0 || max_slice_size == 0 || size > UINT16_MAX) {
+                return 0;
+            }
+            const size_t count = (size + max_slice_size - 1) / max_slice_size;
+            return count <= core::MAX_FRAGMENTS ? count : 0;
+        }
+
+        void slice_into(const uint8_t* data, size_t size, size_t count, uint32_t timestamp, core::PacketView* out,
+                        uint32_t frame_count = 1) {
+            const uint32_t sequence_number = sequence_number_.fetch_add(frame_count);
+            const size_t stride = core::fragment_stride(size, count);
+            for (size_t i = 0; i < count; ++i) {
+                const size_t offset = i * stride;
+                out[i].sequence_number = sequence_number;
+                out[i].timestamp = timestamp;
+                out[i].fragment_index = static_cast<uint8_t>(i);
+                out[i].fragment_count = static_cast<uint8_t>(count);
+                out[i].frame_size = static_cast<uint16_t>(size);
+                out[i].data = data + offset;
+                out[i].size = std::min(stride, size - offset);
+            }
+
+            const uint32_t fec_config = fec_config_.load(std::memory_order_relaxed);
+            if (fec_config != applied_fec_config_) {
+                fec_.configure(fec_config >> 8, fec_config & 0xFF);
+                applied_fec_config_ = fec_config;
+            }
+            for (size_t i = 0; i < count; ++i) {
+                fec_.add(out[i]);
+            }
+            parity_count_ = fec_.end_frame();
+        }
+
         std::atomic<uint32_t> sequence_number_;
+        std::atomic<uint32_t> fec_config_;   // media_packets << 8 | parity_packets
+        uint32_t applied_fec_config_ = 0;
+        FecEncoder fec_;
+        size_t parity_count_ = 0;
     };
 }
 
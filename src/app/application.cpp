@@ -1,26 +1,110 @@
 #include "app/application.hpp"
+#include "core/rt_alloc_guard.hpp"
 #include <iostream>
 #include <vector>
 #include <numeric>
 #include <cstring>
+#include <cstdio>
 #include <thread>
 #include <chrono>
+#include <cmath>
+#include <algorithm>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 namespace app {
 
-Application::Application() {
+namespace {
+    // Playback buffer'ında tutulacak maksimum ses (1 saniye). Normalde ring'de sadece
+    // PLAYOUT_HANDOFF_FRAMES kadar ses bulunur; bu sınır bir güvenlik ağıdır.
+    constexpr size_t MAX_PLAYBACK_SAMPLES =
+        audio::AudioManager::SAMPLE_RATE * audio::AudioManager::NUM_CHANNELS;
+
+    // Threaded modda capture thread'inin callback'in önünde tuttuğu çözülmüş ses.
+    // Callback her çağrıda bir frame tüketir, capture thread bir sonraki frame'de
+    // tamamlar; ikinci frame thread zamanlama sapmalarını karşılar.
+    constexpr size_t PLAYOUT_HANDOFF_FRAMES = 2;
+
+    // Tahmin edilen gecikmenin bu kadar öncesinden (2 ms) itibaren filtre tap'leri
+    // başlar; seyreltme çözünürlüğü ve oda yanıtının ana tepeden önceki kısmı için
+    constexpr size_t ECHO_DELAY_MARGIN_SAMPLES = 96;
+
+    // Tahmin gelene kadar kullanılan hizalama: mikrofon bir önceki callback'in
+    // hoparlör verisiyle eşleşir
+    constexpr size_t DEFAULT_ECHO_DELAY_SAMPLES = audio::AudioManager::FRAMES_PER_BUFFER * audio::AudioManager::NUM_CHANNELS;
+
+    constexpr int FRAME_MS = 1000 * audio::AudioManager::FRAMES_PER_BUFFER / audio::AudioManager::SAMPLE_RATE;
+    constexpr auto FRAME_DURATION = std::chrono::microseconds(
+        1000000LL * audio::AudioManager::FRAMES_PER_BUFFER / audio::AudioManager::SAMPLE_RATE);
+
+    // Encoder'ı süren thread bir frame gecikirse biriken raporlar (fazlası atılır)
+    constexpr size_t FEEDBACK_QUEUE_REPORTS = 8;
+
+    // İki geri bildirim arasında alınabilecek paketler (ör. 50 ms'de parçalı frame'ler)
+    constexpr size_t ARRIVAL_QUEUE_PACKETS = 256;
+
+    // Gecikme tabanlı hedeften düşülen paket başına yük
+    constexpr size_t PACKET_OVERHEAD_BYTES = network::DelayBasedController::IP_UDP_HEADER_BYTES + core::PACKET_HEADER_SIZE;
+
+    int64_t to_us(std::chrono::steady_clock::time_point time) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+    }
+}
+
+Application::Application(const ApplicationOptions& options)
+    : options_(options),
+      capture_buffer_(FRAME_SAMPLES, 0),
+      encode_buffer_(codec::OpusCodec::MAX_PACKET_BYTES),
+      packet_buffer_(MAX_SLICE_SIZE),
+      capture_queue_(options.capture_queue_frames),
+      comfort_noise_interval_frames_(static_cast<uint64_t>(std::max(1,
+          options.comfort_noise_interval_ms * audio::AudioManager::SAMPLE_RATE / 1000 / audio::AudioManager::FRAMES_PER_BUFFER))),
+      feedback_queue_(FEEDBACK_QUEUE_REPORTS),
+      feedback_interval_frames_(static_cast<uint64_t>(std::max(1, options.feedback_interval_ms / FRAME_MS))),
+      arrival_queue_(ARRIVAL_QUEUE_PACKETS),
+      arrival_feedback_interval_frames_(static_cast<uint64_t>(std::max(1, options.arrival_feedback_interval_ms / FRAME_MS))),
+      playback_buffer_(MAX_PLAYBACK_SAMPLES) {
     try {
         audio_manager_    = std::make_unique<audio::AudioManager>();
         codec_            = std::make_unique<codec::OpusCodec>();
+        decode_buffer_.resize(codec_->max_decoded_samples());
+        packetizer_       = std::make_unique<codec::OpusPacketizer>(MAX_SLICE_SIZE);
+        if (!set_packet_duration_ms(options_.packet_duration_ms)) {
+            std::cerr << "UYARI: Geçersiz paket süresi " << options_.packet_duration_ms
+                      << " ms, " << FRAME_MS << " ms kullanılıyor" << std::endl;
+        }
         slicer_           = std::make_unique<streaming::Slicer>();
-        sender_           = std::make_unique<network::UdpSender>();
-        receiver_         = std::make_unique<network::UdpReceiver>();
-        collector_        = std::make_unique<streaming::Collector>();
-        echo_canceller_   = std::make_unique<processing::EchoCanceller>(512, 0.1f); // Daha küçük filtre
+        if (!set_fec(options_.fec_media_packets, options_.fec_parity_packets)) {
+            std::cerr << "UYARI: Geçersiz FEC grubu " << options_.fec_media_packets << "+"
+                      << options_.fec_parity_packets << ", FEC kapalı" << std::endl;
+        }
+        network::UdpSender::CongestionOptions congestion;
+        congestion.enabled = options_.congestion_control;
+        congestion.rate = options_.congestion_rate;
+        sender_           = std::make_unique<network::UdpSender>(
+            network::UdpSender::DEFAULT_BATCH_SIZE, options_.io_backend, congestion);
+        packet_pool_      = std::make_unique<core::BufferPool>(PACKET_POOL_BUFFERS, core::MAX_DATAGRAM_SIZE);
+        receiver_         = std::make_unique<network::UdpReceiver>(
+            network::UdpReceiver::DEFAULT_BATCH_SIZE, packet_pool_.get(), nullptr, options_.io_backend);
+        collector_        = std::make_unique<streaming::Collector>(
+            audio::AudioManager::SAMPLE_RATE, FRAME_SAMPLES);
+        bitrate_controller_ = std::make_unique<streaming::BitrateController>(options_.bitrate_control);
+        apply_encoder_settings(options_.adaptive_bitrate ? bitrate_controller_->settings() : streaming::EncoderSettings());
+        echo_canceller_   = std::make_unique<processing::EchoCanceller>(
+            options_.echo_filter_length, options_.echo_step_size, options_.echo_engine);
+        echo_canceller_->set_bulk_delay(DEFAULT_ECHO_DELAY_SAMPLES);
         noise_suppressor_ = std::make_unique<processing::NoiseSuppressor>(256, -15.0f); // Daha az agresif
-
-        // Playback buffer'ı başlangıçta sessizlik ile doldur
-        playback_buffer_.resize(audio::AudioManager::FRAMES_PER_BUFFER * 10, 0);
+        if (options_.voice_activity_detection) {
+            voice_detector_ = std::make_unique<processing::VoiceActivityDetector>(
+                audio::AudioManager::SAMPLE_RATE, FRAME_SAMPLES);
+        }
+        if (options_.echo_delay_estimation) {
+            delay_estimator_ = std::make_unique<processing::DelayEstimator>(
+                audio::AudioManager::SAMPLE_RATE, options_.max_echo_delay_ms);
+        }
 
         std::cout << "Tüm bileşenler başarıyla oluşturuldu." << std::endl;
     } catch (const std::exception& e) {
@@ -34,6 +118,7 @@ Application::~Application() {
     if (audio_manager_) {
         audio_manager_->stop();
     }
+    stop_capture_thread();
     if (receiver_) {
         receiver_->stop();
     }
@@ -43,8 +128,8 @@ void Application::run(const std::string& target_ip, int send_port, int listen_po
     std::cout << "Bağlantı kuruluyor..." << std::endl;
 
     // Önce receiver'ı başlat
-    auto packet_callback = [this](core::Packet packet) {
-        this->on_packet_received(std::move(packet));
+    auto packet_callback = [this](const core::PooledPacket& packet) {
+        this->on_packet_received(packet);
     };
 
     if (!receiver_->start(listen_port, packet_callback)) {
@@ -65,16 +150,22 @@ void Application::run(const std::string& target_ip, int send_port, int listen_po
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
 
     // Audio callback'lerini ayarla
-    auto input_callback = [this](const std::vector<int16_t>& data) {
-        this->on_audio_input(data);
+    auto input_callback = [this](const int16_t* data, size_t frame_count) {
+        this->on_audio_input(data, frame_count);
     };
-    auto output_callback = [this](std::vector<int16_t>& data) {
-        this->on_audio_output(data);
+    auto output_callback = [this](int16_t* data, size_t frame_count) {
+        this->on_audio_output(data, frame_count);
     };
 
+    // Capture thread'ini ses akışından önce başlat
+    if (options_.threaded_capture) {
+        start_capture_thread();
+    }
+
     // Audio manager'ı başlat
     if (!audio_manager_->start(input_callback, output_callback)) {
         std::cerr << "HATA: AudioManager başlatılamadı." << std::endl;
+        stop_capture_thread();
         receiver_->stop();
         return;
     }
@@ -87,64 +178,127 @@ void Application::run(const std::string& target_ip, int send_port, int listen_po
               << audio::AudioManager::NUM_CHANNELS << " kanal" << std::endl;
     std::cout << "⏱️  Frame boyutu: " << audio::AudioManager::FRAMES_PER_BUFFER << " sample (10ms)" << std::endl;
     std::cout << "\n>>> Konuşmaya başlayabilirsiniz! <<<" << std::endl;
+    std::cout << ">>> Paket süresi için 'p <ms>' (" << FRAME_MS << "-"
+              << FRAME_MS * codec::OpusPacketizer::MAX_FRAMES << ") yazın <<<" << std::endl;
+    std::cout << ">>> FEC için 'f <medya> <parite>' (1-" << streaming::FecParityHeader::MAX_MEDIA << ", 0-"
+              << streaming::FecParityHeader::MAX_PARITY << ") yazın <<<" << std::endl;
     std::cout << ">>> Durdurmak için Enter'a basın <<<\n" << std::endl;
 
-    std::cin.get();
+    std::string line;
+    while (std::getline(std::cin, line) && !line.empty()) {
+        int duration_ms = 0;
+        int media_packets = 0;
+        int parity_packets = 0;
+        if (std::sscanf(line.c_str(), "p %d", &duration_ms) == 1 && set_packet_duration_ms(duration_ms)) {
+            std::cout << "📦 Paket süresi: " << duration_ms << " ms" << std::endl;
+        } else if (std::sscanf(line.c_str(), "f %d %d", &media_packets, &parity_packets) == 2 &&
+                   set_fec(media_packets, parity_packets)) {
+            std::cout << "🛡️ FEC: " << media_packets << " medya + " << parity_packets << " parite paketi" << std::endl;
+        } else {
+            std::cout << "Geçersiz komut: '" << line << "'" << std::endl;
+        }
+    }
 
     std::cout << "\nSistem kapatılıyor..." << std::endl;
     audio_manager_->stop();
+    stop_capture_thread();
     receiver_->stop();
     std::cout << "✓ Tüm bileşenler güvenli şekilde kapatıldı." << std::endl;
 }
 
 // Mikrofondan ses geldiğinde bu fonksiyon tetiklenir
-void Application::on_audio_input(const std::vector<int16_t>& input_data) {
-    if (input_data.empty()) return;
+void Application::on_audio_input(const int16_t* input_data, size_t frame_count) {
+    const size_t sample_count = frame_count * audio::AudioManager::NUM_CHANNELS;
+    if (sample_count == 0) return;
 
-    // Ses seviyesi kontrolü - çok sessiz sinyalleri görmezden gel
-    float rms = 0.0f;
-    for (const auto& sample : input_data) {
-        rms += static_cast<float>(sample * sample);
+    // Ses thread'inde yeniden boyutlandırma yapılamaz; beklenmeyen boyutlar reddedilir
+    if (sample_count != FRAME_SAMPLES) {
+        std::cerr << "UYARI: Beklenmeyen frame boyutu: " << sample_count << std::endl;
+        return;
     }
-    rms = std::sqrt(rms / input_data.size()) / 32768.0f;
 
-    // Debug: Ses seviyesini göster (çok sessiz değilse)
-    static int debug_counter = 0;
-    if (++debug_counter % 100 == 0 && rms > 0.01f) { // Her 1 saniyede bir
-        std::cout << "🎤 Mikrofon RMS: " << (rms * 100.0f) << "%" << std::endl;
+    // Ham frame saklanır: threaded modda hoparlör verisiyle birlikte on_audio_output'ta
+    // kuyruğa atılır, inline modda gecikme tahmini için kullanılır
+    std::copy(input_data, input_data + sample_count, pending_frame_.capture.begin());
+    pending_frame_.has_capture = true;
+    if (options_.threaded_capture) {
+        return;
     }
 
-    // Çok sessiz sesleri filtrelemek için threshold
-    if (rms < 0.005f) {
-        return; // Çok sessiz, gönderme
-    }
+    std::copy(input_data, input_data + sample_count, capture_buffer_.begin());
+    process_capture_frame(capture_buffer_.data(), capture_buffer_.size());
+}
 
-    std::vector<int16_t> processed_data = input_data;
+// Mikrofon frame'ini işler. Threaded modda capture thread'inde, aksi halde
+// PortAudio callback'inde çalışır.
+void Application::process_capture_frame(int16_t* samples, size_t sample_count) {
+    // Zaman damgası sessiz frame'lerde de ilerler; alıcı DTX boşluklarını buradan görür
+    const uint32_t timestamp = capture_timestamp_;
+    capture_timestamp_ += static_cast<uint32_t>(sample_count);
+
+    // Karşı tarafın raporları bu frame kodlanmadan uygulanır; kendi raporumuz medya ile
+    // aynı göndericiden (aynı thread'den) gider
+    apply_feedback();
+    if (++frames_since_feedback_ >= feedback_interval_frames_) {
+        frames_since_feedback_ = 0;
+        send_feedback();
+    }
+    if (++frames_since_arrival_feedback_ >= arrival_feedback_interval_frames_) {
+        frames_since_arrival_feedback_ = 0;
+        send_arrival_feedback();
+    }
 
-    // Echo cancellation - daha konservatif ayarlarla
+    // Echo cancellation. Sessiz frame'lerde de çalışır: her mikrofon örneği bir
+    // referans örneği tüketir, atlanırsa referans hizası kayar.
     try {
-        echo_canceller_->process(processed_data);
+        echo_canceller_->process(samples, sample_count);
     } catch (const std::exception& e) {
         std::cerr << "Echo canceller hatası: " << e.what() << std::endl;
     }
 
+    // Konuşma tespiti eko çıkarılmış sinyal üzerinde yapılır ki karşı tarafın sesi
+    // konuşma sanılmasın
+    const bool voiced = !voice_detector_ || voice_detector_->process(samples, sample_count);
+
+    // Debug: Ses seviyesini göster
+    static int debug_counter = 0;
+    if (voice_detector_ && ++debug_counter % 100 == 0 && voiced) { // Her 1 saniyede bir
+        core::ScopedAllocationAllowed allow_log;
+        std::cout << "🎤 Mikrofon: " << voice_detector_->level_db() << " dBFS (taban: "
+                  << voice_detector_->noise_floor_db() << " dBFS)" << std::endl;
+    }
+
+    if (!voiced) {
+        // Sessizlik: NS ve encode atlanır, aralıklarla comfort noise işareti gönderilir
+        silent_frames_.fetch_add(1, std::memory_order_relaxed);
+        if (frames_since_comfort_noise_++ % comfort_noise_interval_frames_ == 0) {
+            // Konuşmanın son frame'leri comfort noise işaretinden önce gider
+            flush_packet();
+            send_payload(encode_buffer_.data(),
+                         codec_->comfort_noise_frame(encode_buffer_.data(), encode_buffer_.size()), timestamp);
+            comfort_noise_sent_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return;
+    }
+    frames_since_comfort_noise_ = 0;
+
     // Noise suppression - daha hafif işlem
     try {
-        noise_suppressor_->process(processed_data);
+        noise_suppressor_->process(samples, sample_count);
     } catch (const std::exception& e) {
         std::cerr << "Noise suppressor hatası: " << e.what() << std::endl;
     }
 
-    // Opus ile kodla
-    std::vector<uint8_t> encoded_data;
+    // Opus ile önceden ayrılmış buffer'a kodla
+    size_t encoded_size = 0;
     try {
-        encoded_data = codec_->encode(processed_data);
+        encoded_size = codec_->encode(samples, sample_count, encode_buffer_.data(), encode_buffer_.size());
     } catch (const std::exception& e) {
         std::cerr << "Encoding hatası: " << e.what() << std::endl;
         return;
     }
 
-    if (encoded_data.empty()) {
+    if (encoded_size == 0) {
         std::cerr << "Encoding boş sonuç döndürdü!" << std::endl;
         return;
     }
@@ -152,125 +306,647 @@ void Application::on_audio_input(const std::vector<int16_t>& input_data) {
     // Debug: Kodlama başarısını göster
     static int encode_counter = 0;
     if (++encode_counter % 200 == 0) { // Her 2 saniyede bir
-        std::cout << "📦 Encoded: " << encoded_data.size() << " bytes" << std::endl;
+        core::ScopedAllocationAllowed allow_log;
+        std::cout << "📦 Encoded: " << encoded_size << " bytes" << std::endl;
     }
 
-    // Paketlere böl ve gönder
-    try {
-        auto packets = slicer_->slice(encoded_data, 1200);
-        if (!packets.empty()) {
-            sender_->send(packets);
-
-            // Debug: Gönderme başarısını göster
-            static int send_counter = 0;
-            if (++send_counter % 200 == 0) { // Her 2 saniyede bir
-                std::cout << "🚀 Gönderildi: " << packets.size() << " paket" << std::endl;
-            }
+    // Paket başına tek frame: birleştirme atlanır, frame kopyalanmadan gönderilir
+    if (packetizer_->frames_per_packet() == 1 && packetizer_->pending_frames() == 0) {
+        send_payload(encode_buffer_.data(), encoded_size, timestamp);
+        return;
+    }
+
+    // Birleştirilemeyen frame (farklı Opus modu veya dilim sınırı) önce bekleyenleri
+    // gönderir; tek başına da sığmıyorsa kendi paketinde gider
+    if (!packetizer_->add(encode_buffer_.data(), encoded_size, timestamp)) {
+        flush_packet();
+        if (!packetizer_->add(encode_buffer_.data(), encoded_size, timestamp)) {
+            send_payload(encode_buffer_.data(), encoded_size, timestamp);
+            return;
         }
-    } catch (const std::exception& e) {
-        std::cerr << "Packet gönderme hatası: " << e.what() << std::endl;
+    }
+    if (packetizer_->ready()) {
+        flush_packet();
+    }
+}
+
+void Application::flush_packet() {
+    const codec::OpusPacketizer::Packet packet = packetizer_->flush(packet_buffer_.data(), packet_buffer_.size());
+    if (packet.size > 0) {
+        send_payload(packet_buffer_.data(), packet.size, packet.timestamp, packet.frames);
+    }
+}
+
+bool Application::set_packet_duration_ms(int duration_ms) {
+    if (duration_ms < FRAME_MS || duration_ms % FRAME_MS != 0 ||
+        static_cast<size_t>(duration_ms / FRAME_MS) > codec::OpusPacketizer::MAX_FRAMES) {
+        return false;
+    }
+    packetizer_->set_frames_per_packet(static_cast<size_t>(duration_ms / FRAME_MS));
+    return true;
+}
+
+int Application::packet_duration_ms() const {
+    return static_cast<int>(packetizer_->frames_per_packet()) * FRAME_MS;
+}
+
+bool Application::set_fec(int media_packets, int parity_packets) {
+    if (media_packets < 0 || parity_packets < 0 ||
+        !slicer_->set_fec(static_cast<size_t>(media_packets), static_cast<size_t>(parity_packets))) {
+        return false;
+    }
+    fec_media_packets_.store(media_packets, std::memory_order_relaxed);
+    fec_parity_packets_.store(parity_packets, std::memory_order_relaxed);
+    return true;
+}
+
+void Application::send_feedback() {
+    streaming::ReceiverReport report;
+    if (!reception_monitor_.report(std::chrono::steady_clock::now(), collector_->stats().jitter_ms, report)) {
+        return;
+    }
+
+    std::array<uint8_t, streaming::ReceiverReport::WIRE_SIZE> payload;
+    send_control(streaming::ControlType::ReceiverReport, payload.data(), report.write(payload.data(), payload.size()));
+    reports_sent_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Application::send_arrival_feedback() {
+    // Geri bildirim dolarsa (veya formatın aralığını aşarsa) gönderilip yenisine geçilir
+    streaming::ArrivalFeedback feedback;
+    std::array<uint8_t, streaming::ArrivalFeedback::MAX_WIRE_SIZE> payload;
+    streaming::ArrivalFeedback::Entry arrival;
+    while (arrival_queue_.pop(&arrival, 1) == 1) {
+        if (!feedback.add(arrival.sequence_number, arrival.arrival_us)) {
+            send_control(streaming::ControlType::ArrivalFeedback, payload.data(), feedback.write(payload.data(), payload.size()));
+            feedback.clear();
+            feedback.add(arrival.sequence_number, arrival.arrival_us);
+        }
+    }
+    if (feedback.count > 0) {
+        send_control(streaming::ControlType::ArrivalFeedback, payload.data(), feedback.write(payload.data(), payload.size()));
+    }
+}
+
+void Application::send_control(streaming::ControlType type, const uint8_t* payload, size_t size) {
+    core::PacketView packet;
+    packet.sequence_number = feedback_sequence_++;
+    packet.fragment_index = static_cast<uint8_t>(type);
+    packet.fragment_count = 0;
+    packet.data = payload;
+    packet.size = size;
+    sender_->send(packet);
+}
+
+void Application::apply_feedback() {
+    streaming::ReceiverReport report;
+    bool received = false;
+    bool changed = false;
+    while (feedback_queue_.pop(&report, 1) == 1) {
+        received = true;
+        remote_fraction_lost_.store(report.fraction_lost, std::memory_order_relaxed);
+        remote_jitter_us_.store(report.jitter_us, std::memory_order_relaxed);
+        remote_receive_bps_.store(report.receive_bitrate_bps, std::memory_order_relaxed);
+        if (options_.adaptive_bitrate) {
+            changed = bitrate_controller_->on_report(report) || changed;
+        }
+    }
+    if (!options_.adaptive_bitrate) {
+        return;
+    }
+
+    // Gecikme tabanlı hedeften FEC paritelerinin payı ve paket başlıkları düşülür; kalan
+    // payload hızı kayıp tabanlı bitrate'in üst sınırıdır
+    if (sender_->congestion_control()) {
+        const int packets_per_second = 1000 / packet_duration_ms();
+        const int parity_packets = fec_parity_packets_.load(std::memory_order_relaxed);
+        const int media_packets = parity_packets > 0 ? fec_media_packets_.load(std::memory_order_relaxed) : 1;
+        const int media_target = static_cast<int>(static_cast<int64_t>(sender_->target_bitrate_bps()) *
+                                                  media_packets / (media_packets + parity_packets));
+        const int limit = std::max(1, media_target - static_cast<int>(PACKET_OVERHEAD_BYTES * 8) * packets_per_second);
+        if (limit != rate_limit_bps_) {
+            rate_limit_bps_ = limit;
+            changed = bitrate_controller_->set_rate_limit(limit) || changed;
+        }
+    }
+
+    // Karmaşıklık, raporlar arasındaki ortalama frame işleme süresine göre ayarlanır
+    // (sadece threaded modda ölçülür)
+    if (received) {
+        const uint64_t processed = frames_processed_.load(std::memory_order_relaxed);
+        const uint64_t process_ns = total_process_ns_.load(std::memory_order_relaxed);
+        if (processed > load_frames_processed_) {
+            const double frame_ns = std::chrono::duration<double, std::nano>(FRAME_DURATION).count();
+            const double load = (process_ns - load_process_ns_) / frame_ns / (processed - load_frames_processed_);
+            changed = bitrate_controller_->on_encode_load(load) || changed;
+        }
+        load_frames_processed_ = processed;
+        load_process_ns_ = process_ns;
+    }
+
+    if (changed) {
+        apply_encoder_settings(bitrate_controller_->settings());
+        const RateControlStats stats = rate_control_stats();
+        core::ScopedAllocationAllowed allow_log;
+        std::cout << "🎚️  Encoder: " << stats.encoder.bitrate_bps / 1000 << " kbps, beklenen kayıp %"
+                  << stats.encoder.packet_loss_percent << ", FEC " << (stats.encoder.inband_fec ? "açık" : "kapalı")
+                  << ", karmaşıklık " << stats.encoder.complexity << " (uzak kayıp %"
+                  << stats.remote_loss_percent << ", jitter " << stats.remote_jitter_ms << " ms, alım "
+                  << stats.remote_receive_kbps << " kbps, hedef " << stats.target_rate_kbps << " kbps, pacer "
+                  << stats.pacer_queue_delay_ms << " ms)" << std::endl;
+    }
+}
+
+void Application::apply_encoder_settings(const streaming::EncoderSettings& settings) {
+    const bool applied = codec_->set_bitrate(settings.bitrate_bps) &&
+                         codec_->set_packet_loss_percent(settings.packet_loss_percent) &&
+                         codec_->set_inband_fec(settings.inband_fec) &&
+                         codec_->set_complexity(settings.complexity);
+    if (!applied) {
+        std::cerr << "UYARI: Encoder ayarları uygulanamadı" << std::endl;
+    }
+    encoder_bitrate_bps_.store(settings.bitrate_bps, std::memory_order_relaxed);
+    encoder_loss_percent_.store(settings.packet_loss_percent, std::memory_order_relaxed);
+    encoder_fec_.store(settings.inband_fec, std::memory_order_relaxed);
+    encoder_complexity_.store(settings.complexity, std::memory_order_relaxed);
+}
+
+RateControlStats Application::rate_control_stats() const {
+    RateControlStats stats;
+    stats.encoder.bitrate_bps = encoder_bitrate_bps_.load(std::memory_order_relaxed);
+    stats.encoder.packet_loss_percent = encoder_loss_percent_.load(std::memory_order_relaxed);
+    stats.encoder.inband_fec = encoder_fec_.load(std::memory_order_relaxed);
+    stats.encoder.complexity = encoder_complexity_.load(std::memory_order_relaxed);
+    stats.remote_loss_percent = remote_fraction_lost_.load(std::memory_order_relaxed) * 100.0 / 256.0;
+    stats.remote_jitter_ms = remote_jitter_us_.load(std::memory_order_relaxed) / 1000.0;
+    stats.remote_receive_kbps = remote_receive_bps_.load(std::memory_order_relaxed) / 1000.0;
+    stats.reports_sent = reports_sent_.load(std::memory_order_relaxed);
+    stats.reports_received = reports_received_.load(std::memory_order_relaxed);
+    stats.target_rate_kbps = sender_->target_bitrate_bps() / 1000.0;
+    stats.pacer_queue_delay_ms = sender_->pacer_queue_delay_ms();
+    stats.pacer_dropped = sender_->pacer_dropped();
+    return stats;
+}
+
+// Kodlanmış frame'i paketlere böler ve gönderir. Birleştirilmiş paket frame_count
+// sıra numarası tüketir.
+void Application::send_payload(const uint8_t* payload, size_t size, uint32_t timestamp, size_t frame_count) {
+    // Paket başlıkları gönderim sırasında yazılır, payload kopyalanmadan iovec ile gider.
+    // Bu frame bir FEC grubunu tamamladıysa parite paketleri aynı batch'te ardından gider.
+    std::array<core::PacketView, MAX_PACKETS_PER_FRAME + streaming::FecParityHeader::MAX_PARITY> packets;
+    size_t count = slicer_->slice(payload, size, MAX_SLICE_SIZE, timestamp, packets.data(), MAX_PACKETS_PER_FRAME,
+                                  static_cast<uint32_t>(frame_count));
+    if (count == 0) {
+        std::cerr << "Packet gönderme hatası: frame dilimlenemedi (" << size << " byte)" << std::endl;
+        return;
+    }
+    count += slicer_->parity(packets.data() + count, packets.size() - count);
+    sender_->send(packets.data(), count);
+
+    // Debug: Gönderme başarısını göster
+    static int send_counter = 0;
+    if (++send_counter % 200 == 0) { // Her 2 saniyede bir
+        core::ScopedAllocationAllowed allow_log;
+        std::cout << "🚀 Gönderildi: " << count << " paket" << std::endl;
     }
 }
 
 // Hoparlöre ses gönderileceği zaman bu fonksiyon tetiklenir
-void Application::on_audio_output(std::vector<int16_t>& output_data) {
-    std::lock_guard<std::mutex> lock(playback_mutex_);
+void Application::on_audio_output(int16_t* output_data, size_t frame_count) {
+    const size_t samples_needed = frame_count * audio::AudioManager::NUM_CHANNELS;
 
-    const size_t samples_needed = output_data.size();
+    // Inline modda jitter buffer'dan çözme de burada yapılır
+    if (!options_.threaded_capture) {
+        run_playout(samples_needed);
+    }
+
+    // Buffer'ın çok büyümesini engelle (maksimum 1 saniye). En eski örnekler
+    // tüketici tarafında atılır, böylece üretici hiçbir zaman beklemez.
+    const size_t buffered = playback_buffer_.size();
+    if (buffered > MAX_PLAYBACK_SAMPLES) {
+        playback_buffer_.discard(buffered - MAX_PLAYBACK_SAMPLES);
+    }
 
     if (playback_buffer_.size() >= samples_needed) {
         // Yeterli veri var, kopyala
-        std::memcpy(output_data.data(), playback_buffer_.data(), samples_needed * sizeof(int16_t));
-        playback_buffer_.erase(playback_buffer_.begin(), playback_buffer_.begin() + samples_needed);
+        playback_buffer_.pop(output_data, samples_needed);
 
         // Debug: Çalma başarısını göster
         static int play_counter = 0;
         if (++play_counter % 200 == 0) { // Her 2 saniyede bir
+            core::ScopedAllocationAllowed allow_log;
             std::cout << "🔊 Çalınıyor, buffer: " << playback_buffer_.size() << " sample" << std::endl;
         }
     } else {
         // Yeterli veri yok - sessizlik gönder ama buffer'ı koru
-        std::fill(output_data.begin(), output_data.end(), 0);
+        std::fill(output_data, output_data + samples_needed, 0);
 
         static int silence_counter = 0;
         if (++silence_counter % 500 == 0) { // Her 5 saniyede bir
+            core::ScopedAllocationAllowed allow_log;
             std::cout << "🔇 Buffer yetersiz, sessizlik çalınıyor (buffer: "
                       << playback_buffer_.size() << " sample)" << std::endl;
         }
     }
 
+    if (options_.threaded_capture) {
+        // Mikrofon ve referans frame'ini birlikte capture thread'ine aktar. Mikrofon
+        // verisi olmasa da referans gönderilir ki eko hizalaması kaymasın.
+        if (samples_needed == FRAME_SAMPLES) {
+            std::copy(output_data, output_data + samples_needed, pending_frame_.reference.begin());
+            capture_queue_.push(&pending_frame_, 1);
+            pending_frame_.has_capture = false;
+
+            const size_t depth = capture_queue_.size();
+            if (depth > max_queue_depth_.load(std::memory_order_relaxed)) {
+                max_queue_depth_.store(depth, std::memory_order_relaxed);
+            }
+        }
+        return;
+    }
+
+    if (samples_needed == FRAME_SAMPLES) {
+        update_echo_delay(pending_frame_.has_capture ? pending_frame_.capture.data() : nullptr,
+                          output_data, samples_needed);
+    }
+    if (!pending_frame_.has_capture) {
+        echo_canceller_->skip_capture(samples_needed);
+    }
+    pending_frame_.has_capture = false;
+
     // Echo canceller için referans sinyali gönder
     try {
-        echo_canceller_->on_playback(output_data);
+        echo_canceller_->on_playback(output_data, samples_needed);
     } catch (const std::exception& e) {
         std::cerr << "Echo canceller playback hatası: " << e.what() << std::endl;
     }
 }
 
+// Threaded modda capture thread'inde, aksi halde PortAudio callback'inde çalışır
+void Application::update_echo_delay(const int16_t* capture, const int16_t* reference, size_t sample_count) {
+    if (!delay_estimator_ || !delay_estimator_->process(capture, reference, sample_count)) {
+        return;
+    }
+
+    // Inline modda mikrofon, aynı callback'in hoparlör verisinden önce işlenir; bir
+    // frame'den kısa hizalamalarda eksik referans sessizlik olarak görülür
+    const size_t delay = delay_estimator_->delay_samples();
+    const size_t bulk_delay = delay > ECHO_DELAY_MARGIN_SAMPLES ? delay - ECHO_DELAY_MARGIN_SAMPLES : 0;
+    echo_canceller_->set_bulk_delay(bulk_delay);
+
+    core::ScopedAllocationAllowed allow_log;
+    std::cout << "🔁 Eko gecikmesi: " << (delay * 1000.0 / audio::AudioManager::SAMPLE_RATE) << " ms"
+              << " (güven: " << delay_estimator_->confidence()
+              << ", hizalama: " << bulk_delay << " sample)" << std::endl;
+}
+
+void Application::start_capture_thread() {
+    if (capture_running_) {
+        return;
+    }
+    capture_running_ = true;
+    capture_thread_ = std::thread(&Application::capture_loop, this);
+
+#ifdef __linux__
+    if (options_.capture_cpu >= 0) {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(options_.capture_cpu, &cpu_set);
+        int rc = pthread_setaffinity_np(capture_thread_.native_handle(), sizeof(cpu_set), &cpu_set);
+        if (rc != 0) {
+            std::cerr << "UYARI: Capture thread'i CPU " << options_.capture_cpu
+                      << "'e sabitlenemedi (hata: " << rc << ")" << std::endl;
+        }
+    }
+#endif
+    std::cout << "✓ Capture thread'i başlatıldı" << std::endl;
+}
+
+void Application::stop_capture_thread() {
+    capture_running_ = false;
+    if (capture_thread_.joinable()) {
+        capture_thread_.join();
+    }
+}
+
+void Application::capture_loop() {
+    while (capture_running_) {
+        if (capture_queue_.pop(&worker_frame_, 1) == 0) {
+            // Callback'i bloklamamak için kuyruk bildirimsiz; kısa aralıklarla yoklanır
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+
+        // Frame'in işlenmesi (eko giderme, kodlama, gönderim, oynatma için çözme) ses
+        // callback'inden taşındı; allocation denetimi de onunla birlikte burada yapılır.
+        // Periyodik teşhis çıktıları ScopedAllocationAllowed ile muaftır.
+        core::ScopedRealtimeSection realtime_section;
+        const auto start = std::chrono::steady_clock::now();
+
+        // Eko giderici mikrofon ve referans akışlarını örnek sayaçlarıyla hizalar; referans
+        // önce eklenir ki bir frame'den kısa gecikmeler de karşılanabilsin.
+        update_echo_delay(worker_frame_.has_capture ? worker_frame_.capture.data() : nullptr,
+                          worker_frame_.reference.data(), worker_frame_.reference.size());
+        try {
+            echo_canceller_->on_playback(worker_frame_.reference.data(), worker_frame_.reference.size());
+        } catch (const std::exception& e) {
+            std::cerr << "Echo canceller playback hatası: " << e.what() << std::endl;
+        }
+        if (worker_frame_.has_capture) {
+            process_capture_frame(worker_frame_.capture.data(), worker_frame_.capture.size());
+        } else {
+            echo_canceller_->skip_capture(worker_frame_.capture.size());
+        }
+
+        // Callback bir frame tükettiği için jitter buffer'dan bir sonraki frame çözülür
+        run_playout(PLAYOUT_HANDOFF_FRAMES * FRAME_SAMPLES);
+
+        const uint64_t elapsed_ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        total_process_ns_.fetch_add(elapsed_ns, std::memory_order_relaxed);
+        if (elapsed_ns > max_process_ns_.load(std::memory_order_relaxed)) {
+            max_process_ns_.store(elapsed_ns, std::memory_order_relaxed);
+        }
+        const uint64_t processed = frames_processed_.fetch_add(1, std::memory_order_relaxed) + 1;
+
+        // Debug: Kuyruk durumunu göster
+        if (processed % 500 == 0) { // Her 5 saniyede bir
+            const auto stats = capture_stats();
+            core::ScopedAllocationAllowed allow_log;
+            std::cout << "⚙️  Capture kuyruğu: " << stats.queue_depth << "/" << stats.max_queue_depth
+                      << " frame, işleme: ort " << stats.avg_process_us << " µs, maks "
+                      << stats.max_process_us << " µs, atılan: " << stats.frames_dropped << std::endl;
+        }
+    }
+    std::cout << "Capture thread'i sonlandı." << std::endl;
+}
+
+CapturePipelineStats Application::capture_stats() const {
+    CapturePipelineStats stats;
+    stats.queue_depth = capture_queue_.size();
+    stats.max_queue_depth = max_queue_depth_.load(std::memory_order_relaxed);
+    stats.frames_processed = frames_processed_.load(std::memory_order_relaxed);
+    stats.frames_dropped = capture_queue_.overflow_count();
+    if (stats.frames_processed > 0) {
+        stats.avg_process_us = total_process_ns_.load(std::memory_order_relaxed) / 1000.0 / stats.frames_processed;
+    }
+    stats.max_process_us = max_process_ns_.load(std::memory_order_relaxed) / 1000.0;
+    stats.frames_silent = silent_frames_.load(std::memory_order_relaxed);
+    stats.comfort_noise_sent = comfort_noise_sent_.load(std::memory_order_relaxed);
+    return stats;
+}
+
 // Ağdan paket geldiğinde
-void Application::on_packet_received(core::Packet packet) {
-    // Debug: Paket alma başarısını göster
-    static int receive_counter = 0;
-    if (++receive_counter % 200 == 0) { // Her 2 saniyede bir
-        std::cout << "📨 Alındı: Seq=" << packet.sequence_number
-                  << ", Size=" << packet.data.size() << " bytes" << std::endl;
+void Application::on_packet_received(const core::PooledPacket& packet) {
+    // Kontrol paketleri jitter buffer'a girmez; raporlar encoder'ı süren thread'e, geliş
+    // zamanları sender'ın tıkanıklık kontrolüne aktarılır. Medya datagramları ve FEC
+    // pariteleri, eksik datagramları geri kurmak için jitter buffer'ın FEC'inden de geçer.
+    std::array<core::PacketView, streaming::FecParityHeader::MAX_PARITY> recovered;
+    size_t recovered_count = 0;
+    if (packet.view.control()) {
+        switch (static_cast<streaming::ControlType>(packet.view.fragment_index)) {
+            case streaming::ControlType::ReceiverReport: {
+                streaming::ReceiverReport report;
+                if (streaming::ReceiverReport::parse(packet.view.data, packet.view.size, report)) {
+                    feedback_queue_.push(&report, 1);
+                    reports_received_.store(reports_received_.load(std::memory_order_relaxed) + 1,
+                                            std::memory_order_relaxed);
+                }
+                break;
+            }
+            case streaming::ControlType::ArrivalFeedback: {
+                streaming::ArrivalFeedback feedback;
+                if (streaming::ArrivalFeedback::parse(packet.view.data, packet.view.size, feedback)) {
+                    std::array<network::PacketArrival, streaming::ArrivalFeedback::MAX_PACKETS> arrivals;
+                    for (size_t i = 0; i < feedback.count; ++i) {
+                        arrivals[i] = {feedback.packets[i].sequence_number, feedback.packets[i].arrival_us};
+                    }
+                    sender_->on_transport_feedback(arrivals.data(), feedback.count);
+                }
+                break;
+            }
+            case streaming::ControlType::FecParity:
+                recovered_count = collector_->recover(packet.view, recovered.data(), recovered.size());
+                break;
+        }
+    } else {
+        recovered_count = collector_->recover(packet.view, recovered.data(), recovered.size());
+        const streaming::Collector::InsertResult result = receive_media(packet, false);
+
+        const int64_t delay_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - packet.arrival).count();
+        const uint64_t delay = static_cast<uint64_t>(std::max<int64_t>(0, delay_ns));
+        total_receive_delay_ns_.store(total_receive_delay_ns_.load(std::memory_order_relaxed) + delay,
+                                      std::memory_order_relaxed);
+        if (delay > max_receive_delay_ns_.load(std::memory_order_relaxed)) {
+            max_receive_delay_ns_.store(delay, std::memory_order_relaxed);
+        }
+        packets_received_.store(packets_received_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        // Debug: Paket alma başarısını göster
+        static int receive_counter = 0;
+        if (++receive_counter % 200 == 0) { // Her 2 saniyede bir
+            std::cout << "📨 Alındı: Seq=" << packet.view.sequence_number
+                      << ", Size=" << packet.view.size << " bytes" << std::endl;
+        }
+        if (result == streaming::Collector::InsertResult::Invalid) {
+            std::cerr << "UYARI: Geçersiz paket atıldı (Seq=" << packet.view.sequence_number
+                      << ", Size=" << packet.view.size << ")" << std::endl;
+        }
     }
 
-    try {
-        auto collection_callback = [this](const std::vector<uint8_t>& data) {
-            this->on_audio_collected(data);
-        };
-        collector_->collect(packet, collection_callback);
-    } catch (const std::exception& e) {
-        std::cerr << "Packet collection hatası: " << e.what() << std::endl;
+    // Geri kurulan datagramlar ağdan gelmiş gibi işlenir (görünümler jitter buffer'ın FEC
+    // buffer'larını gösterir, eklenirken kopyalanır)
+    for (size_t i = 0; i < recovered_count; ++i) {
+        receive_media(core::PooledPacket{recovered[i], core::PooledBuffer(), packet.arrival}, true);
     }
 }
 
-// Paketler birleşip tam bir ses verisi olduğunda
-void Application::on_audio_collected(const std::vector<uint8_t>& encoded_data) {
-    if (encoded_data.empty()) {
-        return;
+streaming::Collector::InsertResult Application::receive_media(const core::PooledPacket& packet, bool recovered) {
+    // Frame'in son parçası (veya parçasız paket) karşı tarafın tıkanıklık kontrolüne bildirilir;
+    // gönderici sıra numarasıyla tüm parçaların gönderim zamanını ve boyunu eşler
+    if (!recovered && (!packet.view.fragmented() || packet.view.fragment_index + 1 == packet.view.fragment_count)) {
+        const streaming::ArrivalFeedback::Entry arrival{packet.view.sequence_number, to_us(packet.arrival)};
+        arrival_queue_.push(&arrival, 1);
+    }
+
+    // Jitter, çekirdeğin geliş zamanından hesaplanır; callback'e kadarki gecikme ayrı izlenir
+    const size_t frames = packet.view.fragmented()
+        ? 1 : codec::OpusPacketizer::frame_count(packet.view.data, packet.view.size);
+    // Comfort noise işaretleri (sadece TOC) her zaman tek frame'dir, paket süresini belirlemez
+    if (frames > 0 && packet.view.size > 1 && frames != received_packet_frames_) {
+        received_packet_frames_ = frames;
+        collector_->set_packet_frames(frames);
+    }
+
+    // Parçalı frame bir kez (ilk parçasıyla) sayılır; kayıp oranı frame cinsindendir. Raporlar
+    // FEC öncesi kaybı taşır (gönderen parite oranını ona göre seçer).
+    if (!recovered) {
+        const size_t received_frames = packet.view.fragmented()
+            ? (packet.view.fragment_index == 0 ? 1 : 0) : std::max<size_t>(1, frames);
+        reception_monitor_.on_frames(packet.view.sequence_number, received_frames, packet.view.size);
+    }
+
+    streaming::Collector::InsertResult result = streaming::Collector::InsertResult::Accepted;
+    if (frames > 1) {
+        // Çok frame'li paket frame'lerine bölünür: frame i, sequence_number + i ve
+        // timestamp + i frame ile eklenir (gönderen paket başına frame sayısı kadar
+        // sıra numarası tüketir). Geliş zamanı son frame'e hizalanır: frame i, tek başına
+        // gönderilseydi geleceği ana (N-1-i frame önce) çekilir; böylece paketleme
+        // beklemesi, kısa kalan son paket dahil, jitter veya tampon beklemesi sayılmaz.
+        codec::OpusPacketizer::split(packet.view.data, packet.view.size,
+                                     [&](size_t index, const uint8_t* data, size_t size) {
+            core::PacketView frame = packet.view;
+            frame.sequence_number += static_cast<uint32_t>(index);
+            frame.timestamp += static_cast<uint32_t>(index * FRAME_SAMPLES);
+            frame.frame_size = 0;
+            frame.data = data;
+            frame.size = size;
+            const auto frame_arrival = packet.arrival - FRAME_DURATION * static_cast<int>(frames - 1 - index);
+            const auto frame_result = recovered ? collector_->insert_recovered(frame, frame_arrival)
+                                                : collector_->insert(frame, frame_arrival);
+            if (frame_result == streaming::Collector::InsertResult::Invalid) {
+                result = frame_result;
+            }
+        });
+    } else if (recovered) {
+        result = collector_->insert_recovered(packet.view, packet.arrival);
+    } else {
+        result = collector_->insert(packet, packet.arrival);
     }
+    return result;
+}
 
-    // Debug: Toplama başarısını göster
-    static int collect_counter = 0;
-    if (++collect_counter % 200 == 0) { // Her 2 saniyede bir
-        std::cout << "🧩 Collected: " << encoded_data.size() << " bytes" << std::endl;
+void Application::run_playout(size_t target_samples) {
+    static const std::array<int16_t, FRAME_SAMPLES> silence{};
+    const auto now = std::chrono::steady_clock::now();
+
+    while (playback_buffer_.size() < target_samples) {
+        // Decoder, payload'ı doğrudan jitter buffer slotundan okur
+        bool decoded = false;
+        collector_->pop(now, [&](streaming::Collector::Playout status, const uint8_t* data, size_t size) {
+            switch (status) {
+                case streaming::Collector::Playout::Frame:
+                    decoded = decode_to_playback(data, size);
+                    playout_active_ = playout_active_ || decoded;
+                    break;
+                case streaming::Collector::Playout::Lost:
+                    // Önce bir sonraki paketin FEC verisi, yoksa PLC
+                    if (size > 0 && decode_to_playback(data, size, DecodeMode::Fec)) {
+                        frames_recovered_.fetch_add(1, std::memory_order_relaxed);
+                        decoded = true;
+                    } else if (decode_to_playback(nullptr, 0, DecodeMode::Conceal)) {
+                        frames_concealed_.fetch_add(1, std::memory_order_relaxed);
+                        decoded = true;
+                    }
+                    break;
+                case streaming::Collector::Playout::Empty:
+                    // Dolum veya DTX: decoder sönümlenen bir devam ya da comfort noise üretir
+                    decoded = playout_active_ && decode_to_playback(nullptr, 0, DecodeMode::Conceal);
+                    break;
+            }
+        });
+        if (decoded) {
+            continue;
+        }
+        // Akış henüz başlamadı veya çözme başarısız: bir frame sessizlik
+        if (playback_buffer_.push(silence.data(), silence.size()) == 0) {
+            break;
+        }
     }
 
-    // Opus ile decode et
-    std::vector<int16_t> decoded_data;
+    // Debug: Jitter buffer durumunu göster
+    static int playout_counter = 0;
+    if (++playout_counter % 500 == 0) { // Her 5 saniyede bir
+        const auto stats = playout_stats();
+        core::ScopedAllocationAllowed allow_log;
+        std::cout << "📶 Jitter buffer: derinlik " << stats.jitter.depth << " paket, jitter " << stats.jitter.jitter_ms
+                  << " ms, hedef " << stats.jitter.target_delay_ms << " ms, geç/kayıp/tekrar/atılan: "
+                  << stats.jitter.late << "/" << stats.jitter.lost << "/" << stats.jitter.duplicates << "/"
+                  << stats.jitter.discarded << ", boşalma: " << stats.jitter.underruns
+                  << ", birleştirilen/eksik: " << stats.jitter.reassembled << "/" << stats.jitter.incomplete
+                  << ", parite FEC kurulan/kurulamayan: " << stats.jitter.fec_recovered << "/"
+                  << stats.jitter.fec_unrecoverable
+                  << ", FEC/PLC: " << stats.frames_recovered << "/" << stats.frames_concealed
+                  << ", havuz: " << stats.packet_pool.in_use << "/" << stats.packet_pool.capacity
+                  << " (tepe " << stats.packet_pool.peak_in_use << ", boşalma " << stats.packet_pool.exhausted << ")"
+                  << ", alım gecikmesi: ort " << stats.avg_receive_delay_us << " µs, maks "
+                  << stats.max_receive_delay_us << " µs" << std::endl;
+    }
+}
+
+PlayoutStats Application::playout_stats() const {
+    PlayoutStats stats;
+    stats.jitter = collector_->stats();
+    stats.frames_recovered = frames_recovered_.load(std::memory_order_relaxed);
+    stats.frames_concealed = frames_concealed_.load(std::memory_order_relaxed);
+    stats.packet_pool = packet_pool_->stats();
+    const uint64_t received = packets_received_.load(std::memory_order_relaxed);
+    if (received > 0) {
+        stats.avg_receive_delay_us = total_receive_delay_ns_.load(std::memory_order_relaxed) / 1000.0 / received;
+    }
+    stats.max_receive_delay_us = max_receive_delay_ns_.load(std::memory_order_relaxed) / 1000.0;
+    return stats;
+}
+
+// Jitter buffer'dan çıkan paketi çözüp playback ring'ine yazar
+bool Application::decode_to_playback(const uint8_t* encoded_data, size_t size, DecodeMode mode) {
+    if (mode != DecodeMode::Conceal && size == 0) {
+        return false;
+    }
+
+    // Opus ile decode et. Playback ring'inde bir paketlik bitişik yer varsa doğrudan
+    // ring'e, yoksa (sarmalanma) ara buffer'a çözülüp kopyalanır.
+    size_t region_size = 0;
+    int16_t* region = playback_buffer_.write_region(region_size);
+    const bool direct = region_size >= decode_buffer_.size();
+    size_t decoded = 0;
     try {
-        decoded_data = codec_->decode(encoded_data);
+        int16_t* out = direct ? region : decode_buffer_.data();
+        const size_t max_samples = direct ? region_size : decode_buffer_.size();
+        switch (mode) {
+            case DecodeMode::Normal:
+                decoded = codec_->decode(encoded_data, size, out, max_samples);
+                break;
+            case DecodeMode::Fec:
+                // Kayıp süre bir frame (10 ms)
+                decoded = codec_->decode_fec(encoded_data, size, out, FRAME_SAMPLES);
+                break;
+            case DecodeMode::Conceal:
+                decoded = codec_->conceal(out, FRAME_SAMPLES);
+                break;
+        }
     } catch (const std::exception& e) {
         std::cerr << "Decoding hatası: " << e.what() << std::endl;
-        return;
+        return false;
     }
 
-    if (decoded_data.empty()) {
-        std::cerr << "Decoding boş sonuç döndürdü!" << std::endl;
-        return;
+    if (decoded == 0) {
+        if (mode == DecodeMode::Normal) {
+            std::cerr << "Decoding boş sonuç döndürdü!" << std::endl;
+        }
+        return false;
     }
 
     // Çalınmak üzere veriyi buffer'a ekle
-    {
-        std::lock_guard<std::mutex> lock(playback_mutex_);
-        playback_buffer_.insert(playback_buffer_.end(), decoded_data.begin(), decoded_data.end());
-
-        // Buffer'ın çok büyümesini engelle (maksimum 1 saniye)
-        const size_t max_buffer_size = audio::AudioManager::SAMPLE_RATE * audio::AudioManager::NUM_CHANNELS;
-        if (playback_buffer_.size() > max_buffer_size) {
-            playback_buffer_.erase(playback_buffer_.begin(),
-                                 playback_buffer_.begin() + (playback_buffer_.size() - max_buffer_size));
+    if (direct) {
+        playback_buffer_.commit_write(decoded);
+    } else {
+        const size_t written = playback_buffer_.push(decode_buffer_.data(), decoded);
+        if (written < decoded) {
+            std::cerr << "UYARI: Playback buffer dolu, " << (decoded - written)
+                      << " sample atıldı (toplam taşma: " << playback_buffer_.overflow_count() << ")" << std::endl;
         }
+    }
 
-        // Debug: Buffer durumunu göster
-        static int buffer_counter = 0;
-        if (++buffer_counter % 200 == 0) { // Her 2 saniyede bir
-            std::cout << "💾 Decoded: " << decoded_data.size()
-                      << ", Buffer total: " << playback_buffer_.size() << " samples" << std::endl;
-        }
+    // Debug: Buffer durumunu göster
+    static int buffer_counter = 0;
+    if (++buffer_counter % 200 == 0) { // Her 2 saniyede bir
+        core::ScopedAllocationAllowed allow_log;
+        std::cout << "💾 Decoded: " << decoded
+                  << ", Buffer total: " << playback_buffer_.size() << " samples" << std::endl;
     }
+    return true;
 }
 
 }
\ No newline at end of file
@@ -1,6 +1,6 @@
 #include "audio/audio_manager.hpp"
+#include "core/rt_alloc_guard.hpp"
 #include <iostream>
-#include <vector>
 #include <stdexcept>
 #include <cstring>
 
@@ -123,20 +123,20 @@ int AudioManager::pa_callback(const void* input, void* output, unsigned long fra
 }
 
 int AudioManager::process(const int16_t* input_buffer, int16_t* output_buffer, unsigned long frame_count) {
+    // Bu noktadan sonra ses thread'inde heap allocation yapılmamalı
+    core::ScopedRealtimeSection realtime_section;
+
     // 1. Gelen sesi (mikrofon) işlemesi için ana uygulamaya gönder
-    if (input_callback_) {
-        std::vector<int16_t> input_data(input_buffer, input_buffer + frame_count * NUM_CHANNELS);
-        input_callback_(input_data);
+    if (input_callback_ && input_buffer) {
+        input_callback_(input_buffer, frame_count);
     }
 
-    // 2. Hoparlöre gönderilecek sesi ana uygulamadan al
-    std::vector<int16_t> output_data(frame_count * NUM_CHANNELS, 0); // Varsayılan olarak sessizlik
+    // 2. Hoparlöre gönderilecek sesi ana uygulamadan doğrudan PortAudio buffer'ına yazdır
     if (output_callback_) {
-        output_callback_(output_data);
+        output_callback_(output_buffer, frame_count);
+    } else {
+        std::memset(output_buffer, 0, frame_count * NUM_CHANNELS * sizeof(int16_t)); // Sessizlik
     }
-    
-    // 3. Alınan sesi PortAudio'nun çıkış buffer'ına kopyala
-    std::memcpy(output_buffer, output_data.data(), output_data.size() * sizeof(int16_t));
 
     return paContinue;
 }
@@ -5,7 +5,9 @@
 
 namespace codec {
     OpusCodec::OpusCodec(int sample_rate, int channels)
-        : sample_rate_(sample_rate), channels_(channels), frame_size_(sample_rate / 100) { // 10ms frame
+        : sample_rate_(sample_rate), channels_(channels), frame_size_(sample_rate / 100), // 10ms frame
+          last_toc_(0x40), // SILK WB, 10 ms, mono (config 8); ilk paket kodlanana kadar
+          pad_buffer_(static_cast<size_t>(frame_size_ * channels_), 0) {
 
         int error;
 
@@ -30,6 +32,7 @@ namespace codec {
         opus_encoder_ctl(encoder_, OPUS_SET_SIGNAL(OPUS_SIGNAL_VOICE)); // Ses sinyali
         opus_encoder_ctl(encoder_, OPUS_SET_DTX(1));                  // Discontinuous transmission
         opus_encoder_ctl(encoder_, OPUS_SET_INBAND_FEC(1));          // Forward error correction
+        opus_encoder_ctl(encoder_, OPUS_SET_PACKET_LOSS_PERC(10));    // FEC sadece beklenen kayıp > 0 iken üretilir
 
         std::cout << "✓ Opus codec başarıyla başlatıldı ("
                   << sample_rate_ << " Hz, " << channels_ << " kanal, "
@@ -49,101 +52,167 @@ namespace codec {
     }
 
     std::vector<uint8_t> OpusCodec::encode(const std::vector<int16_t>& pcm_data) {
+        std::vector<uint8_t> compressed_data(MAX_PACKET_BYTES);
+        compressed_data.resize(encode(pcm_data.data(), pcm_data.size(),
+                                      compressed_data.data(), compressed_data.size()));
+        return compressed_data;
+    }
+
+    size_t OpusCodec::encode(const int16_t* pcm_data, size_t sample_count, uint8_t* out, size_t capacity) {
         if (!encoder_) {
             std::cerr << "HATA: Encoder mevcut değil!" << std::endl;
-            return {};
+            return 0;
         }
 
-        if (pcm_data.empty()) {
+        if (!pcm_data || sample_count == 0) {
             std::cerr << "HATA: Encode edilecek PCM verisi boş!" << std::endl;
-            return {};
+            return 0;
         }
 
         // Frame size kontrolü
-        const size_t expected_samples = frame_size_ * channels_;
-        if (pcm_data.size() != expected_samples) {
+        const size_t expected_samples = frame_samples();
+        const int16_t* frame = pcm_data;
+        if (sample_count != expected_samples) {
             std::cerr << "UYARI: PCM data boyutu beklenen boyutla eşleşmiyor. Beklenen: "
-                      << expected_samples << ", Gelen: " << pcm_data.size() << std::endl;
-
-            // Eğer veri çok küçükse, sıfırlarla doldur
-            if (pcm_data.size() < expected_samples) {
-                std::vector<int16_t> padded_data = pcm_data;
-                padded_data.resize(expected_samples, 0);
-                return encode(padded_data);  // Recursive call
-            } else {
-                // Eğer çok büyükse, kırp
-                std::vector<int16_t> trimmed_data(pcm_data.begin(), pcm_data.begin() + expected_samples);
-                return encode(trimmed_data);  // Recursive call
+                      << expected_samples << ", Gelen: " << sample_count << std::endl;
+
+            // Eğer veri çok küçükse, sıfırlarla doldur; çok büyükse ilk frame kodlanır
+            if (sample_count < expected_samples) {
+                std::copy(pcm_data, pcm_data + sample_count, pad_buffer_.begin());
+                std::fill(pad_buffer_.begin() + sample_count, pad_buffer_.end(), 0);
+                frame = pad_buffer_.data();
             }
         }
 
-        // Maksimum compressed data boyutu (Opus için güvenli)
-        std::vector<uint8_t> compressed_data(4000);
-
-        opus_int32 result = opus_encode(encoder_, pcm_data.data(), frame_size_,
-                                       compressed_data.data(), compressed_data.size());
+        opus_int32 result = opus_encode(encoder_, frame, frame_size_, out,
+                                        static_cast<opus_int32>(std::min(capacity, MAX_PACKET_BYTES)));
 
         if (result < 0) {
             std::cerr << "HATA: Opus encode hatası: " << opus_strerror(result) << std::endl;
-            return {};
+            return 0;
         }
 
         if (result == 0) {
             std::cerr << "UYARI: Opus encode sıfır byte döndürdü (DTX aktif olabilir)" << std::endl;
-            return {};
+            return 0;
         }
 
-        compressed_data.resize(result);
+        // Config ve stereo bitleri korunur, frame sayısı kodu 0'a (tek frame) çekilir
+        last_toc_ = static_cast<uint8_t>(out[0] & 0xFC);
 
         // Debug bilgisi (nadiren)
         static int encode_debug_counter = 0;
         if (++encode_debug_counter % 1000 == 0) {  // Her 10 saniyede bir
-            std::cout << "📊 Encode: " << pcm_data.size() << " → " << result << " bytes (sıkıştırma: "
-                      << (100.0f * result / (pcm_data.size() * sizeof(int16_t))) << "%)" << std::endl;
+            std::cout << "📊 Encode: " << expected_samples << " → " << result << " bytes (sıkıştırma: "
+                      << (100.0f * result / (expected_samples * sizeof(int16_t))) << "%)" << std::endl;
         }
 
-        return compressed_data;
+        return static_cast<size_t>(result);
+    }
+
+    bool OpusCodec::set_bitrate(int bits_per_second) {
+        return encoder_ && opus_encoder_ctl(encoder_, OPUS_SET_BITRATE(bits_per_second)) == OPUS_OK;
+    }
+
+    bool OpusCodec::set_packet_loss_percent(int percent) {
+        return encoder_ && opus_encoder_ctl(encoder_, OPUS_SET_PACKET_LOSS_PERC(percent)) == OPUS_OK;
+    }
+
+    bool OpusCodec::set_inband_fec(bool enabled) {
+        return encoder_ && opus_encoder_ctl(encoder_, OPUS_SET_INBAND_FEC(enabled ? 1 : 0)) == OPUS_OK;
+    }
+
+    bool OpusCodec::set_complexity(int complexity) {
+        return encoder_ && opus_encoder_ctl(encoder_, OPUS_SET_COMPLEXITY(complexity)) == OPUS_OK;
+    }
+
+    std::vector<uint8_t> OpusCodec::comfort_noise_frame() const {
+        return {last_toc_};
+    }
+
+    size_t OpusCodec::comfort_noise_frame(uint8_t* out, size_t capacity) const {
+        if (capacity == 0) {
+            return 0;
+        }
+        out[0] = last_toc_;
+        return 1;
     }
 
     std::vector<int16_t> OpusCodec::decode(const std::vector<uint8_t>& encoded_data) {
+        std::vector<int16_t> decoded_data(max_decoded_samples());
+        decoded_data.resize(decode(encoded_data.data(), encoded_data.size(),
+                                   decoded_data.data(), decoded_data.size()));
+        return decoded_data;
+    }
+
+    size_t OpusCodec::decode(const uint8_t* encoded_data, size_t size, int16_t* out, size_t max_samples) {
         if (!decoder_) {
             std::cerr << "HATA: Decoder mevcut değil!" << std::endl;
-            return {};
+            return 0;
         }
 
-        if (encoded_data.empty()) {
+        if (!encoded_data || size == 0) {
             std::cerr << "HATA: Decode edilecek data boş!" << std::endl;
-            return {};
+            return 0;
         }
 
-        // Decode buffer'ı oluştur (birkaç frame'lik alan bırak)
-        const size_t max_samples = frame_size_ * channels_ * 6;  // 60ms için alan
-        std::vector<int16_t> decoded_data(max_samples);
-
-        int decoded_samples = opus_decode(decoder_, encoded_data.data(), encoded_data.size(),
-                                         decoded_data.data(), frame_size_ * 6, 0);
+        // Opus, kanal başına sample sayısı cinsinden kapasite bekler
+        const int max_frame_size = static_cast<int>(max_samples / channels_);
+        int decoded_samples = opus_decode(decoder_, encoded_data, static_cast<opus_int32>(size),
+                                          out, max_frame_size, 0);
 
         if (decoded_samples < 0) {
             std::cerr << "HATA: Opus decode hatası: " << opus_strerror(decoded_samples) << std::endl;
-            return {};
+            return 0;
         }
 
         if (decoded_samples == 0) {
             std::cerr << "UYARI: Opus decode sıfır sample döndürdü!" << std::endl;
-            return {};
+            return 0;
         }
 
-        // Sonucu gerçek boyuta getir
-        const size_t total_samples = decoded_samples * channels_;
-        decoded_data.resize(total_samples);
+        const size_t total_samples = static_cast<size_t>(decoded_samples) * channels_;
 
         // Debug bilgisi (nadiren)
         static int decode_debug_counter = 0;
         if (++decode_debug_counter % 1000 == 0) {  // Her 10 saniyede bir
-            std::cout << "📊 Decode: " << encoded_data.size() << " bytes → " << total_samples
+            std::cout << "📊 Decode: " << size << " bytes → " << total_samples
                       << " samples (" << decoded_samples << " samples/channel)" << std::endl;
         }
 
-        return decoded_data;
+        return total_samples;
+    }
+
+    size_t OpusCodec::decode_fec(const uint8_t* next_packet, size_t size, int16_t* out, size_t sample_count) {
+        if (!decoder_ || !next_packet || size == 0) {
+            return 0;
+        }
+
+        // TOC config 0-15: SILK veya hybrid (LBRR taşıyabilir), 16-31: CELT-only
+        if ((next_packet[0] >> 3) >= 16) {
+            return 0;
+        }
+
+        const int decoded_samples = opus_decode(decoder_, next_packet, static_cast<opus_int32>(size), out,
+                                                static_cast<int>(sample_count / channels_), 1);
+        if (decoded_samples < 0) {
+            std::cerr << "HATA: Opus FEC decode hatası: " << opus_strerror(decoded_samples) << std::endl;
+            return 0;
+        }
+        return static_cast<size_t>(decoded_samples) * channels_;
+    }
+
+    size_t OpusCodec::conceal(int16_t* out, size_t sample_count) {
+        if (!decoder_) {
+            return 0;
+        }
+
+        const int decoded_samples = opus_decode(decoder_, nullptr, 0, out,
+                                                static_cast<int>(sample_count / channels_), 0);
+        if (decoded_samples < 0) {
+            std::cerr << "HATA: Opus PLC hatası: " << opus_strerror(decoded_samples) << std::endl;
+            return 0;
+        }
+        return static_cast<size_t>(decoded_samples) * channels_;
     }
-}
\ No newline at end of file
+}
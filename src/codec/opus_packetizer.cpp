@@ -0,0 +1,77 @@
+#include "codec/opus_packetizer.hpp"
+#include <iostream>
+#include <stdexcept>
+
+namespace codec {
+    OpusPacketizer::OpusPacketizer(size_t max_packet_bytes, size_t frames_per_packet)
+        : repacketizer_(opus_repacketizer_create()),
+          max_packet_bytes_(max_packet_bytes),
+          frames_per_packet_(1),
+          storage_(MAX_FRAMES * SLOT_BYTES) {
+        if (!repacketizer_) {
+            throw std::runtime_error("Opus repacketizer oluşturulamadı");
+        }
+        set_frames_per_packet(frames_per_packet);
+    }
+
+    OpusPacketizer::~OpusPacketizer() {
+        if (repacketizer_) {
+            opus_repacketizer_destroy(repacketizer_);
+            repacketizer_ = nullptr;
+        }
+    }
+
+    void OpusPacketizer::set_frames_per_packet(size_t frames) {
+        frames_per_packet_.store(std::clamp<size_t>(frames, 1, MAX_FRAMES), std::memory_order_relaxed);
+    }
+
+    bool OpusPacketizer::add(const uint8_t* frame, size_t size, uint32_t timestamp) {
+        if (!frame || size == 0 || size > SLOT_BYTES || pending_ >= MAX_FRAMES) {
+            return false;
+        }
+        if (pending_bytes_ + size + overhead(pending_ + 1) > max_packet_bytes_) {
+            return false;
+        }
+
+        if (pending_ == 0) {
+            opus_repacketizer_init(repacketizer_);
+            timestamp_ = timestamp;
+        }
+        uint8_t* stored = storage_.data() + pending_ * SLOT_BYTES;
+        std::copy(frame, frame + size, stored);
+        // Farklı TOC config'i (mod, bant genişliği, frame süresi) aynı pakete giremez
+        if (opus_repacketizer_cat(repacketizer_, stored, static_cast<opus_int32>(size)) != OPUS_OK) {
+            return false;
+        }
+        ++pending_;
+        pending_bytes_ += size;
+        return true;
+    }
+
+    OpusPacketizer::Packet OpusPacketizer::flush(uint8_t* out, size_t capacity) {
+        Packet packet;
+        if (pending_ == 0) {
+            return packet;
+        }
+
+        const opus_int32 result = opus_repacketizer_out(repacketizer_, out, static_cast<opus_int32>(capacity));
+        if (result < 0) {
+            std::cerr << "HATA: Opus repacketizer hatası: " << opus_strerror(result) << std::endl;
+        } else {
+            packet.size = static_cast<size_t>(result);
+            packet.frames = pending_;
+            packet.timestamp = timestamp_;
+        }
+        pending_ = 0;
+        pending_bytes_ = 0;
+        return packet;
+    }
+
+    size_t OpusPacketizer::frame_count(const uint8_t* packet, size_t size) {
+        if (!packet || size == 0) {
+            return 0;
+        }
+        const int count = opus_packet_get_nb_frames(packet, static_cast<opus_int32>(size));
+        return count > 0 ? static_cast<size_t>(count) : 0;
+    }
+}
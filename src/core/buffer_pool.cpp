@@ -0,0 +1,153 @@
+#include "core/buffer_pool.hpp"
+#include <stdexcept>
+
+namespace core {
+
+namespace {
+    uint64_t make_head(uint64_t tag, uint32_t index) {
+        return (tag << 32) | index;
+    }
+
+    uint32_t head_index(uint64_t head) {
+        return static_cast<uint32_t>(head);
+    }
+
+    uint64_t head_tag(uint64_t head) {
+        return head >> 32;
+    }
+}
+
+PooledBuffer::PooledBuffer(const PooledBuffer& other)
+    : pool_(other.pool_), index_(other.index_), size_(other.size_) {
+    if (pool_) {
+        pool_->add_reference(index_);
+    }
+}
+
+PooledBuffer::PooledBuffer(PooledBuffer&& other) noexcept
+    : pool_(other.pool_), index_(other.index_), size_(other.size_) {
+    other.pool_ = nullptr;
+    other.size_ = 0;
+}
+
+PooledBuffer& PooledBuffer::operator=(const PooledBuffer& other) {
+    if (this != &other) {
+        if (other.pool_) {
+            other.pool_->add_reference(other.index_);
+        }
+        reset();
+        pool_ = other.pool_;
+        index_ = other.index_;
+        size_ = other.size_;
+    }
+    return *this;
+}
+
+PooledBuffer& PooledBuffer::operator=(PooledBuffer&& other) noexcept {
+    if (this != &other) {
+        reset();
+        pool_ = other.pool_;
+        index_ = other.index_;
+        size_ = other.size_;
+        other.pool_ = nullptr;
+        other.size_ = 0;
+    }
+    return *this;
+}
+
+uint8_t* PooledBuffer::data() {
+    return pool_ ? pool_->buffer(index_) : nullptr;
+}
+
+const uint8_t* PooledBuffer::data() const {
+    return pool_ ? pool_->buffer(index_) : nullptr;
+}
+
+size_t PooledBuffer::capacity() const {
+    return pool_ ? pool_->buffer_size() : 0;
+}
+
+uint32_t PooledBuffer::use_count() const {
+    return pool_ ? pool_->nodes_[index_].references.load(std::memory_order_acquire) : 0;
+}
+
+void PooledBuffer::reset() {
+    if (pool_) {
+        pool_->release(index_);
+        pool_ = nullptr;
+    }
+    size_ = 0;
+}
+
+BufferPool::BufferPool(size_t buffer_count, size_t buffer_size)
+    : buffer_count_(buffer_count),
+      buffer_size_(buffer_size),
+      storage_(new uint8_t[buffer_count * buffer_size]),
+      nodes_(new Node[buffer_count]),
+      free_head_(make_head(0, EMPTY)) {
+    if (buffer_count == 0 || buffer_count >= EMPTY || buffer_size == 0) {
+        throw std::invalid_argument("BufferPool: gecersiz boyut");
+    }
+    // İlk acquire() 0 numaralı buffer'ı versin diye ters sırada eklenir
+    for (size_t i = buffer_count; i-- > 0;) {
+        nodes_[i].next.store(head_index(free_head_.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+        free_head_.store(make_head(0, static_cast<uint32_t>(i)), std::memory_order_relaxed);
+    }
+}
+
+PooledBuffer BufferPool::acquire() {
+    uint64_t head = free_head_.load(std::memory_order_acquire);
+    for (;;) {
+        const uint32_t index = head_index(head);
+        if (index == EMPTY) {
+            exhausted_.fetch_add(1, std::memory_order_relaxed);
+            return PooledBuffer();
+        }
+        // 'next' eskimiş olabilir (başka bir thread araya girdiyse); sürüm etiketi
+        // değiştiği için CAS başarısız olur ve yeniden denenir
+        const uint32_t next = nodes_[index].next.load(std::memory_order_relaxed);
+        if (free_head_.compare_exchange_weak(head, make_head(head_tag(head) + 1, next),
+                                             std::memory_order_acquire, std::memory_order_acquire)) {
+            nodes_[index].references.store(1, std::memory_order_relaxed);
+
+            const size_t in_use = in_use_.fetch_add(1, std::memory_order_relaxed) + 1;
+            size_t peak = peak_in_use_.load(std::memory_order_relaxed);
+            while (in_use > peak && !peak_in_use_.compare_exchange_weak(peak, in_use, std::memory_order_relaxed)) {
+            }
+            acquired_.fetch_add(1, std::memory_order_relaxed);
+            return PooledBuffer(this, index);
+        }
+    }
+}
+
+void BufferPool::add_reference(uint32_t index) {
+    nodes_[index].references.fetch_add(1, std::memory_order_relaxed);
+}
+
+void BufferPool::release(uint32_t index) {
+    // acq_rel: son sahibin yazdıkları, buffer'ı yeniden alan thread'e görünür olmalı
+    if (nodes_[index].references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        in_use_.fetch_sub(1, std::memory_order_relaxed);
+        push_free(index);
+    }
+}
+
+void BufferPool::push_free(uint32_t index) {
+    uint64_t head = free_head_.load(std::memory_order_relaxed);
+    do {
+        nodes_[index].next.store(head_index(head), std::memory_order_relaxed);
+    } while (!free_head_.compare_exchange_weak(head, make_head(head_tag(head) + 1, index),
+                                               std::memory_order_release, std::memory_order_relaxed));
+}
+
+BufferPoolStats BufferPool::stats() const {
+    BufferPoolStats stats;
+    stats.capacity = buffer_count_;
+    stats.in_use = in_use_.load(std::memory_order_relaxed);
+    stats.peak_in_use = peak_in_use_.load(std::memory_order_relaxed);
+    stats.acquired = acquired_.load(std::memory_order_relaxed);
+    stats.exhausted = exhausted_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+}
@@ -0,0 +1,68 @@
+#include "core/rt_alloc_guard.hpp"
+
+#ifdef VOICE_ENGINE_RT_ALLOC_CHECK
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    // Gerçek zamanlı bölüm derinliği ve izin verilen bölüm derinliği (thread başına)
+    thread_local int realtime_depth = 0;
+    thread_local int allowed_depth = 0;
+
+    void check_allocation(std::size_t size) {
+        if (realtime_depth > 0 && allowed_depth == 0) {
+            // Burada allocation yapan hiçbir şey (std::cerr dahil) kullanılmamalı
+            std::fprintf(stderr, "RT HATA: Ses thread'inde heap allocation (%zu byte)\n", size);
+            std::abort();
+        }
+    }
+
+    void checked_free(void* ptr) {
+        if (ptr && realtime_depth > 0 && allowed_depth == 0) {
+            std::fprintf(stderr, "RT HATA: Ses thread'inde heap deallocation\n");
+            std::abort();
+        }
+        std::free(ptr);
+    }
+
+    void* checked_malloc(std::size_t size) {
+        check_allocation(size);
+        void* ptr = std::malloc(size == 0 ? 1 : size);
+        if (!ptr) {
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+}
+
+namespace core {
+    ScopedRealtimeSection::ScopedRealtimeSection() { ++realtime_depth; }
+    ScopedRealtimeSection::~ScopedRealtimeSection() { --realtime_depth; }
+
+    ScopedAllocationAllowed::ScopedAllocationAllowed() { ++allowed_depth; }
+    ScopedAllocationAllowed::~ScopedAllocationAllowed() { --allowed_depth; }
+}
+
+void* operator new(std::size_t size) { return checked_malloc(size); }
+void* operator new[](std::size_t size) { return checked_malloc(size); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    check_allocation(size);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    check_allocation(size);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void operator delete(void* ptr) noexcept { checked_free(ptr); }
+void operator delete[](void* ptr) noexcept { checked_free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { checked_free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { checked_free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { checked_free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { checked_free(ptr); }
+
+#endif
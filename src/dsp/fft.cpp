@@ -0,0 +1,163 @@
+#include "dsp/fft.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define VOICE_ENGINE_FFT_SSE2 1
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace dsp {
+
+namespace {
+    bool is_power_of_two(size_t value) {
+        return value != 0 && (value & (value - 1)) == 0;
+    }
+
+    // a, b: butterfly girişleri (yerinde güncellenir), w: twiddle'lar; 'count' butterfly
+    void butterflies(std::complex<float>* a, std::complex<float>* b,
+                     const std::complex<float>* w, size_t count) {
+        size_t j = 0;
+#ifdef VOICE_ENGINE_FFT_SSE2
+        // İki butterfly'ı aynı anda işle: [re0, im0, re1, im1]
+        const __m128 sign = _mm_set_ps(1.0f, -1.0f, 1.0f, -1.0f);
+        for (; j + 2 <= count; j += 2) {
+            float* pa = reinterpret_cast<float*>(a + j);
+            float* pb = reinterpret_cast<float*>(b + j);
+            const float* pw = reinterpret_cast<const float*>(w + j);
+
+            const __m128 va = _mm_loadu_ps(pa);
+            const __m128 vb = _mm_loadu_ps(pb);
+            const __m128 vw = _mm_loadu_ps(pw);
+
+            // t = b * w (kompleks çarpım)
+            const __m128 w_re = _mm_shuffle_ps(vw, vw, _MM_SHUFFLE(2, 2, 0, 0));
+            const __m128 w_im = _mm_shuffle_ps(vw, vw, _MM_SHUFFLE(3, 3, 1, 1));
+            const __m128 b_swap = _mm_shuffle_ps(vb, vb, _MM_SHUFFLE(2, 3, 0, 1));
+            const __m128 t = _mm_add_ps(_mm_mul_ps(vb, w_re),
+                                        _mm_mul_ps(_mm_mul_ps(b_swap, w_im), sign));
+
+            _mm_storeu_ps(pa, _mm_add_ps(va, t));
+            _mm_storeu_ps(pb, _mm_sub_ps(va, t));
+        }
+#endif
+        for (; j < count; ++j) {
+            const std::complex<float> t = b[j] * w[j];
+            b[j] = a[j] - t;
+            a[j] = a[j] + t;
+        }
+    }
+}
+
+RealFft::RealFft(size_t size)
+    : size_(size),
+      half_(size / 2),
+      bit_reverse_(size / 2),
+      stage_twiddles_(size / 2 > 1 ? size / 2 - 1 : 1),
+      inverse_twiddles_(size / 2 > 1 ? size / 2 - 1 : 1),
+      split_twiddles_(size / 2 + 1),
+      work_(size / 2) {
+    if (!is_power_of_two(size_) || size_ < 4) {
+        throw std::runtime_error("FFT boyutu 2'nin kuvveti ve en az 4 olmalı: " + std::to_string(size_));
+    }
+
+    // Bit-reverse tablosu (M noktalı)
+    size_t bits = 0;
+    while ((size_t(1) << bits) < half_) {
+        ++bits;
+    }
+    for (size_t i = 0; i < half_; ++i) {
+        uint32_t reversed = 0;
+        for (size_t b = 0; b < bits; ++b) {
+            if (i & (size_t(1) << b)) {
+                reversed |= 1u << (bits - 1 - b);
+            }
+        }
+        bit_reverse_[i] = reversed;
+    }
+
+    // Aşama twiddle'ları: yarı uzunluğu h olan aşama için e^{-iπj/h}, j < h;
+    // tabloda h-1 ofsetinden başlayarak ardışık saklanır (SIMD için stride yok).
+    for (size_t h = 1; h < half_; h <<= 1) {
+        for (size_t j = 0; j < h; ++j) {
+            const double angle = -M_PI * static_cast<double>(j) / static_cast<double>(h);
+            const std::complex<float> w(static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)));
+            stage_twiddles_[h - 1 + j] = w;
+            inverse_twiddles_[h - 1 + j] = std::conj(w);
+        }
+    }
+
+    // Gerçel FFT split adımı için e^{-2πik/N}
+    for (size_t k = 0; k <= half_; ++k) {
+        const double angle = -2.0 * M_PI * static_cast<double>(k) / static_cast<double>(size_);
+        split_twiddles_[k] = std::complex<float>(static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)));
+    }
+}
+
+void RealFft::complex_fft(std::complex<float>* data, bool inverse) {
+    // Bit-reverse permütasyonu
+    for (size_t i = 0; i < half_; ++i) {
+        const size_t j = bit_reverse_[i];
+        if (i < j) {
+            std::swap(data[i], data[j]);
+        }
+    }
+
+    // Radix-2 DIT aşamaları
+    const std::vector<std::complex<float>>& twiddles = inverse ? inverse_twiddles_ : stage_twiddles_;
+    for (size_t h = 1; h < half_; h <<= 1) {
+        const std::complex<float>* w = twiddles.data() + (h - 1);
+        for (size_t start = 0; start < half_; start += 2 * h) {
+            butterflies(data + start, data + start + h, w, h);
+        }
+    }
+}
+
+void RealFft::forward(const float* input, std::complex<float>* output) {
+    // Çift/tek örnekleri tek bir M noktalı kompleks sinyale paketle: z[n] = x[2n] + i·x[2n+1]
+    for (size_t n = 0; n < half_; ++n) {
+        work_[n] = std::complex<float>(input[2 * n], input[2 * n + 1]);
+    }
+
+    complex_fft(work_.data(), false);
+
+    // Split: X[k] = Xe[k] + W^k · Xo[k]
+    const std::complex<float> z0 = work_[0];
+    output[0] = std::complex<float>(z0.real() + z0.imag(), 0.0f);
+    output[half_] = std::complex<float>(z0.real() - z0.imag(), 0.0f);
+    for (size_t k = 1; k < half_; ++k) {
+        const std::complex<float> zk = work_[k];
+        const std::complex<float> zc = std::conj(work_[half_ - k]);
+        const std::complex<float> even = 0.5f * (zk + zc);
+        const std::complex<float> diff = 0.5f * (zk - zc);
+        const std::complex<float> odd(diff.imag(), -diff.real()); // diff / i
+        output[k] = even + split_twiddles_[k] * odd;
+    }
+}
+
+void RealFft::inverse(const std::complex<float>* input, float* output) {
+    // Split'in tersi: Z[k] = Xe[k] + i·Xo[k]
+    for (size_t k = 0; k < half_; ++k) {
+        const std::complex<float> xk = input[k];
+        const std::complex<float> xc = std::conj(input[half_ - k]);
+        const std::complex<float> even = 0.5f * (xk + xc);
+        const std::complex<float> odd = 0.5f * (xk - xc) * std::conj(split_twiddles_[k]);
+        work_[k] = even + std::complex<float>(-odd.imag(), odd.real()); // even + i·odd
+    }
+
+    complex_fft(work_.data(), true);
+
+    const float scale = 1.0f / static_cast<float>(half_);
+    for (size_t n = 0; n < half_; ++n) {
+        output[2 * n] = work_[n].real() * scale;
+        output[2 * n + 1] = work_[n].imag() * scale;
+    }
+}
+
+}
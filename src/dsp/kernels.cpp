@@ -0,0 +1,225 @@
+#include "dsp/kernels.hpp"
+#include <algorithm>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace dsp {
+
+namespace {
+    void int16_to_float_scalar(const int16_t* in, float* out, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = static_cast<float>(in[i]) / 32768.0f;
+        }
+    }
+
+    void float_to_int16_scalar(const float* in, int16_t* out, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = static_cast<int16_t>(std::clamp(in[i] * 32768.0f, -32768.0f, 32767.0f));
+        }
+    }
+
+    float dot_scalar(const float* a, const float* b, size_t count) {
+        float sum = 0.0f;
+        for (size_t i = 0; i < count; ++i) {
+            sum += a[i] * b[i];
+        }
+        return sum;
+    }
+
+    void axpy_scalar(float alpha, const float* x, float* y, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            y[i] += alpha * x[i];
+        }
+    }
+
+    void multiply_scalar(const float* a, const float* b, float* out, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = a[i] * b[i];
+        }
+    }
+
+    void multiply_accumulate_scalar(const float* a, const float* b, float* y, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            y[i] += a[i] * b[i];
+        }
+    }
+
+    float sum_squares_int16_scalar(const int16_t* in, size_t count) {
+        float sum = 0.0f;
+        for (size_t i = 0; i < count; ++i) {
+            const float sample = static_cast<float>(in[i]);
+            sum += sample * sample;
+        }
+        return sum;
+    }
+
+    void apply_gain_scalar(std::complex<float>* bins, const float* gains, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            bins[i] *= gains[i];
+        }
+    }
+
+    void complex_multiply_accumulate_scalar(const std::complex<float>* a, const std::complex<float>* b,
+                                            std::complex<float>* y, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            y[i] = {y[i].real() + (a[i].real() * b[i].real() - a[i].imag() * b[i].imag()),
+                    y[i].imag() + (a[i].real() * b[i].imag() + a[i].imag() * b[i].real())};
+        }
+    }
+
+    void complex_conj_multiply_accumulate_scalar(const std::complex<float>* a, const std::complex<float>* b,
+                                                 std::complex<float>* y, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            y[i] = {y[i].real() + (a[i].real() * b[i].real() + a[i].imag() * b[i].imag()),
+                    y[i].imag() + (a[i].real() * b[i].imag() - a[i].imag() * b[i].real())};
+        }
+    }
+
+    void norm_accumulate_scalar(const std::complex<float>* in, float* out, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] += in[i].real() * in[i].real() + in[i].imag() * in[i].imag();
+        }
+    }
+
+    void xor_bytes_scalar(const uint8_t* in, uint8_t* out, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] ^= in[i];
+        }
+    }
+
+    void gf256_multiply_add_scalar(const uint8_t* tables, const uint8_t* in, uint8_t* out, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] ^= tables[in[i] & 0x0F] ^ tables[16 + (in[i] >> 4)];
+        }
+    }
+
+    // CPU özellik tespiti
+    bool cpu_supports(SimdLevel level) {
+        switch (level) {
+            case SimdLevel::Scalar:
+                return true;
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+            case SimdLevel::Sse41:
+                return __builtin_cpu_supports("sse4.1");
+            case SimdLevel::Avx2:
+                return __builtin_cpu_supports("avx2");
+            case SimdLevel::Avx512:
+                return __builtin_cpu_supports("avx512f");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            case SimdLevel::Sse41: {
+                int info[4];
+                __cpuid(info, 1);
+                return (info[2] & (1 << 19)) != 0;
+            }
+            case SimdLevel::Avx2:
+            case SimdLevel::Avx512: {
+                int info[4];
+                __cpuid(info, 1);
+                const bool os_avx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)); // OSXSAVE + AVX
+                if (!os_avx) {
+                    return false;
+                }
+                const unsigned long long xcr0 = _xgetbv(0);
+                __cpuidex(info, 7, 0);
+                if (level == SimdLevel::Avx2) {
+                    return (xcr0 & 0x6) == 0x6 && (info[1] & (1 << 5)) != 0;
+                }
+                return (xcr0 & 0xE6) == 0xE6 && (info[1] & (1 << 16)) != 0;
+            }
+#endif
+            case SimdLevel::Neon:
+#if defined(__aarch64__) || defined(_M_ARM64)
+                return true; // AArch64'te NEON her zaman mevcut
+#else
+                return false;
+#endif
+            default:
+                return false;
+        }
+    }
+
+    SimdLevel select_best_level() {
+        const SimdLevel order[] = {SimdLevel::Avx512, SimdLevel::Avx2, SimdLevel::Sse41, SimdLevel::Neon};
+        for (SimdLevel level : order) {
+            if (kernels_for(level)) {
+                return level;
+            }
+        }
+        return SimdLevel::Scalar;
+    }
+}
+
+namespace detail {
+    const KernelTable& scalar_kernels() {
+        static const KernelTable table = {
+            int16_to_float_scalar,
+            float_to_int16_scalar,
+            dot_scalar,
+            axpy_scalar,
+            multiply_scalar,
+            multiply_accumulate_scalar,
+            sum_squares_int16_scalar,
+            apply_gain_scalar,
+            complex_multiply_accumulate_scalar,
+            complex_conj_multiply_accumulate_scalar,
+            norm_accumulate_scalar,
+            xor_bytes_scalar,
+            gf256_multiply_add_scalar
+        };
+        return table;
+    }
+}
+
+const KernelTable* kernels_for(SimdLevel level) {
+    if (!cpu_supports(level)) {
+        return nullptr;
+    }
+    switch (level) {
+        case SimdLevel::Scalar:
+            return &detail::scalar_kernels();
+#ifdef VOICE_ENGINE_HAVE_SSE41
+        case SimdLevel::Sse41:
+            return &detail::sse41_kernels();
+#endif
+#ifdef VOICE_ENGINE_HAVE_AVX2
+        case SimdLevel::Avx2:
+            return &detail::avx2_kernels();
+#endif
+#ifdef VOICE_ENGINE_HAVE_AVX512
+        case SimdLevel::Avx512:
+            return &detail::avx512_kernels();
+#endif
+#ifdef VOICE_ENGINE_HAVE_NEON
+        case SimdLevel::Neon:
+            return &detail::neon_kernels();
+#endif
+        default:
+            return nullptr;
+    }
+}
+
+const KernelTable& kernels() {
+    // Thread-safe statik başlatma; seçim sadece bir kez yapılır
+    static const KernelTable& table = *kernels_for(simd_level());
+    return table;
+}
+
+SimdLevel simd_level() {
+    static const SimdLevel level = select_best_level();
+    return level;
+}
+
+const char* simd_level_name(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Scalar: return "scalar";
+        case SimdLevel::Sse41:  return "SSE4.1";
+        case SimdLevel::Avx2:   return "AVX2";
+        case SimdLevel::Avx512: return "AVX-512";
+        case SimdLevel::Neon:   return "NEON";
+    }
+    return "unknown";
+}
+
+}
@@ -0,0 +1,246 @@
+// AVX2 kernelleri. Bu dosya -mavx2 ile derlenir; sadece CPU desteklediğinde çağrılır.
+// FMA bilerek kullanılmaz: eleman bazlı sonuçlar skaler referansla bit-bit aynı kalmalı.
+#include "dsp/kernels.hpp"
+#include <immintrin.h>
+#include <algorithm>
+
+namespace dsp {
+
+namespace {
+    float horizontal_sum(__m256 v) {
+        __m128 sums = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        __m128 shuffled = _mm_movehdup_ps(sums);
+        sums = _mm_add_ps(sums, shuffled);
+        shuffled = _mm_movehl_ps(shuffled, sums);
+        sums = _mm_add_ss(sums, shuffled);
+        return _mm_cvtss_f32(sums);
+    }
+
+    void int16_to_float_avx2(const int16_t* in, float* out, size_t count) {
+        const __m256 scale = _mm256_set1_ps(1.0f / 32768.0f);
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 8));
+            _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(low)), scale));
+            _mm256_storeu_ps(out + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(high)), scale));
+        }
+        for (; i < count; ++i) {
+            out[i] = static_cast<float>(in[i]) / 32768.0f;
+        }
+    }
+
+    void float_to_int16_avx2(const float* in, int16_t* out, size_t count) {
+        const __m256 scale = _mm256_set1_ps(32768.0f);
+        const __m256 min_value = _mm256_set1_ps(-32768.0f);
+        const __m256 max_value = _mm256_set1_ps(32767.0f);
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            __m256 a = _mm256_mul_ps(_mm256_loadu_ps(in + i), scale);
+            __m256 b = _mm256_mul_ps(_mm256_loadu_ps(in + i + 8), scale);
+            a = _mm256_min_ps(_mm256_max_ps(a, min_value), max_value);
+            b = _mm256_min_ps(_mm256_max_ps(b, min_value), max_value);
+            // packs 128-bit şeritler içinde çalışır; sırayı permute ile düzelt
+            const __m256i packed = _mm256_packs_epi32(_mm256_cvttps_epi32(a), _mm256_cvttps_epi32(b));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_permute4x64_epi64(packed, 0xD8));
+        }
+        for (; i < count; ++i) {
+            out[i] = static_cast<int16_t>(std::clamp(in[i] * 32768.0f, -32768.0f, 32767.0f));
+        }
+    }
+
+    float dot_avx2(const float* a, const float* b, size_t count) {
+        __m256 acc0 = _mm256_setzero_ps();
+        __m256 acc1 = _mm256_setzero_ps();
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+            acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8)));
+        }
+        float sum = horizontal_sum(_mm256_add_ps(acc0, acc1));
+        for (; i < count; ++i) {
+            sum += a[i] * b[i];
+        }
+        return sum;
+    }
+
+    void axpy_avx2(float alpha, const float* x, float* y, size_t count) {
+        const __m256 va = _mm256_set1_ps(alpha);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_mul_ps(va, _mm256_loadu_ps(x + i))));
+        }
+        for (; i < count; ++i) {
+            y[i] += alpha * x[i];
+        }
+    }
+
+    void multiply_avx2(const float* a, const float* b, float* out, size_t count) {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+        }
+        for (; i < count; ++i) {
+            out[i] = a[i] * b[i];
+        }
+    }
+
+    void multiply_accumulate_avx2(const float* a, const float* b, float* y, size_t count) {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m256 product = _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+            _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), product));
+        }
+        for (; i < count; ++i) {
+            y[i] += a[i] * b[i];
+        }
+    }
+
+    float sum_squares_int16_avx2(const int16_t* in, size_t count) {
+        __m256 acc0 = _mm256_setzero_ps();
+        __m256 acc1 = _mm256_setzero_ps();
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 8));
+            const __m256 a = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(low));
+            const __m256 b = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(high));
+            acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(a, a));
+            acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(b, b));
+        }
+        float sum = horizontal_sum(_mm256_add_ps(acc0, acc1));
+        for (; i < count; ++i) {
+            const float sample = static_cast<float>(in[i]);
+            sum += sample * sample;
+        }
+        return sum;
+    }
+
+    void apply_gain_avx2(std::complex<float>* bins, const float* gains, size_t count) {
+        float* data = reinterpret_cast<float*>(bins);
+        // g0..g3 -> g0 g0 g1 g1 g2 g2 g3 g3
+        const __m256i duplicate = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m256 g = _mm256_loadu_ps(gains + i);
+            const __m256 g_low = _mm256_permutevar8x32_ps(g, duplicate);
+            const __m256 g_high = _mm256_permutevar8x32_ps(_mm256_permute2f128_ps(g, g, 0x11), duplicate);
+            _mm256_storeu_ps(data + 2 * i, _mm256_mul_ps(_mm256_loadu_ps(data + 2 * i), g_low));
+            _mm256_storeu_ps(data + 2 * i + 8, _mm256_mul_ps(_mm256_loadu_ps(data + 2 * i + 8), g_high));
+        }
+        for (; i < count; ++i) {
+            bins[i] *= gains[i];
+        }
+    }
+
+    void complex_multiply_accumulate_avx2(const std::complex<float>* a, const std::complex<float>* b,
+                                          std::complex<float>* y, size_t count) {
+        const float* pa = reinterpret_cast<const float*>(a);
+        const float* pb = reinterpret_cast<const float*>(b);
+        float* py = reinterpret_cast<float*>(y);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const __m256 va = _mm256_loadu_ps(pa + 2 * i);
+            const __m256 vb = _mm256_loadu_ps(pb + 2 * i);
+            const __m256 ar_b = _mm256_mul_ps(_mm256_moveldup_ps(va), vb);
+            const __m256 ai_b = _mm256_mul_ps(_mm256_movehdup_ps(va), _mm256_permute_ps(vb, _MM_SHUFFLE(2, 3, 0, 1)));
+            _mm256_storeu_ps(py + 2 * i, _mm256_add_ps(_mm256_loadu_ps(py + 2 * i), _mm256_addsub_ps(ar_b, ai_b)));
+        }
+        for (; i < count; ++i) {
+            y[i] = {y[i].real() + (a[i].real() * b[i].real() - a[i].imag() * b[i].imag()),
+                    y[i].imag() + (a[i].real() * b[i].imag() + a[i].imag() * b[i].real())};
+        }
+    }
+
+    void complex_conj_multiply_accumulate_avx2(const std::complex<float>* a, const std::complex<float>* b,
+                                               std::complex<float>* y, size_t count) {
+        const float* pa = reinterpret_cast<const float*>(a);
+        const float* pb = reinterpret_cast<const float*>(b);
+        float* py = reinterpret_cast<float*>(y);
+        const __m256 sign = _mm256_set1_ps(-0.0f);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const __m256 va = _mm256_loadu_ps(pa + 2 * i);
+            const __m256 vb = _mm256_loadu_ps(pb + 2 * i);
+            const __m256 ar_b = _mm256_mul_ps(_mm256_moveldup_ps(va), vb);
+            const __m256 ai_b = _mm256_mul_ps(_mm256_movehdup_ps(va), _mm256_permute_ps(vb, _MM_SHUFFLE(2, 3, 0, 1)));
+            _mm256_storeu_ps(py + 2 * i,
+                             _mm256_add_ps(_mm256_loadu_ps(py + 2 * i), _mm256_addsub_ps(ar_b, _mm256_xor_ps(ai_b, sign))));
+        }
+        for (; i < count; ++i) {
+            y[i] = {y[i].real() + (a[i].real() * b[i].real() + a[i].imag() * b[i].imag()),
+                    y[i].imag() + (a[i].real() * b[i].imag() - a[i].imag() * b[i].real())};
+        }
+    }
+
+    void norm_accumulate_avx2(const std::complex<float>* in, float* out, size_t count) {
+        const float* data = reinterpret_cast<const float*>(in);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m256 low = _mm256_loadu_ps(data + 2 * i);
+            const __m256 high = _mm256_loadu_ps(data + 2 * i + 8);
+            // hadd 128-bit yarımlarda çalışır: sıra 0 1 4 5 | 2 3 6 7, 64-bit permute ile düzeltilir
+            const __m256 pairs = _mm256_hadd_ps(_mm256_mul_ps(low, low), _mm256_mul_ps(high, high));
+            const __m256 norms = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(pairs), 0xD8));
+            _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(out + i), norms));
+        }
+        for (; i < count; ++i) {
+            out[i] += in[i].real() * in[i].real() + in[i].imag() * in[i].imag();
+        }
+    }
+
+    void xor_bytes_avx2(const uint8_t* in, uint8_t* out, size_t count) {
+        size_t i = 0;
+        for (; i + 32 <= count; i += 32) {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(out + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_xor_si256(a, b));
+        }
+        for (; i < count; ++i) {
+            out[i] ^= in[i];
+        }
+    }
+
+    // vpshufb 128-bit şeritler içinde çalışır; tablolar iki şeride de yayılır
+    void gf256_multiply_add_avx2(const uint8_t* tables, const uint8_t* in, uint8_t* out, size_t count) {
+        const __m256i low_table =
+            _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tables)));
+        const __m256i high_table =
+            _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tables + 16)));
+        const __m256i nibble = _mm256_set1_epi8(0x0F);
+        size_t i = 0;
+        for (; i + 32 <= count; i += 32) {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+            const __m256i low = _mm256_shuffle_epi8(low_table, _mm256_and_si256(x, nibble));
+            const __m256i high = _mm256_shuffle_epi8(high_table, _mm256_and_si256(_mm256_srli_epi64(x, 4), nibble));
+            const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(out + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_xor_si256(y, _mm256_xor_si256(low, high)));
+        }
+        for (; i < count; ++i) {
+            out[i] ^= tables[in[i] & 0x0F] ^ tables[16 + (in[i] >> 4)];
+        }
+    }
+}
+
+namespace detail {
+    const KernelTable& avx2_kernels() {
+        static const KernelTable table = {
+            int16_to_float_avx2,
+            float_to_int16_avx2,
+            dot_avx2,
+            axpy_avx2,
+            multiply_avx2,
+            multiply_accumulate_avx2,
+            sum_squares_int16_avx2,
+            apply_gain_avx2,
+            complex_multiply_accumulate_avx2,
+            complex_conj_multiply_accumulate_avx2,
+            norm_accumulate_avx2,
+            xor_bytes_avx2,
+            gf256_multiply_add_avx2
+        };
+        return table;
+    }
+}
+
+}
@@ -0,0 +1,255 @@
+// AVX-512 kernelleri. Bu dosya -mavx512f ile derlenir; sadece CPU desteklediğinde çağrılır.
+// Kuyruklar maskeli yükleme/yazma ile işlenir.
+#include "dsp/kernels.hpp"
+#include <immintrin.h>
+#include <algorithm>
+
+// GCC 12'nin avx512fintrin.h'deki `__Y = __Y` kalıbı için verdiği yanlış uyarılar
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace dsp {
+
+namespace {
+    __mmask16 tail_mask(size_t remaining) {
+        return static_cast<__mmask16>((1u << remaining) - 1u);
+    }
+
+    void int16_to_float_avx512(const int16_t* in, float* out, size_t count) {
+        const __m512 scale = _mm512_set1_ps(1.0f / 32768.0f);
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            const __m256i samples = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+            _mm512_storeu_ps(out + i, _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(samples)), scale));
+        }
+        for (; i < count; ++i) {
+            out[i] = static_cast<float>(in[i]) / 32768.0f;
+        }
+    }
+
+    void float_to_int16_avx512(const float* in, int16_t* out, size_t count) {
+        const __m512 scale = _mm512_set1_ps(32768.0f);
+        const __m512 min_value = _mm512_set1_ps(-32768.0f);
+        const __m512 max_value = _mm512_set1_ps(32767.0f);
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            __m512 v = _mm512_mul_ps(_mm512_loadu_ps(in + i), scale);
+            v = _mm512_min_ps(_mm512_max_ps(v, min_value), max_value);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm512_cvtepi32_epi16(_mm512_cvttps_epi32(v)));
+        }
+        for (; i < count; ++i) {
+            out[i] = static_cast<int16_t>(std::clamp(in[i] * 32768.0f, -32768.0f, 32767.0f));
+        }
+    }
+
+    float dot_avx512(const float* a, const float* b, size_t count) {
+        __m512 acc0 = _mm512_setzero_ps();
+        __m512 acc1 = _mm512_setzero_ps();
+        size_t i = 0;
+        for (; i + 32 <= count; i += 32) {
+            acc0 = _mm512_add_ps(acc0, _mm512_mul_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+            acc1 = _mm512_add_ps(acc1, _mm512_mul_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16)));
+        }
+        for (; i + 16 <= count; i += 16) {
+            acc0 = _mm512_add_ps(acc0, _mm512_mul_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+        }
+        if (i < count) {
+            const __mmask16 mask = tail_mask(count - i);
+            acc1 = _mm512_add_ps(acc1, _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, a + i), _mm512_maskz_loadu_ps(mask, b + i)));
+        }
+        return _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+    }
+
+    void axpy_avx512(float alpha, const float* x, float* y, size_t count) {
+        const __m512 va = _mm512_set1_ps(alpha);
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            _mm512_storeu_ps(y + i, _mm512_add_ps(_mm512_loadu_ps(y + i), _mm512_mul_ps(va, _mm512_loadu_ps(x + i))));
+        }
+        if (i < count) {
+            const __mmask16 mask = tail_mask(count - i);
+            const __m512 result = _mm512_add_ps(_mm512_maskz_loadu_ps(mask, y + i),
+                                                _mm512_mul_ps(va, _mm512_maskz_loadu_ps(mask, x + i)));
+            _mm512_mask_storeu_ps(y + i, mask, result);
+        }
+    }
+
+    void multiply_avx512(const float* a, const float* b, float* out, size_t count) {
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            _mm512_storeu_ps(out + i, _mm512_mul_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+        }
+        if (i < count) {
+            const __mmask16 mask = tail_mask(count - i);
+            _mm512_mask_storeu_ps(out + i, mask, _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, a + i),
+                                                               _mm512_maskz_loadu_ps(mask, b + i)));
+        }
+    }
+
+    void multiply_accumulate_avx512(const float* a, const float* b, float* y, size_t count) {
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            const __m512 product = _mm512_mul_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i));
+            _mm512_storeu_ps(y + i, _mm512_add_ps(_mm512_loadu_ps(y + i), product));
+        }
+        if (i < count) {
+            const __mmask16 mask = tail_mask(count - i);
+            const __m512 product = _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, a + i), _mm512_maskz_loadu_ps(mask, b + i));
+            _mm512_mask_storeu_ps(y + i, mask, _mm512_add_ps(_mm512_maskz_loadu_ps(mask, y + i), product));
+        }
+    }
+
+    float sum_squares_int16_avx512(const int16_t* in, size_t count) {
+        __m512 acc = _mm512_setzero_ps();
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            const __m256i samples = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+            const __m512 v = _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(samples));
+            acc = _mm512_add_ps(acc, _mm512_mul_ps(v, v));
+        }
+        float sum = _mm512_reduce_add_ps(acc);
+        for (; i < count; ++i) {
+            const float sample = static_cast<float>(in[i]);
+            sum += sample * sample;
+        }
+        return sum;
+    }
+
+    void apply_gain_avx512(std::complex<float>* bins, const float* gains, size_t count) {
+        float* data = reinterpret_cast<float*>(bins);
+        const __m512i duplicate_low = _mm512_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7);
+        const __m512i duplicate_high = _mm512_setr_epi32(8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 14, 14, 15, 15);
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            const __m512 g = _mm512_loadu_ps(gains + i);
+            const __m512 g_low = _mm512_permutexvar_ps(duplicate_low, g);
+            const __m512 g_high = _mm512_permutexvar_ps(duplicate_high, g);
+            _mm512_storeu_ps(data + 2 * i, _mm512_mul_ps(_mm512_loadu_ps(data + 2 * i), g_low));
+            _mm512_storeu_ps(data + 2 * i + 16, _mm512_mul_ps(_mm512_loadu_ps(data + 2 * i + 16), g_high));
+        }
+        for (; i < count; ++i) {
+            bins[i] *= gains[i];
+        }
+    }
+
+    void complex_multiply_accumulate_avx512(const std::complex<float>* a, const std::complex<float>* b,
+                                            std::complex<float>* y, size_t count) {
+        const float* pa = reinterpret_cast<const float*>(a);
+        const float* pb = reinterpret_cast<const float*>(b);
+        float* py = reinterpret_cast<float*>(y);
+        // AVX-512'de addsub yok: çift (gerçek) şeritlerde ai·b teriminin işareti çevrilip toplanır
+        const __m512i sign_real = _mm512_set1_epi64(0x80000000LL);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m512 va = _mm512_loadu_ps(pa + 2 * i);
+            const __m512 vb = _mm512_loadu_ps(pb + 2 * i);
+            const __m512 ar_b = _mm512_mul_ps(_mm512_moveldup_ps(va), vb);
+            const __m512 ai_b = _mm512_mul_ps(_mm512_movehdup_ps(va), _mm512_permute_ps(vb, _MM_SHUFFLE(2, 3, 0, 1)));
+            const __m512 product = _mm512_add_ps(ar_b, _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(ai_b), sign_real)));
+            _mm512_storeu_ps(py + 2 * i, _mm512_add_ps(_mm512_loadu_ps(py + 2 * i), product));
+        }
+        for (; i < count; ++i) {
+            y[i] = {y[i].real() + (a[i].real() * b[i].real() - a[i].imag() * b[i].imag()),
+                    y[i].imag() + (a[i].real() * b[i].imag() + a[i].imag() * b[i].real())};
+        }
+    }
+
+    void complex_conj_multiply_accumulate_avx512(const std::complex<float>* a, const std::complex<float>* b,
+                                                 std::complex<float>* y, size_t count) {
+        const float* pa = reinterpret_cast<const float*>(a);
+        const float* pb = reinterpret_cast<const float*>(b);
+        float* py = reinterpret_cast<float*>(y);
+        const __m512i sign_imag = _mm512_set1_epi64(INT64_MIN);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m512 va = _mm512_loadu_ps(pa + 2 * i);
+            const __m512 vb = _mm512_loadu_ps(pb + 2 * i);
+            const __m512 ar_b = _mm512_mul_ps(_mm512_moveldup_ps(va), vb);
+            const __m512 ai_b = _mm512_mul_ps(_mm512_movehdup_ps(va), _mm512_permute_ps(vb, _MM_SHUFFLE(2, 3, 0, 1)));
+            const __m512 product = _mm512_add_ps(ar_b, _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(ai_b), sign_imag)));
+            _mm512_storeu_ps(py + 2 * i, _mm512_add_ps(_mm512_loadu_ps(py + 2 * i), product));
+        }
+        for (; i < count; ++i) {
+            y[i] = {y[i].real() + (a[i].real() * b[i].real() + a[i].imag() * b[i].imag()),
+                    y[i].imag() + (a[i].real() * b[i].imag() - a[i].imag() * b[i].real())};
+        }
+    }
+
+    void norm_accumulate_avx512(const std::complex<float>* in, float* out, size_t count) {
+        const float* data = reinterpret_cast<const float*>(in);
+        const __m512i even = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            const __m512 low = _mm512_loadu_ps(data + 2 * i);
+            const __m512 high = _mm512_loadu_ps(data + 2 * i + 16);
+            // Çift şeritlerde re² + im², sonra iki vektörün çift şeritleri birleştirilir
+            const __m512 low_sq = _mm512_mul_ps(low, low);
+            const __m512 high_sq = _mm512_mul_ps(high, high);
+            const __m512 low_pairs = _mm512_add_ps(low_sq, _mm512_permute_ps(low_sq, _MM_SHUFFLE(2, 3, 0, 1)));
+            const __m512 high_pairs = _mm512_add_ps(high_sq, _mm512_permute_ps(high_sq, _MM_SHUFFLE(2, 3, 0, 1)));
+            const __m512 norms = _mm512_permutex2var_ps(low_pairs, even, high_pairs);
+            _mm512_storeu_ps(out + i, _mm512_add_ps(_mm512_loadu_ps(out + i), norms));
+        }
+        for (; i < count; ++i) {
+            out[i] += in[i].real() * in[i].real() + in[i].imag() * in[i].imag();
+        }
+    }
+
+    void xor_bytes_avx512(const uint8_t* in, uint8_t* out, size_t count) {
+        size_t i = 0;
+        for (; i + 64 <= count; i += 64) {
+            const __m512i a = _mm512_loadu_si512(in + i);
+            const __m512i b = _mm512_loadu_si512(out + i);
+            _mm512_storeu_si512(out + i, _mm512_xor_si512(a, b));
+        }
+        for (; i < count; ++i) {
+            out[i] ^= in[i];
+        }
+    }
+
+    // 512-bit byte karıştırma (vpshufb zmm) AVX512BW ister; dosya sadece AVX512F ile
+    // derlendiğinden tablo araması 256-bit yapılır (AVX512F, AVX2'yi kapsar)
+    void gf256_multiply_add_avx512(const uint8_t* tables, const uint8_t* in, uint8_t* out, size_t count) {
+        const __m256i low_table =
+            _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tables)));
+        const __m256i high_table =
+            _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tables + 16)));
+        const __m256i nibble = _mm256_set1_epi8(0x0F);
+        size_t i = 0;
+        for (; i + 32 <= count; i += 32) {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+            const __m256i low = _mm256_shuffle_epi8(low_table, _mm256_and_si256(x, nibble));
+            const __m256i high = _mm256_shuffle_epi8(high_table, _mm256_and_si256(_mm256_srli_epi64(x, 4), nibble));
+            const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(out + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_xor_si256(y, _mm256_xor_si256(low, high)));
+        }
+        for (; i < count; ++i) {
+            out[i] ^= tables[in[i] & 0x0F] ^ tables[16 + (in[i] >> 4)];
+        }
+    }
+}
+
+namespace detail {
+    const KernelTable& avx512_kernels() {
+        static const KernelTable table = {
+            int16_to_float_avx512,
+            float_to_int16_avx512,
+            dot_avx512,
+            axpy_avx512,
+            multiply_avx512,
+            multiply_accumulate_avx512,
+            sum_squares_int16_avx512,
+            apply_gain_avx512,
+            complex_multiply_accumulate_avx512,
+            complex_conj_multiply_accumulate_avx512,
+            norm_accumulate_avx512,
+            xor_bytes_avx512,
+            gf256_multiply_add_avx512
+        };
+        return table;
+    }
+}
+
+}
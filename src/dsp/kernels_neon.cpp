@@ -0,0 +1,223 @@
+// NEON kernelleri (AArch64). vmlaq yerine ayrı çarpma/toplama kullanılır ki
+// eleman bazlı sonuçlar skaler referansla bit-bit aynı kalsın.
+#include "dsp/kernels.hpp"
+#include <arm_neon.h>
+#include <algorithm>
+
+namespace dsp {
+
+namespace {
+    void int16_to_float_neon(const int16_t* in, float* out, size_t count) {
+        const float32x4_t scale = vdupq_n_f32(1.0f / 32768.0f);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const int16x8_t samples = vld1q_s16(in + i);
+            const float32x4_t low = vcvtq_f32_s32(vmovl_s16(vget_low_s16(samples)));
+            const float32x4_t high = vcvtq_f32_s32(vmovl_s16(vget_high_s16(samples)));
+            vst1q_f32(out + i, vmulq_f32(low, scale));
+            vst1q_f32(out + i + 4, vmulq_f32(high, scale));
+        }
+        for (; i < count; ++i) {
+            out[i] = static_cast<float>(in[i]) / 32768.0f;
+        }
+    }
+
+    void float_to_int16_neon(const float* in, int16_t* out, size_t count) {
+        const float32x4_t scale = vdupq_n_f32(32768.0f);
+        const float32x4_t min_value = vdupq_n_f32(-32768.0f);
+        const float32x4_t max_value = vdupq_n_f32(32767.0f);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            float32x4_t a = vmulq_f32(vld1q_f32(in + i), scale);
+            float32x4_t b = vmulq_f32(vld1q_f32(in + i + 4), scale);
+            a = vminq_f32(vmaxq_f32(a, min_value), max_value);
+            b = vminq_f32(vmaxq_f32(b, min_value), max_value);
+            vst1q_s16(out + i, vcombine_s16(vqmovn_s32(vcvtq_s32_f32(a)), vqmovn_s32(vcvtq_s32_f32(b))));
+        }
+        for (; i < count; ++i) {
+            out[i] = static_cast<int16_t>(std::clamp(in[i] * 32768.0f, -32768.0f, 32767.0f));
+        }
+    }
+
+    float dot_neon(const float* a, const float* b, size_t count) {
+        float32x4_t acc0 = vdupq_n_f32(0.0f);
+        float32x4_t acc1 = vdupq_n_f32(0.0f);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            acc0 = vaddq_f32(acc0, vmulq_f32(vld1q_f32(a + i), vld1q_f32(b + i)));
+            acc1 = vaddq_f32(acc1, vmulq_f32(vld1q_f32(a + i + 4), vld1q_f32(b + i + 4)));
+        }
+        float sum = vaddvq_f32(vaddq_f32(acc0, acc1));
+        for (; i < count; ++i) {
+            sum += a[i] * b[i];
+        }
+        return sum;
+    }
+
+    void axpy_neon(float alpha, const float* x, float* y, size_t count) {
+        const float32x4_t va = vdupq_n_f32(alpha);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            vst1q_f32(y + i, vaddq_f32(vld1q_f32(y + i), vmulq_f32(va, vld1q_f32(x + i))));
+        }
+        for (; i < count; ++i) {
+            y[i] += alpha * x[i];
+        }
+    }
+
+    void multiply_neon(const float* a, const float* b, float* out, size_t count) {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            vst1q_f32(out + i, vmulq_f32(vld1q_f32(a + i), vld1q_f32(b + i)));
+        }
+        for (; i < count; ++i) {
+            out[i] = a[i] * b[i];
+        }
+    }
+
+    void multiply_accumulate_neon(const float* a, const float* b, float* y, size_t count) {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            vst1q_f32(y + i, vaddq_f32(vld1q_f32(y + i), vmulq_f32(vld1q_f32(a + i), vld1q_f32(b + i))));
+        }
+        for (; i < count; ++i) {
+            y[i] += a[i] * b[i];
+        }
+    }
+
+    float sum_squares_int16_neon(const int16_t* in, size_t count) {
+        float32x4_t acc0 = vdupq_n_f32(0.0f);
+        float32x4_t acc1 = vdupq_n_f32(0.0f);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const int16x8_t samples = vld1q_s16(in + i);
+            const float32x4_t low = vcvtq_f32_s32(vmovl_s16(vget_low_s16(samples)));
+            const float32x4_t high = vcvtq_f32_s32(vmovl_s16(vget_high_s16(samples)));
+            acc0 = vaddq_f32(acc0, vmulq_f32(low, low));
+            acc1 = vaddq_f32(acc1, vmulq_f32(high, high));
+        }
+        float sum = vaddvq_f32(vaddq_f32(acc0, acc1));
+        for (; i < count; ++i) {
+            const float sample = static_cast<float>(in[i]);
+            sum += sample * sample;
+        }
+        return sum;
+    }
+
+    void apply_gain_neon(std::complex<float>* bins, const float* gains, size_t count) {
+        float* data = reinterpret_cast<float*>(bins);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const float32x4_t g = vld1q_f32(gains + i);
+            const float32x4x2_t zipped = vzipq_f32(g, g); // g0 g0 g1 g1 | g2 g2 g3 g3
+            vst1q_f32(data + 2 * i, vmulq_f32(vld1q_f32(data + 2 * i), zipped.val[0]));
+            vst1q_f32(data + 2 * i + 4, vmulq_f32(vld1q_f32(data + 2 * i + 4), zipped.val[1]));
+        }
+        for (; i < count; ++i) {
+            bins[i] *= gains[i];
+        }
+    }
+
+    void complex_multiply_accumulate_neon(const std::complex<float>* a, const std::complex<float>* b,
+                                          std::complex<float>* y, size_t count) {
+        const float* pa = reinterpret_cast<const float*>(a);
+        const float* pb = reinterpret_cast<const float*>(b);
+        float* py = reinterpret_cast<float*>(y);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            // vld2q gerçek ve sanal kısımları ayrı vektörlere açar
+            const float32x4x2_t va = vld2q_f32(pa + 2 * i);
+            const float32x4x2_t vb = vld2q_f32(pb + 2 * i);
+            float32x4x2_t vy = vld2q_f32(py + 2 * i);
+            vy.val[0] = vaddq_f32(vy.val[0], vsubq_f32(vmulq_f32(va.val[0], vb.val[0]), vmulq_f32(va.val[1], vb.val[1])));
+            vy.val[1] = vaddq_f32(vy.val[1], vaddq_f32(vmulq_f32(va.val[0], vb.val[1]), vmulq_f32(va.val[1], vb.val[0])));
+            vst2q_f32(py + 2 * i, vy);
+        }
+        for (; i < count; ++i) {
+            y[i] = {y[i].real() + (a[i].real() * b[i].real() - a[i].imag() * b[i].imag()),
+                    y[i].imag() + (a[i].real() * b[i].imag() + a[i].imag() * b[i].real())};
+        }
+    }
+
+    void complex_conj_multiply_accumulate_neon(const std::complex<float>* a, const std::complex<float>* b,
+                                               std::complex<float>* y, size_t count) {
+        const float* pa = reinterpret_cast<const float*>(a);
+        const float* pb = reinterpret_cast<const float*>(b);
+        float* py = reinterpret_cast<float*>(y);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const float32x4x2_t va = vld2q_f32(pa + 2 * i);
+            const float32x4x2_t vb = vld2q_f32(pb + 2 * i);
+            float32x4x2_t vy = vld2q_f32(py + 2 * i);
+            vy.val[0] = vaddq_f32(vy.val[0], vaddq_f32(vmulq_f32(va.val[0], vb.val[0]), vmulq_f32(va.val[1], vb.val[1])));
+            vy.val[1] = vaddq_f32(vy.val[1], vsubq_f32(vmulq_f32(va.val[0], vb.val[1]), vmulq_f32(va.val[1], vb.val[0])));
+            vst2q_f32(py + 2 * i, vy);
+        }
+        for (; i < count; ++i) {
+            y[i] = {y[i].real() + (a[i].real() * b[i].real() + a[i].imag() * b[i].imag()),
+                    y[i].imag() + (a[i].real() * b[i].imag() - a[i].imag() * b[i].real())};
+        }
+    }
+
+    void norm_accumulate_neon(const std::complex<float>* in, float* out, size_t count) {
+        const float* data = reinterpret_cast<const float*>(in);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const float32x4x2_t v = vld2q_f32(data + 2 * i);
+            const float32x4_t norms = vaddq_f32(vmulq_f32(v.val[0], v.val[0]), vmulq_f32(v.val[1], v.val[1]));
+            vst1q_f32(out + i, vaddq_f32(vld1q_f32(out + i), norms));
+        }
+        for (; i < count; ++i) {
+            out[i] += in[i].real() * in[i].real() + in[i].imag() * in[i].imag();
+        }
+    }
+
+    void xor_bytes_neon(const uint8_t* in, uint8_t* out, size_t count) {
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            vst1q_u8(out + i, veorq_u8(vld1q_u8(out + i), vld1q_u8(in + i)));
+        }
+        for (; i < count; ++i) {
+            out[i] ^= in[i];
+        }
+    }
+
+    void gf256_multiply_add_neon(const uint8_t* tables, const uint8_t* in, uint8_t* out, size_t count) {
+        const uint8x16_t low_table = vld1q_u8(tables);
+        const uint8x16_t high_table = vld1q_u8(tables + 16);
+        const uint8x16_t nibble = vdupq_n_u8(0x0F);
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            const uint8x16_t x = vld1q_u8(in + i);
+            const uint8x16_t low = vqtbl1q_u8(low_table, vandq_u8(x, nibble));
+            const uint8x16_t high = vqtbl1q_u8(high_table, vshrq_n_u8(x, 4));
+            vst1q_u8(out + i, veorq_u8(vld1q_u8(out + i), veorq_u8(low, high)));
+        }
+        for (; i < count; ++i) {
+            out[i] ^= tables[in[i] & 0x0F] ^ tables[16 + (in[i] >> 4)];
+        }
+    }
+}
+
+namespace detail {
+    const KernelTable& neon_kernels() {
+        static const KernelTable table = {
+            int16_to_float_neon,
+            float_to_int16_neon,
+            dot_neon,
+            axpy_neon,
+            multiply_neon,
+            multiply_accumulate_neon,
+            sum_squares_int16_neon,
+            apply_gain_neon,
+            complex_multiply_accumulate_neon,
+            complex_conj_multiply_accumulate_neon,
+            norm_accumulate_neon,
+            xor_bytes_neon,
+            gf256_multiply_add_neon
+        };
+        return table;
+    }
+}
+
+}
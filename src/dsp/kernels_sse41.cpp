@@ -0,0 +1,239 @@
+// SSE4.1 kernelleri. Bu dosya -msse4.1 ile derlenir; sadece CPU desteklediğinde çağrılır.
+#include "dsp/kernels.hpp"
+#include <smmintrin.h>
+#include <algorithm>
+
+namespace dsp {
+
+namespace {
+    float horizontal_sum(__m128 v) {
+        __m128 shuffled = _mm_movehdup_ps(v);
+        __m128 sums = _mm_add_ps(v, shuffled);
+        shuffled = _mm_movehl_ps(shuffled, sums);
+        sums = _mm_add_ss(sums, shuffled);
+        return _mm_cvtss_f32(sums);
+    }
+
+    void int16_to_float_sse41(const int16_t* in, float* out, size_t count) {
+        const __m128 scale = _mm_set1_ps(1.0f / 32768.0f);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            const __m128i low = _mm_cvtepi16_epi32(samples);
+            const __m128i high = _mm_cvtepi16_epi32(_mm_srli_si128(samples, 8));
+            _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(low), scale));
+            _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+        }
+        for (; i < count; ++i) {
+            out[i] = static_cast<float>(in[i]) / 32768.0f;
+        }
+    }
+
+    void float_to_int16_sse41(const float* in, int16_t* out, size_t count) {
+        const __m128 scale = _mm_set1_ps(32768.0f);
+        const __m128 min_value = _mm_set1_ps(-32768.0f);
+        const __m128 max_value = _mm_set1_ps(32767.0f);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m128 a = _mm_mul_ps(_mm_loadu_ps(in + i), scale);
+            __m128 b = _mm_mul_ps(_mm_loadu_ps(in + i + 4), scale);
+            a = _mm_min_ps(_mm_max_ps(a, min_value), max_value);
+            b = _mm_min_ps(_mm_max_ps(b, min_value), max_value);
+            const __m128i packed = _mm_packs_epi32(_mm_cvttps_epi32(a), _mm_cvttps_epi32(b));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
+        }
+        for (; i < count; ++i) {
+            out[i] = static_cast<int16_t>(std::clamp(in[i] * 32768.0f, -32768.0f, 32767.0f));
+        }
+    }
+
+    float dot_sse41(const float* a, const float* b, size_t count) {
+        __m128 acc0 = _mm_setzero_ps();
+        __m128 acc1 = _mm_setzero_ps();
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+        }
+        float sum = horizontal_sum(_mm_add_ps(acc0, acc1));
+        for (; i < count; ++i) {
+            sum += a[i] * b[i];
+        }
+        return sum;
+    }
+
+    void axpy_sse41(float alpha, const float* x, float* y, size_t count) {
+        const __m128 va = _mm_set1_ps(alpha);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(va, _mm_loadu_ps(x + i))));
+        }
+        for (; i < count; ++i) {
+            y[i] += alpha * x[i];
+        }
+    }
+
+    void multiply_sse41(const float* a, const float* b, float* out, size_t count) {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            _mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        }
+        for (; i < count; ++i) {
+            out[i] = a[i] * b[i];
+        }
+    }
+
+    void multiply_accumulate_sse41(const float* a, const float* b, float* y, size_t count) {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const __m128 product = _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i));
+            _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), product));
+        }
+        for (; i < count; ++i) {
+            y[i] += a[i] * b[i];
+        }
+    }
+
+    float sum_squares_int16_sse41(const int16_t* in, size_t count) {
+        __m128 acc0 = _mm_setzero_ps();
+        __m128 acc1 = _mm_setzero_ps();
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            const __m128 low = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(samples));
+            const __m128 high = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(_mm_srli_si128(samples, 8)));
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(low, low));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(high, high));
+        }
+        float sum = horizontal_sum(_mm_add_ps(acc0, acc1));
+        for (; i < count; ++i) {
+            const float sample = static_cast<float>(in[i]);
+            sum += sample * sample;
+        }
+        return sum;
+    }
+
+    void apply_gain_sse41(std::complex<float>* bins, const float* gains, size_t count) {
+        float* data = reinterpret_cast<float*>(bins);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const __m128 g = _mm_loadu_ps(gains + i);
+            const __m128 g_low = _mm_unpacklo_ps(g, g);   // g0 g0 g1 g1
+            const __m128 g_high = _mm_unpackhi_ps(g, g);  // g2 g2 g3 g3
+            _mm_storeu_ps(data + 2 * i, _mm_mul_ps(_mm_loadu_ps(data + 2 * i), g_low));
+            _mm_storeu_ps(data + 2 * i + 4, _mm_mul_ps(_mm_loadu_ps(data + 2 * i + 4), g_high));
+        }
+        for (; i < count; ++i) {
+            bins[i] *= gains[i];
+        }
+    }
+
+    void complex_multiply_accumulate_sse41(const std::complex<float>* a, const std::complex<float>* b,
+                                           std::complex<float>* y, size_t count) {
+        const float* pa = reinterpret_cast<const float*>(a);
+        const float* pb = reinterpret_cast<const float*>(b);
+        float* py = reinterpret_cast<float*>(y);
+        size_t i = 0;
+        for (; i + 2 <= count; i += 2) {
+            const __m128 va = _mm_loadu_ps(pa + 2 * i);
+            const __m128 vb = _mm_loadu_ps(pb + 2 * i);
+            // [ar·br, ar·bi] -/+ [ai·bi, ai·br]
+            const __m128 ar_b = _mm_mul_ps(_mm_moveldup_ps(va), vb);
+            const __m128 ai_b = _mm_mul_ps(_mm_movehdup_ps(va), _mm_shuffle_ps(vb, vb, _MM_SHUFFLE(2, 3, 0, 1)));
+            _mm_storeu_ps(py + 2 * i, _mm_add_ps(_mm_loadu_ps(py + 2 * i), _mm_addsub_ps(ar_b, ai_b)));
+        }
+        for (; i < count; ++i) {
+            y[i] = {y[i].real() + (a[i].real() * b[i].real() - a[i].imag() * b[i].imag()),
+                    y[i].imag() + (a[i].real() * b[i].imag() + a[i].imag() * b[i].real())};
+        }
+    }
+
+    void complex_conj_multiply_accumulate_sse41(const std::complex<float>* a, const std::complex<float>* b,
+                                                std::complex<float>* y, size_t count) {
+        const float* pa = reinterpret_cast<const float*>(a);
+        const float* pb = reinterpret_cast<const float*>(b);
+        float* py = reinterpret_cast<float*>(y);
+        const __m128 sign = _mm_set1_ps(-0.0f);
+        size_t i = 0;
+        for (; i + 2 <= count; i += 2) {
+            const __m128 va = _mm_loadu_ps(pa + 2 * i);
+            const __m128 vb = _mm_loadu_ps(pb + 2 * i);
+            // [ar·br, ar·bi] +/- [ai·bi, ai·br]: addsub işaretleri çevrilmiş terimle
+            const __m128 ar_b = _mm_mul_ps(_mm_moveldup_ps(va), vb);
+            const __m128 ai_b = _mm_mul_ps(_mm_movehdup_ps(va), _mm_shuffle_ps(vb, vb, _MM_SHUFFLE(2, 3, 0, 1)));
+            _mm_storeu_ps(py + 2 * i, _mm_add_ps(_mm_loadu_ps(py + 2 * i), _mm_addsub_ps(ar_b, _mm_xor_ps(ai_b, sign))));
+        }
+        for (; i < count; ++i) {
+            y[i] = {y[i].real() + (a[i].real() * b[i].real() + a[i].imag() * b[i].imag()),
+                    y[i].imag() + (a[i].real() * b[i].imag() - a[i].imag() * b[i].real())};
+        }
+    }
+
+    void norm_accumulate_sse41(const std::complex<float>* in, float* out, size_t count) {
+        const float* data = reinterpret_cast<const float*>(in);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const __m128 low = _mm_loadu_ps(data + 2 * i);
+            const __m128 high = _mm_loadu_ps(data + 2 * i + 4);
+            // Komşu re², im² çiftlerinin toplamı
+            const __m128 norms = _mm_hadd_ps(_mm_mul_ps(low, low), _mm_mul_ps(high, high));
+            _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), norms));
+        }
+        for (; i < count; ++i) {
+            out[i] += in[i].real() * in[i].real() + in[i].imag() * in[i].imag();
+        }
+    }
+
+    void xor_bytes_sse41(const uint8_t* in, uint8_t* out, size_t count) {
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(out + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_xor_si128(a, b));
+        }
+        for (; i < count; ++i) {
+            out[i] ^= in[i];
+        }
+    }
+
+    // Yarım byte tabloları pshufb ile 16 byte'a aynı anda uygulanır
+    void gf256_multiply_add_sse41(const uint8_t* tables, const uint8_t* in, uint8_t* out, size_t count) {
+        const __m128i low_table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables));
+        const __m128i high_table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables + 16));
+        const __m128i nibble = _mm_set1_epi8(0x0F);
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            const __m128i low = _mm_shuffle_epi8(low_table, _mm_and_si128(x, nibble));
+            const __m128i high = _mm_shuffle_epi8(high_table, _mm_and_si128(_mm_srli_epi64(x, 4), nibble));
+            const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(out + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_xor_si128(y, _mm_xor_si128(low, high)));
+        }
+        for (; i < count; ++i) {
+            out[i] ^= tables[in[i] & 0x0F] ^ tables[16 + (in[i] >> 4)];
+        }
+    }
+}
+
+namespace detail {
+    const KernelTable& sse41_kernels() {
+        static const KernelTable table = {
+            int16_to_float_sse41,
+            float_to_int16_sse41,
+            dot_sse41,
+            axpy_sse41,
+            multiply_sse41,
+            multiply_accumulate_sse41,
+            sum_squares_int16_sse41,
+            apply_gain_sse41,
+            complex_multiply_accumulate_sse41,
+            complex_conj_multiply_accumulate_sse41,
+            norm_accumulate_sse41,
+            xor_bytes_sse41,
+            gf256_multiply_add_sse41
+        };
+        return table;
+    }
+}
+
+}
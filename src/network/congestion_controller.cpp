@@ -0,0 +1,277 @@
+#include "network/congestion_controller.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace network {
+
+namespace {
+    constexpr size_t MAX_DELTA_COUNT = 1000;
+    constexpr size_t TREND_DELTA_CAP = 60;          // Eğim ölçeği bu kadar gruptan sonra sabitlenir
+    constexpr double THRESHOLD_SPIKE = 15.0;        // Eşikten bu kadar uzak sıçramalar eşiği taşımaz
+    constexpr double MIN_THRESHOLD = 6.0;
+    constexpr double MAX_THRESHOLD = 600.0;
+    constexpr double MAX_THRESHOLD_STEP_MS = 100.0;
+    constexpr double BASE_RESPONSE_TIME_MS = 100.0;
+    constexpr double MIN_INCREASE_BPS = 1000.0;
+    constexpr double ACKED_RATE_MARGIN_BPS = 10000.0;
+    constexpr double CAPACITY_SMOOTHING = 0.05;
+    constexpr double MIN_CAPACITY_VARIANCE = 0.4;
+    constexpr double MAX_CAPACITY_VARIANCE = 2.5;
+
+    int64_t to_us(DelayBasedController::Clock::time_point time) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+    }
+}
+
+DelayBasedController::DelayBasedController(const Options& options)
+    : options_(options),
+      target_bps_(std::clamp(options.start_bitrate_bps, options.min_bitrate_bps, options.max_bitrate_bps)) {}
+
+void DelayBasedController::on_packet_sent(uint32_t sequence_number, size_t wire_bytes, Clock::time_point now) {
+    SentPacket& sent = history_[sequence_number % HISTORY_SIZE];
+    if (sent.valid && sent.sequence_number == sequence_number) {
+        sent.wire_bytes += wire_bytes;
+        return;
+    }
+    sent.sequence_number = sequence_number;
+    sent.valid = true;
+    sent.send_us = to_us(now);
+    sent.wire_bytes = wire_bytes;
+}
+
+bool DelayBasedController::on_feedback(const PacketArrival* arrivals, size_t count, Clock::time_point now) {
+    int64_t latest_send_us = -1;
+    for (size_t i = 0; i < count; ++i) {
+        const PacketArrival& arrival = arrivals[i];
+        SentPacket& sent = history_[arrival.sequence_number % HISTORY_SIZE];
+        if (!sent.valid || sent.sequence_number != arrival.sequence_number) {
+            continue;  // Kayıttan düşmüş veya tekrar bildirilen paket
+        }
+        sent.valid = false;
+        latest_send_us = std::max(latest_send_us, sent.send_us);
+        update_acked_rate(arrival.arrival_us, sent.wire_bytes);
+
+        // Paketler gönderim zamanına göre gruplanır; bir gruptaki gecikme son paketinden ölçülür
+        if (!current_group_.valid) {
+            current_group_ = {true, sent.send_us, sent.send_us, arrival.arrival_us};
+            continue;
+        }
+        if (sent.send_us < current_group_.first_send_us) {
+            continue;  // Önceki gruba ait sıra dışı geliş
+        }
+        if (sent.send_us - current_group_.first_send_us <= BURST_US) {
+            current_group_.last_send_us = std::max(current_group_.last_send_us, sent.send_us);
+            current_group_.last_arrival_us = std::max(current_group_.last_arrival_us, arrival.arrival_us);
+            continue;
+        }
+        if (previous_group_.valid) {
+            const double send_delta_ms = (current_group_.last_send_us - previous_group_.last_send_us) / 1000.0;
+            const double arrival_delta_ms = (current_group_.last_arrival_us - previous_group_.last_arrival_us) / 1000.0;
+            on_group_delta(arrival_delta_ms - send_delta_ms, send_delta_ms, current_group_.last_arrival_us);
+        }
+        previous_group_ = current_group_;
+        current_group_ = {true, sent.send_us, sent.send_us, arrival.arrival_us};
+    }
+    if (latest_send_us < 0) {
+        return false;
+    }
+
+    // Yanıt süresi: geri bildirim en yeni paketin gönderiminden bu yana geçen süre (RTT ve
+    // raporlama aralığı) ile bir düzeltme payı
+    const int64_t now_us = to_us(now);
+    const double response_time_ms = BASE_RESPONSE_TIME_MS + (now_us - latest_send_us) / 1000.0;
+    const int previous = target_bitrate_bps();
+    update_target(now_us, response_time_ms);
+    return target_bitrate_bps() != previous;
+}
+
+void DelayBasedController::on_group_delta(double delay_delta_ms, double send_delta_ms, int64_t arrival_us) {
+    delta_count_ = std::min(delta_count_ + 1, MAX_DELTA_COUNT);
+    if (!has_first_arrival_) {
+        has_first_arrival_ = true;
+        first_arrival_us_ = arrival_us;
+    }
+    accumulated_delay_ms_ += delay_delta_ms;
+    smoothed_delay_ms_ = TRENDLINE_SMOOTHING * smoothed_delay_ms_ + (1.0 - TRENDLINE_SMOOTHING) * accumulated_delay_ms_;
+
+    const double arrival_ms = (arrival_us - first_arrival_us_) / 1000.0;
+    if (window_size_ == TRENDLINE_WINDOW) {
+        window_start_ = (window_start_ + 1) % TRENDLINE_WINDOW;
+        --window_size_;
+    }
+    window_[(window_start_ + window_size_) % TRENDLINE_WINDOW] = {arrival_ms, smoothed_delay_ms_};
+    ++window_size_;
+
+    if (window_size_ == TRENDLINE_WINDOW) {
+        // Yumuşatılmış gecikmenin geliş zamanına göre eğimi (en küçük kareler)
+        double mean_x = 0.0;
+        double mean_y = 0.0;
+        for (const auto& point : window_) {
+            mean_x += point.first;
+            mean_y += point.second;
+        }
+        mean_x /= TRENDLINE_WINDOW;
+        mean_y /= TRENDLINE_WINDOW;
+        double numerator = 0.0;
+        double denominator = 0.0;
+        for (const auto& point : window_) {
+            numerator += (point.first - mean_x) * (point.second - mean_y);
+            denominator += (point.first - mean_x) * (point.first - mean_x);
+        }
+        if (denominator > 0.0) {
+            modified_trend_ = static_cast<double>(std::min(delta_count_, TREND_DELTA_CAP)) *
+                              (numerator / denominator) * TRENDLINE_GAIN;
+        }
+    }
+    detect(send_delta_ms, arrival_us);
+}
+
+void DelayBasedController::detect(double send_delta_ms, int64_t arrival_us) {
+    if (delta_count_ < 2) {
+        usage_ = BandwidthUsage::Normal;
+        return;
+    }
+    const double trend = modified_trend_;
+    if (trend > threshold_) {
+        time_over_using_ms_ = time_over_using_ms_ < 0.0 ? send_delta_ms / 2.0 : time_over_using_ms_ + send_delta_ms;
+        ++overuse_count_;
+        // Tek bir geç grup yetmez: eşik bir süre aşılmalı ve eğim hâlâ artıyor olmalı
+        if (time_over_using_ms_ > OVERUSE_TIME_MS && overuse_count_ > 1 && trend >= previous_trend_) {
+            time_over_using_ms_ = 0.0;
+            overuse_count_ = 0;
+            usage_ = BandwidthUsage::Overusing;
+        }
+    } else if (trend < -threshold_) {
+        time_over_using_ms_ = -1.0;
+        overuse_count_ = 0;
+        usage_ = BandwidthUsage::Underusing;
+    } else {
+        time_over_using_ms_ = -1.0;
+        overuse_count_ = 0;
+        usage_ = BandwidthUsage::Normal;
+    }
+    previous_trend_ = trend;
+    update_threshold(trend, arrival_us);
+}
+
+void DelayBasedController::update_threshold(double modified_trend, int64_t arrival_us) {
+    if (last_threshold_update_us_ < 0) {
+        last_threshold_update_us_ = arrival_us;
+    }
+    const double magnitude = std::fabs(modified_trend);
+    if (magnitude > threshold_ + THRESHOLD_SPIKE) {
+        last_threshold_update_us_ = arrival_us;
+        return;
+    }
+    // Eşik eğimin büyüklüğünü izler: altındayken hızlı iner, üstündeyken yavaş çıkar;
+    // böylece eş zamanlı TCP akışları karşısında gecikme tabanlı akış aç kalmaz
+    const double rate = magnitude < threshold_ ? THRESHOLD_DOWN : THRESHOLD_UP;
+    const double elapsed_ms = std::min((arrival_us - last_threshold_update_us_) / 1000.0, MAX_THRESHOLD_STEP_MS);
+    threshold_ = std::clamp(threshold_ + rate * (magnitude - threshold_) * elapsed_ms, MIN_THRESHOLD, MAX_THRESHOLD);
+    last_threshold_update_us_ = arrival_us;
+}
+
+void DelayBasedController::update_acked_rate(int64_t arrival_us, size_t wire_bytes) {
+    if (acked_size_ == acked_.size()) {
+        acked_bytes_ -= acked_[acked_start_].wire_bytes;
+        acked_start_ = (acked_start_ + 1) % acked_.size();
+        --acked_size_;
+    }
+    acked_[(acked_start_ + acked_size_) % acked_.size()] = {arrival_us, wire_bytes};
+    ++acked_size_;
+    acked_bytes_ += wire_bytes;
+    if (!has_acked_start_) {
+        has_acked_start_ = true;
+        acked_start_us_ = arrival_us;
+    }
+
+    while (acked_size_ > 0 && acked_[acked_start_].arrival_us <= arrival_us - ACKED_RATE_WINDOW_US) {
+        acked_bytes_ -= acked_[acked_start_].wire_bytes;
+        acked_start_ = (acked_start_ + 1) % acked_.size();
+        --acked_size_;
+    }
+    // Pencere dolana kadar hız bilinmiyor sayılır
+    if (arrival_us - acked_start_us_ >= ACKED_RATE_WINDOW_US) {
+        acked_bps_ = acked_bytes_ * 8.0 * 1e6 / ACKED_RATE_WINDOW_US;
+    }
+}
+
+void DelayBasedController::update_target(int64_t now_us, double response_time_ms) {
+    const double elapsed_ms = has_rate_update_
+        ? std::clamp((now_us - last_rate_update_us_) / 1000.0, 0.0, 1000.0) : 0.0;
+    has_rate_update_ = true;
+    last_rate_update_us_ = now_us;
+
+    switch (usage_) {
+        case BandwidthUsage::Normal:
+            if (rate_state_ == RateState::Hold) {
+                rate_state_ = RateState::Increase;
+            }
+            break;
+        case BandwidthUsage::Overusing:
+            rate_state_ = RateState::Decrease;
+            break;
+        case BandwidthUsage::Underusing:
+            rate_state_ = RateState::Hold;
+            break;
+    }
+
+    const double capacity_deviation = std::sqrt(link_capacity_variance_ * link_capacity_bps_);
+    if (link_capacity_bps_ > 0.0 && acked_bps_ > link_capacity_bps_ + 3.0 * capacity_deviation) {
+        link_capacity_bps_ = 0.0;  // Kapasite arttı: tahmin geçersiz
+    }
+
+    switch (rate_state_) {
+        case RateState::Hold:
+            break;
+        case RateState::Increase: {
+            double increase = 0.0;
+            if (link_capacity_bps_ > 0.0) {
+                // Kapasiteye yakın: yanıt süresi başına ortalama bir paket
+                const double packet_bits = acked_size_ > 0 ? acked_bytes_ * 8.0 / acked_size_ : 0.0;
+                increase = std::max(MIN_INCREASE_BPS, packet_bits) * elapsed_ms / response_time_ms;
+            } else {
+                increase = std::max(MIN_INCREASE_BPS * elapsed_ms / 1000.0,
+                                    target_bps_ * (std::pow(1.0 + INCREASE_PER_SECOND, elapsed_ms / 1000.0) - 1.0));
+            }
+            double increased = target_bps_ + increase;
+            if (acked_bps_ > 0.0) {
+                increased = std::min(increased, ACKED_RATE_HEADROOM * acked_bps_ + ACKED_RATE_MARGIN_BPS);
+            }
+            target_bps_ = std::max(target_bps_, increased);
+            break;
+        }
+        case RateState::Decrease: {
+            // Yanıt süresi dolmadan tekrar düşülmez: önceki düşüşün etkisi henüz görünmedi
+            const double since_decrease_ms = (now_us - last_decrease_us_) / 1000.0;
+            if (has_decrease_ && since_decrease_ms < std::clamp(response_time_ms, 10.0, 200.0) &&
+                acked_bps_ >= 0.5 * target_bps_) {
+                rate_state_ = RateState::Hold;
+                break;
+            }
+            has_decrease_ = true;
+            last_decrease_us_ = now_us;
+            const double base_bps = acked_bps_ > 0.0 ? acked_bps_ : target_bps_;
+            target_bps_ = std::min(target_bps_, DECREASE_FACTOR * base_bps);
+
+            if (acked_bps_ > 0.0) {
+                if (link_capacity_bps_ <= 0.0) {
+                    link_capacity_bps_ = acked_bps_;
+                } else {
+                    link_capacity_bps_ += CAPACITY_SMOOTHING * (acked_bps_ - link_capacity_bps_);
+                }
+                const double normalized_error = (link_capacity_bps_ - acked_bps_) * (link_capacity_bps_ - acked_bps_) /
+                                                std::max(link_capacity_bps_, 1.0);
+                link_capacity_variance_ = std::clamp(
+                    (1.0 - CAPACITY_SMOOTHING) * link_capacity_variance_ + CAPACITY_SMOOTHING * normalized_error,
+                    MIN_CAPACITY_VARIANCE, MAX_CAPACITY_VARIANCE);
+            }
+            rate_state_ = RateState::Hold;
+            break;
+        }
+    }
+    target_bps_ = std::clamp(target_bps_, static_cast<double>(options_.min_bitrate_bps),
+                             static_cast<double>(options_.max_bitrate_bps));
+}
+
+}
@@ -0,0 +1,166 @@
+#include "network/event_loop.hpp"
+
+#ifdef VOICE_ENGINE_HAVE_EPOLL
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <iostream>
+#include <stdexcept>
+#include <cstdio>
+#include <cerrno>
+
+namespace network {
+EventLoop::EventLoop() {
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_fd_ < 0 || wake_fd_ < 0) {
+        if (epoll_fd_ >= 0) { close(epoll_fd_); }
+        if (wake_fd_ >= 0) { close(wake_fd_); }
+        throw std::runtime_error("EventLoop: epoll/eventfd olusturulamadi.");
+    }
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = wake_fd_;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &event) < 0) {
+        close(epoll_fd_);
+        close(wake_fd_);
+        throw std::runtime_error("EventLoop: eventfd kaydedilemedi.");
+    }
+}
+
+EventLoop::~EventLoop() {
+    stop();
+    close(epoll_fd_);
+    close(wake_fd_);
+}
+
+bool EventLoop::add(int fd, Handler on_readable) {
+    auto registration = std::make_shared<Registration>(Registration{fd, std::move(on_readable)});
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!registrations_.emplace(fd, registration).second) {
+            return false;
+        }
+    }
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLET;
+    event.data.fd = fd;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+        std::perror("epoll_ctl");
+        std::lock_guard<std::mutex> lock(mutex_);
+        registrations_.erase(fd);
+        return false;
+    }
+    return true;
+}
+
+void EventLoop::remove(int fd) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (registrations_.erase(fd) == 0) {
+        return;
+    }
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+
+    // Döngü bu fd'nin handler'ını şu an çalıştırıyor olabilir; mevcut tur bitene kadar bekle
+    if (running_ && loop_thread_id_.load() != std::this_thread::get_id()) {
+        const uint64_t target = iteration_ + 1;
+        wake();
+        iteration_done_.wait(lock, [&] { return iteration_ >= target || !running_; });
+    }
+}
+
+size_t EventLoop::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return registrations_.size();
+}
+
+void EventLoop::wake() {
+    const uint64_t one = 1;
+    if (write(wake_fd_, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+        std::perror("eventfd write");
+    }
+}
+
+bool EventLoop::start(int cpu) {
+    if (running_.exchange(true)) {
+        return true;
+    }
+    thread_ = std::thread(&EventLoop::loop, this);
+
+    if (cpu >= 0) {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(cpu, &cpu_set);
+        const int rc = pthread_setaffinity_np(thread_.native_handle(), sizeof(cpu_set), &cpu_set);
+        if (rc != 0) {
+            std::cerr << "UYARI: Event loop thread'i CPU " << cpu << "'e sabitlenemedi (hata: " << rc << ")" << std::endl;
+        }
+    }
+    return true;
+}
+
+void EventLoop::run() {
+    running_ = true;
+    loop();
+}
+
+void EventLoop::stop() {
+    running_ = false;
+    wake();
+    if (thread_.joinable() && thread_.get_id() != std::this_thread::get_id()) {
+        thread_.join();
+    }
+}
+
+void EventLoop::dispatch(int fd) {
+    std::shared_ptr<Registration> registration;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto it = registrations_.find(fd);
+        if (it == registrations_.end()) {
+            return;  // Bu turda kaldırıldı
+        }
+        registration = it->second;
+    }
+    registration->handler();
+}
+
+void EventLoop::loop() {
+    loop_thread_id_ = std::this_thread::get_id();
+    epoll_event events[MAX_EVENTS];
+    while (running_) {
+        const int count = epoll_wait(epoll_fd_, events, MAX_EVENTS, -1);
+        if (count < 0 && errno != EINTR) {
+            std::perror("epoll_wait");
+            break;
+        }
+        for (int i = 0; i < count && running_; ++i) {
+            if (events[i].data.fd == wake_fd_) {
+                uint64_t value = 0;
+                while (read(wake_fd_, &value, sizeof(value)) > 0) {
+                }
+                continue;
+            }
+            dispatch(events[i].data.fd);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++iteration_;
+        }
+        iteration_done_.notify_all();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+        loop_thread_id_ = std::thread::id();
+    }
+    iteration_done_.notify_all();
+}
+}
+
+#endif
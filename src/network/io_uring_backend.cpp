@@ -0,0 +1,326 @@
+#include "network/io_uring_backend.hpp"
+
+#ifdef VOICE_ENGINE_HAVE_IO_URING
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <iostream>
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+
+namespace network {
+
+namespace {
+    constexpr uint64_t RECEIVE_TAG = 1;
+    constexpr uint64_t WAKE_TAG = 2;
+    constexpr unsigned MAX_RING_BUFFERS = 32768;  // Buffer ID'leri 16 bit
+    constexpr long STARVED_POLL_NS = 1000000;     // Havuz boşken yeniden deneme aralığı (1 ms)
+
+    unsigned round_up_pow2(size_t value) {
+        unsigned result = 1;
+        while (result < value && result < MAX_RING_BUFFERS) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    void report(const char* call, int error) {
+        std::cerr << "HATA: " << call << ": " << std::strerror(error) << std::endl;
+    }
+}
+
+bool io_uring_available() {
+    static const bool available = [] {
+        io_uring ring{};
+        if (io_uring_queue_init(2, &ring, 0) < 0) {
+            return false;
+        }
+        io_uring_queue_exit(&ring);
+        return true;
+    }();
+    return available;
+}
+
+UringSendRing::UringSendRing(size_t batch_size)
+    : batch_size_(std::max<size_t>(1, batch_size)),
+      headers_(batch_size_ * core::PACKET_HEADER_SIZE),
+      messages_(batch_size_),
+      iovecs_(batch_size_ * 2) {
+    const int result = io_uring_queue_init(round_up_pow2(batch_size_), &ring_, 0);
+    if (result < 0) {
+        throw std::runtime_error(std::string("io_uring_queue_init: ") + std::strerror(-result));
+    }
+    for (size_t i = 0; i < batch_size_; ++i) {
+        iovecs_[2 * i].iov_base = header(i);
+        iovecs_[2 * i].iov_len = core::PACKET_HEADER_SIZE;
+        messages_[i] = msghdr{};
+        messages_[i].msg_iov = &iovecs_[2 * i];
+        messages_[i].msg_iovlen = 2;
+    }
+}
+
+UringSendRing::~UringSendRing() {
+    io_uring_queue_exit(&ring_);
+}
+
+int UringSendRing::send(int socket, const sockaddr_in& address, const core::PacketView* packets, size_t count) {
+    size_t prepared = 0;
+    for (size_t i = 0; i < count && prepared < batch_size_; ++i) {
+        const core::PacketView& packet = packets[i];
+        if (packet.wire_size() > core::MAX_DATAGRAM_SIZE) {
+            std::cerr << "HATA: Paket datagram boyutunu asiyor: " << packet.wire_size() << " byte" << std::endl;
+            continue;
+        }
+        packet.write_header(header(prepared));
+        iovecs_[2 * prepared + 1].iov_base = const_cast<uint8_t*>(packet.data);
+        iovecs_[2 * prepared + 1].iov_len = packet.size;
+        messages_[prepared].msg_name = const_cast<sockaddr_in*>(&address);
+        messages_[prepared].msg_namelen = sizeof(address);
+
+        // Ring, batch_size_ girişle kurulduğu için SQE her zaman vardır
+        io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+        io_uring_prep_sendmsg(sqe, socket, &messages_[prepared], 0);
+        io_uring_sqe_set_data64(sqe, prepared);
+        ++prepared;
+    }
+    if (prepared == 0) {
+        return 0;
+    }
+
+    // Tek sistem çağrısı: hazırlananları gönder ve hepsi tamamlanana kadar bekle
+    int result = 0;
+    do {
+        result = io_uring_submit_and_wait(&ring_, static_cast<unsigned>(prepared));
+    } while (result == -EINTR);
+    if (result < 0) {
+        // Gönderilmemiş SQE'ler halkada kalır; çağıran bu ring'i bırakmalıdır
+        report("io_uring_submit", -result);
+        return -1;
+    }
+
+    int sent = 0;
+    size_t completed = 0;
+    while (completed < prepared) {
+        io_uring_cqe* cqe = nullptr;
+        const int wait = io_uring_wait_cqe(&ring_, &cqe);
+        if (wait == -EINTR) {
+            continue;
+        }
+        if (wait < 0) {
+            report("io_uring_wait_cqe", -wait);
+            return -1;
+        }
+        unsigned head = 0;
+        unsigned seen = 0;
+        io_uring_for_each_cqe(&ring_, head, cqe) {
+            if (cqe->res < 0) {
+                // sendmmsg yolu ile aynı: hata raporlanır, paket atılır
+                report("sendmsg", -cqe->res);
+            } else {
+                ++sent;
+            }
+            ++seen;
+        }
+        io_uring_cq_advance(&ring_, seen);
+        completed += seen;
+    }
+    return sent;
+}
+
+UringReceiveRing::UringReceiveRing(int socket, size_t buffer_count, core::BufferPool& pool)
+    : socket_(socket),
+      pool_(pool),
+      buffer_count_(round_up_pow2(std::max<size_t>(2, buffer_count))),
+      buffers_(buffer_count_) {
+    if (pool_.buffer_size() < core::MAX_DATAGRAM_SIZE) {
+        throw std::invalid_argument("UringReceiveRing: havuz buffer'lari datagram icin kucuk");
+    }
+
+    // Multishot alım her datagram için bir CQE üretir; tamamlama kuyruğu halkadaki
+    // tüm buffer'ları karşılayacak kadar büyük tutulur
+    io_uring_params params{};
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = std::max(16u, 2 * buffer_count_);
+    int result = io_uring_queue_init_params(4, &ring_, &params);
+    if (result < 0) {
+        throw std::runtime_error(std::string("io_uring_queue_init: ") + std::strerror(-result));
+    }
+
+    buffer_ring_ = io_uring_setup_buf_ring(&ring_, buffer_count_, BUFFER_GROUP, 0, &result);
+    wake_fd_ = eventfd(0, EFD_CLOEXEC);
+    if (!buffer_ring_ || wake_fd_ < 0) {
+        if (buffer_ring_) {
+            io_uring_free_buf_ring(&ring_, buffer_ring_, buffer_count_, BUFFER_GROUP);
+        }
+        io_uring_queue_exit(&ring_);
+        if (wake_fd_ >= 0) {
+            close(wake_fd_);
+        }
+        throw std::runtime_error("io_uring: buffer halkasi kurulamadi");
+    }
+
+    for (unsigned id = 0; id < buffer_count_; ++id) {
+        if (!provide(static_cast<uint16_t>(id))) {
+            missing_.push_back(static_cast<uint16_t>(id));
+        }
+    }
+    io_uring_buf_ring_advance(buffer_ring_, static_cast<int>(pending_provided_));
+    pending_provided_ = 0;
+    running_ = true;
+}
+
+UringReceiveRing::~UringReceiveRing() {
+    io_uring_free_buf_ring(&ring_, buffer_ring_, buffer_count_, BUFFER_GROUP);
+    io_uring_queue_exit(&ring_);
+    close(wake_fd_);
+}
+
+bool UringReceiveRing::provide(uint16_t id) {
+    core::PooledBuffer& buffer = buffers_[id];
+    if (!buffer || buffer.use_count() > 1) {
+        buffer = pool_.acquire();
+        if (!buffer) {
+            return false;
+        }
+    }
+    io_uring_buf_ring_add(buffer_ring_, buffer.data(), static_cast<unsigned>(buffer.capacity()), id,
+                          io_uring_buf_ring_mask(buffer_count_), static_cast<int>(pending_provided_++));
+    return true;
+}
+
+void UringReceiveRing::refill() {
+    if (!missing_.empty()) {
+        const auto still_missing = std::remove_if(missing_.begin(), missing_.end(),
+                                                  [this](uint16_t id) { return provide(id); });
+        missing_.erase(still_missing, missing_.end());
+    }
+    if (pending_provided_ > 0) {
+        io_uring_buf_ring_advance(buffer_ring_, static_cast<int>(pending_provided_));
+        pending_provided_ = 0;
+    }
+}
+
+void UringReceiveRing::arm_receive() {
+    io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+    io_uring_prep_recvmsg_multishot(sqe, socket_, &receive_message_, 0);
+    sqe->flags |= IOSQE_BUFFER_SELECT;
+    sqe->buf_group = BUFFER_GROUP;
+    io_uring_sqe_set_data64(sqe, RECEIVE_TAG);
+    receive_armed_ = true;
+}
+
+void UringReceiveRing::arm_wakeup() {
+    io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+    io_uring_prep_read(sqe, wake_fd_, &wake_value_, sizeof(wake_value_), 0);
+    io_uring_sqe_set_data64(sqe, WAKE_TAG);
+}
+
+void UringReceiveRing::stop() {
+    running_ = false;
+    const uint64_t one = 1;
+    if (write(wake_fd_, &one, sizeof(one)) < 0) {
+        std::perror("eventfd write");
+    }
+}
+
+bool UringReceiveRing::handle_receive(const io_uring_cqe* cqe, const OnPacketReceived& callback) {
+    if (!(cqe->flags & IORING_CQE_F_MORE)) {
+        receive_armed_ = false;
+    }
+    if (cqe->res < 0) {
+        if (cqe->res == -ENOBUFS) {
+            return true;  // Halka boş: buffer'lar dönünce yeniden kurulur
+        }
+        if (cqe->res == -EINVAL && !receive_armed_) {
+            return false;  // Çekirdek multishot RECVMSG'yi desteklemiyor
+        }
+        if (running_) {
+            report("recvmsg", -cqe->res);
+        }
+        return true;
+    }
+    if (!(cqe->flags & IORING_CQE_F_BUFFER)) {
+        return true;
+    }
+
+    const uint16_t id = static_cast<uint16_t>(cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+    core::PooledBuffer& buffer = buffers_[id];
+    io_uring_recvmsg_out* out = io_uring_recvmsg_validate(buffer.data(), cqe->res, &receive_message_);
+    if (out && !(out->flags & MSG_TRUNC)) {
+        const uint8_t* payload = static_cast<const uint8_t*>(io_uring_recvmsg_payload(out, &receive_message_));
+        const size_t length = io_uring_recvmsg_payload_length(out, cqe->res, &receive_message_);
+        packet_.buffer = std::move(buffer);
+        packet_.buffer.set_size(static_cast<size_t>(cqe->res));
+        packet_.arrival = std::chrono::steady_clock::now();  // Multishot isteğinde kontrol alanı yok
+        if (callback && core::PacketView::parse(payload, length, packet_.view)) {
+            callback(packet_);
+        }
+        buffer = std::move(packet_.buffer);
+    } else {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Buffer halkaya geri verilir (paylaşıldıysa havuzdan yenisiyle)
+    if (!provide(id)) {
+        missing_.push_back(id);
+    }
+    return true;
+}
+
+bool UringReceiveRing::run(const OnPacketReceived& callback) {
+    arm_wakeup();
+    while (running_) {
+        // Multishot istek sonlandıysa (ör. halka boşaldı) en az bir buffer varken yeniden kur
+        if (!receive_armed_ && missing_.size() < buffer_count_) {
+            arm_receive();
+        }
+
+        int result = 0;
+        if (receive_armed_) {
+            result = io_uring_submit_and_wait(&ring_, 1);
+        } else {
+            // Havuz boş: buffer'ların dönmesini kısa aralıklarla bekle
+            io_uring_cqe* cqe = nullptr;
+            __kernel_timespec timeout{0, STARVED_POLL_NS};
+            result = io_uring_submit_and_wait_timeout(&ring_, &cqe, 1, &timeout, nullptr);
+            if (result == -ETIME) {
+                result = 0;
+            }
+        }
+        if (result < 0 && result != -EINTR) {
+            report("io_uring_submit_and_wait", -result);
+            return true;
+        }
+
+        unsigned head = 0;
+        unsigned seen = 0;
+        bool supported = true;
+        io_uring_cqe* cqe = nullptr;
+        io_uring_for_each_cqe(&ring_, head, cqe) {
+            if (io_uring_cqe_get_data64(cqe) == RECEIVE_TAG) {
+                supported = handle_receive(cqe, callback) && supported;
+            }
+            ++seen;
+        }
+        io_uring_cq_advance(&ring_, seen);
+        if (!supported) {
+            return false;
+        }
+        refill();
+    }
+    return true;
+}
+
+}
+
+#else
+
+namespace network {
+bool io_uring_available() {
+    return false;
+}
+}
+
+#endif
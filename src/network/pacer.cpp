@@ -0,0 +1,37 @@
+#include "network/pacer.hpp"
+#include <algorithm>
+
+namespace network {
+
+Pacer::Pacer(double rate_bps, size_t burst_bytes)
+    : rate_bps_(rate_bps),
+      burst_bytes_(static_cast<double>(burst_bytes)),
+      tokens_(static_cast<double>(burst_bytes)) {}
+
+void Pacer::set_rate(double rate_bps) {
+    rate_bps_ = rate_bps;
+}
+
+bool Pacer::can_send(Clock::time_point now) {
+    refill(now);
+    return tokens_ >= 0.0;
+}
+
+Pacer::Clock::time_point Pacer::next_send_time() const {
+    if (tokens_ >= 0.0 || rate_bps_ <= 0.0) {
+        return last_refill_;
+    }
+    const double wait_us = -tokens_ * 8.0 * 1e6 / rate_bps_;
+    return last_refill_ + std::chrono::microseconds(static_cast<int64_t>(wait_us) + 1);
+}
+
+void Pacer::refill(Clock::time_point now) {
+    if (started_ && now > last_refill_) {
+        const double elapsed = std::chrono::duration<double>(now - last_refill_).count();
+        tokens_ = std::min(burst_bytes_, tokens_ + rate_bps_ / 8.0 * elapsed);
+    }
+    started_ = true;
+    last_refill_ = std::max(last_refill_, now);
+}
+
+}
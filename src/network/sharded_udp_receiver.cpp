@@ -0,0 +1,92 @@
+#include "network/sharded_udp_receiver.hpp"
+
+#ifdef VOICE_ENGINE_HAVE_EPOLL
+
+#include <unistd.h>
+#include <iostream>
+#include <algorithm>
+
+namespace network {
+ShardedUdpReceiver::ShardedUdpReceiver(const Options& options)
+    : pin_threads_(options.pin_threads) {
+    const long online = sysconf(_SC_NPROCESSORS_ONLN);
+    const size_t count = options.shards > 0 ? options.shards
+                       : !options.cpus.empty() ? options.cpus.size()
+                       : static_cast<size_t>(std::max(1L, online));
+    const size_t batch_size = std::max<size_t>(1, options.batch_size);
+    const size_t pool_buffers = options.pool_buffers > 0 ? options.pool_buffers : 4 * batch_size;
+
+    shards_.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        auto shard = std::make_unique<Shard>();
+        shard->cpu = i < options.cpus.size() ? options.cpus[i] : static_cast<int>(i % std::max(1L, online));
+        shard->pool = std::make_unique<core::BufferPool>(pool_buffers, core::MAX_DATAGRAM_SIZE);
+        shard->loop = std::make_unique<EventLoop>();
+        shard->receiver = std::make_unique<UdpReceiver>(batch_size, shard->pool.get(), shard->loop.get());
+        shards_.push_back(std::move(shard));
+    }
+}
+
+ShardedUdpReceiver::~ShardedUdpReceiver() {
+    stop();
+}
+
+bool ShardedUdpReceiver::start(int port, OnPacketReceived callback) {
+    if (running_) {
+        return true;
+    }
+    on_packet_received_ = std::move(callback);
+
+    // Soket grubu başlamadan önce tamamlanır; grup değişirse akışların hash'i yeniden dağılır
+    for (size_t i = 0; i < shards_.size(); ++i) {
+        Shard& shard = *shards_[i];
+        UdpReceiver::SocketOptions socket_options;
+        socket_options.reuse_port = true;
+        socket_options.incoming_cpu = pin_threads_ ? shard.cpu : -1;
+        const bool started = shard.receiver->start(port, [this, i, &shard](const core::PooledPacket& packet) {
+            // Tek yazıcı: sadece bu shard'ın thread'i
+            shard.received.store(shard.received.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            on_packet_received_(i, packet);
+        }, socket_options);
+        if (!started) {
+            std::cerr << "HATA: Shard " << i << " " << port << " portunda baslatilamadi." << std::endl;
+            for (size_t j = 0; j < i; ++j) {
+                shards_[j]->receiver->stop();
+            }
+            return false;
+        }
+    }
+
+    for (auto& shard : shards_) {
+        shard->loop->start(pin_threads_ ? shard->cpu : -1);
+    }
+    running_ = true;
+    std::cout << "Sharded receiver " << port << " portunda " << shards_.size() << " shard ile basladi." << std::endl;
+    return true;
+}
+
+void ShardedUdpReceiver::stop() {
+    if (!running_) {
+        return;
+    }
+    for (auto& shard : shards_) {
+        shard->loop->stop();
+    }
+    for (auto& shard : shards_) {
+        shard->receiver->stop();
+    }
+    running_ = false;
+}
+
+ShardStats ShardedUdpReceiver::stats(size_t shard) const {
+    const Shard& source = *shards_[shard];
+    ShardStats stats;
+    stats.cpu = pin_threads_ ? source.cpu : -1;
+    stats.received = source.received.load(std::memory_order_relaxed);
+    stats.dropped = source.receiver->dropped();
+    stats.pool = source.pool->stats();
+    return stats;
+}
+}
+
+#endif
@@ -1,14 +1,101 @@
 #include "network/udp_receiver.hpp"
+#include "network/event_loop.hpp"
+#include "network/io_uring_backend.hpp"
 #include <iostream>
 #include <stdexcept>
 #include <vector>
 #include <cstdio>
+#include <cerrno>
+#include <algorithm>
+#include <chrono>
+#ifdef VOICE_ENGINE_HAVE_EPOLL
+#include <fcntl.h>
+#endif
+#ifdef VOICE_ENGINE_HAVE_UDP_GSO
+#include <netinet/udp.h>
+#endif
+#include <cstring>
+#include <ctime>
 
 namespace network {
-UdpReceiver::UdpReceiver() {
+#ifdef VOICE_ENGINE_HAVE_MMSG
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    // Zaman damgası (timespec) ve GRO segment boyu (int) cmsg'leri
+    constexpr size_t CONTROL_SIZE = CMSG_SPACE(sizeof(timespec)) + CMSG_SPACE(sizeof(int));
+    // Bundan yaşlı (veya gelecekte) damga saatin ayarlandığını gösterir; okuma anı kullanılır
+    constexpr int64_t MAX_TIMESTAMP_AGE_NS = 1000000000;
+
+    // Mesajın cmsg'lerinden GRO segment boyunu ve çekirdek geliş zamanını okur. Çekirdek
+    // damgası CLOCK_REALTIME'dadır; batch okunurken iki saat birlikte örneklenir ve
+    // paketin yaşı steady_clock'taki okuma anından geri sayılır.
+    void read_control(msghdr& message, const timespec& realtime, Clock::time_point now,
+                      size_t& segment_size, Clock::time_point& arrival) {
+        for (cmsghdr* control = CMSG_FIRSTHDR(&message); control; control = CMSG_NXTHDR(&message, control)) {
+#ifdef VOICE_ENGINE_HAVE_UDP_GSO
+            if (control->cmsg_level == SOL_UDP && control->cmsg_type == UDP_GRO) {
+                int size = 0;
+                std::memcpy(&size, CMSG_DATA(control), sizeof(size));
+                segment_size = static_cast<size_t>(std::max(0, size));
+            }
+#endif
+#ifdef SO_TIMESTAMPNS
+            if (control->cmsg_level == SOL_SOCKET && control->cmsg_type == SCM_TIMESTAMPNS) {
+                timespec stamp{};
+                std::memcpy(&stamp, CMSG_DATA(control), sizeof(stamp));
+                const int64_t age_ns = (static_cast<int64_t>(realtime.tv_sec) - stamp.tv_sec) * 1000000000 +
+                                       (realtime.tv_nsec - stamp.tv_nsec);
+                if (age_ns >= 0 && age_ns < MAX_TIMESTAMP_AGE_NS) {
+                    arrival = now - std::chrono::nanoseconds(age_ns);
+                }
+            }
+#endif
+        }
+    }
+}
+#endif
+
+UdpReceiver::UdpReceiver(size_t batch_size, core::BufferPool* pool, EventLoop* loop, IoBackend backend)
+    : batch_size_(std::max<size_t>(1, batch_size)),
+#ifdef VOICE_ENGINE_HAVE_MMSG
+      batching_(batch_size_ > 1),
+#else
+      batching_(false),
+#endif
+      backend_(backend),
+      own_pool_(pool ? nullptr : std::make_unique<core::BufferPool>(
+          (backend == IoBackend::IoUring ? 4 : 2) * batch_size_, core::MAX_DATAGRAM_SIZE)),
+      pool_(pool ? pool : own_pool_.get()),
+      buffers_(batch_size_),
+      discard_buffer_(core::MAX_DATAGRAM_SIZE) {
+#ifdef VOICE_ENGINE_HAVE_EPOLL
+    if (!loop) {
+        own_loop_ = std::make_unique<EventLoop>();
+        loop = own_loop_.get();
+    }
+    loop_ = loop;
+#else
+    (void)loop;
+#endif
+    if (pool_->buffer_size() < core::MAX_DATAGRAM_SIZE) {
+        throw std::invalid_argument("UdpReceiver: havuz buffer'lari datagram icin kucuk");
+    }
 #ifdef _WIN32
     if (WSAStartup(MAKEWORD(2, 2), &wsa_data_) != 0) { throw std::runtime_error("WSAStartup basarisiz oldu."); }
 #endif
+#ifdef VOICE_ENGINE_HAVE_MMSG
+    messages_.resize(batch_size_);
+    iovecs_.resize(batch_size_);
+    control_.assign(batch_size_ * CONTROL_SIZE, 0);
+    for (size_t i = 0; i < batch_size_; ++i) {
+        iovecs_[i].iov_len = core::MAX_DATAGRAM_SIZE;
+        messages_[i] = mmsghdr{};
+        messages_[i].msg_hdr.msg_iov = &iovecs_[i];
+        messages_[i].msg_hdr.msg_iovlen = 1;
+        messages_[i].msg_hdr.msg_control = &control_[i * CONTROL_SIZE];
+    }
+#endif
 }
 
 UdpReceiver::~UdpReceiver() {
@@ -18,7 +105,7 @@ UdpReceiver::~UdpReceiver() {
 #endif
 }
 
-bool UdpReceiver::start(int port, OnPacketReceived callback) {
+bool UdpReceiver::start(int port, OnPacketReceived callback, const SocketOptions& options) {
     if (is_running_) { return true; }
     on_packet_received_ = std::move(callback);
     socket_ = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
@@ -30,6 +117,27 @@ bool UdpReceiver::start(int port, OnPacketReceived callback) {
         std::cerr << "HATA: Socket olusturulamadi." << std::endl;
         return false;
     }
+    if (options.reuse_port) {
+#ifdef SO_REUSEPORT
+        const int enable = 1;
+        if (setsockopt(socket_, SOL_SOCKET, SO_REUSEPORT, reinterpret_cast<const char*>(&enable), sizeof(enable)) < 0) {
+            std::perror("SO_REUSEPORT");
+            return false;
+        }
+#else
+        std::cerr << "HATA: SO_REUSEPORT bu platformda desteklenmiyor." << std::endl;
+        return false;
+#endif
+    }
+    if (options.incoming_cpu >= 0) {
+#ifdef SO_INCOMING_CPU
+        if (setsockopt(socket_, SOL_SOCKET, SO_INCOMING_CPU, &options.incoming_cpu, sizeof(options.incoming_cpu)) < 0) {
+            std::perror("SO_INCOMING_CPU");
+        }
+#else
+        std::cerr << "UYARI: SO_INCOMING_CPU desteklenmiyor, yok sayiliyor." << std::endl;
+#endif
+    }
     sockaddr_in server_address{};
     server_address.sin_family = AF_INET;
     server_address.sin_addr.s_addr = INADDR_ANY;
@@ -39,13 +147,65 @@ bool UdpReceiver::start(int port, OnPacketReceived callback) {
         return false;
     }
     is_running_ = true;
+#ifdef VOICE_ENGINE_HAVE_IO_URING
+    if (backend_ == IoBackend::IoUring) {
+        try {
+            uring_ = std::make_unique<UringReceiveRing>(socket_, 2 * batch_size_, *pool_);
+            uring_thread_ = std::thread(&UdpReceiver::uring_loop, this);
+            std::cout << "Receiver " << port << " portunu dinlemeye basladi (io_uring)." << std::endl;
+            return true;
+        } catch (const std::runtime_error& e) {
+            std::cerr << "UYARI: io_uring kullanilamiyor (" << e.what() << "), soket yoluna donuluyor." << std::endl;
+            uring_.reset();
+        }
+    }
+#endif
+    backend_ = IoBackend::Socket;
+    if (options.gro) {
+        enable_gro();
+    }
+    if (options.timestamps) {
+        enable_timestamps();
+    }
+#ifdef VOICE_ENGINE_HAVE_EPOLL
+    fcntl(socket_, F_SETFL, fcntl(socket_, F_GETFL, 0) | O_NONBLOCK);
+    if (!loop_->add(socket_, [this] { on_readable(); })) {
+        std::cerr << "HATA: Socket event loop'a eklenemedi." << std::endl;
+        is_running_ = false;
+        return false;
+    }
+    if (own_loop_) {
+        own_loop_->start();
+    }
+#else
     receiver_thread_ = std::thread(&UdpReceiver::receive_loop, this);
+#endif
     std::cout << "Receiver " << port << " portunu dinlemeye basladi." << std::endl;
     return true;
 }
 
 void UdpReceiver::stop() {
     is_running_ = false;
+#ifdef VOICE_ENGINE_HAVE_IO_URING
+    if (uring_) {
+        uring_->stop();
+        // Soket yoluna dönüldüyse bloklayan okumayı uyandırır
+        shutdown(socket_, SHUT_RDWR);
+        if (uring_thread_.joinable()) {
+            uring_thread_.join();
+        }
+        uring_.reset();
+    }
+#endif
+#ifdef VOICE_ENGINE_HAVE_EPOLL
+    if (socket_ != -1) {
+        // remove(), çalışmakta olan callback bitene kadar bekler
+        loop_->remove(socket_);
+    }
+    if (own_loop_) {
+        own_loop_->stop();
+    }
+#endif
     if (socket_ != -1) {
 #ifdef _WIN32
         closesocket(socket_);
@@ -56,28 +216,232 @@ void UdpReceiver::stop() {
         socket_ = -1;
 #endif
     }
+#ifndef VOICE_ENGINE_HAVE_EPOLL
     if (receiver_thread_.joinable()) {
         receiver_thread_.join();
     }
+#endif
+    // Paylaşılan havuza slot buffer'larını geri ver; yeniden başlatılırsa tekrar alınır
+    for (auto& buffer : buffers_) {
+        buffer.reset();
+    }
+    gro_ = false;
+    timestamps_ = false;
 }
 
-void UdpReceiver::receive_loop() {
-    std::vector<uint8_t> buffer(2048);
+bool UdpReceiver::enable_gro() {
+#ifdef VOICE_ENGINE_HAVE_UDP_GSO
+    if (!batching_) {
+        std::cerr << "UYARI: GRO toplu alim gerektirir, kullanilmiyor." << std::endl;
+        return false;
+    }
+    if (pool_->buffer_size() < GRO_BUFFER_SIZE) {
+        if (!own_pool_) {
+            std::cerr << "UYARI: Havuz buffer'lari GRO icin kucuk, kullanilmiyor." << std::endl;
+            return false;
+        }
+        // Slotlar boş (stop() bıraktı); kendi havuzu birleşik datagram boyunda yeniden kurulur
+        own_pool_ = std::make_unique<core::BufferPool>(own_pool_->stats().capacity, GRO_BUFFER_SIZE);
+        pool_ = own_pool_.get();
+    }
+    const int enable = 1;
+    if (setsockopt(socket_, SOL_UDP, UDP_GRO, &enable, sizeof(enable)) < 0) {
+        std::perror("UDP_GRO");
+        std::cerr << "UYARI: Cekirdek UDP GRO desteklemiyor, datagramlar tek tek aliniyor." << std::endl;
+        return false;
+    }
+    for (auto& iovec : iovecs_) {
+        iovec.iov_len = GRO_BUFFER_SIZE;
+    }
+    gro_ = true;
+    return true;
+#else
+    std::cerr << "UYARI: UDP GRO destegi derlenmedi, datagramlar tek tek aliniyor." << std::endl;
+    return false;
+#endif
+}
+
+bool UdpReceiver::enable_timestamps() {
+#if defined(VOICE_ENGINE_HAVE_MMSG) && defined(SO_TIMESTAMPNS)
+    if (!batching_) {
+        return false;
+    }
+    const int enable = 1;
+    if (setsockopt(socket_, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable)) < 0) {
+        std::perror("SO_TIMESTAMPNS");
+        return false;
+    }
+    timestamps_ = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
+size_t UdpReceiver::prepare_buffers(size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        // Callback handle'ı sakladıysa (ör. jitter buffer) slot yeni bir buffer'a geçer;
+        // diğer sahipler sadece bırakabileceği için use_count() == 1 kalıcıdır
+        if (!buffers_[i] || buffers_[i].use_count() > 1) {
+            buffers_[i] = pool_->acquire();
+            if (!buffers_[i]) {
+                return i;
+            }
+        }
+#ifdef VOICE_ENGINE_HAVE_MMSG
+        iovecs_[i].iov_base = buffers_[i].data();
+#endif
+    }
+    return count;
+}
+
+void UdpReceiver::deliver(size_t index, size_t length, std::chrono::steady_clock::time_point arrival,
+                          size_t segment_size) {
+    packet_.buffer = std::move(buffers_[index]);
+    packet_.buffer.set_size(length);
+    packet_.arrival = arrival;
+    // GRO: segment_size'lık datagramlar art arda (sonuncusu kısa olabilir); hepsi aynı
+    // handle'ı paylaşır, saklanan her paket buffer'ı bir referansla tutar
+    const size_t step = segment_size > 0 ? segment_size : length;
+    for (size_t offset = 0; offset < length; offset += step) {
+        const size_t size = std::min(step, length - offset);
+        if (on_packet_received_ && core::PacketView::parse(packet_.buffer.data() + offset, size, packet_.view)) {
+            on_packet_received_(packet_);
+        }
+    }
+    buffers_[index] = std::move(packet_.buffer);
+}
+
+uint64_t UdpReceiver::dropped() const {
+    uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+#ifdef VOICE_ENGINE_HAVE_IO_URING
+    if (uring_) {
+        dropped += uring_->dropped();
+    }
+#endif
+    return dropped;
+}
+
+bool UdpReceiver::handle_error(const char* call) {
+    if (errno == EINTR) {
+        return true;
+    }
+    if (errno != EAGAIN && errno != EWOULDBLOCK && is_running_) {
+        std::perror(call);
+    }
+    return false;
+}
+
+bool UdpReceiver::discard_one() {
+    const int bytes_received = recv(socket_, reinterpret_cast<char*>(discard_buffer_.data()),
+                                    static_cast<int>(discard_buffer_.size()), 0);
+    if (bytes_received < 0) {
+        return handle_error("recv");
+    }
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool UdpReceiver::read_once() {
+    if (batching_) {
+        if (read_batched()) {
+            return true;
+        }
+        if (batching_) {
+            return false;
+        }
+        // ENOSYS: datagram başına okumaya dönüldü
+    }
+    return read_single();
+}
+
+bool UdpReceiver::read_batched() {
+#ifdef VOICE_ENGINE_HAVE_MMSG
+    const size_t ready = prepare_buffers(batch_size_);
+    if (ready == 0) {
+        return discard_one();
+    }
+    // Çekirdek msg_controllen'i yazılan cmsg boyuyla günceller
+    for (size_t i = 0; i < ready; ++i) {
+        messages_[i].msg_hdr.msg_controllen = CONTROL_SIZE;
+    }
+    // MSG_WAITFORONE: ilk datagram için bloklar (non-blocking sokette beklemez),
+    // kalanları beklemeden toplar
+    const int received = recvmmsg(socket_, messages_.data(), static_cast<unsigned int>(ready),
+                                  MSG_WAITFORONE, nullptr);
+    if (received < 0) {
+        if (errno == ENOSYS) {
+            std::cerr << "UYARI: recvmmsg desteklenmiyor, datagram basina almaya donuluyor." << std::endl;
+            batching_ = false;
+            return false;
+        }
+        return handle_error("recvmmsg");
+    }
+    const Clock::time_point now = Clock::now();
+    timespec realtime{};
+    if (timestamps_) {
+        clock_gettime(CLOCK_REALTIME, &realtime);
+    }
+    for (int i = 0; i < received; ++i) {
+        size_t segment_size = 0;
+        Clock::time_point arrival = now;
+        if (gro_ || timestamps_) {
+            read_control(messages_[i].msg_hdr, realtime, now, segment_size, arrival);
+        }
+        deliver(static_cast<size_t>(i), messages_[i].msg_len, arrival, segment_size);
+    }
+    // Slotlar dolmadıysa kuyruk boşaldı; yeni datagram yeni bir bildirim üretir
+    return static_cast<size_t>(received) == ready;
+#else
+    batching_ = false;
+    return false;
+#endif
+}
+
+bool UdpReceiver::read_single() {
+    if (prepare_buffers(1) == 0) {
+        return discard_one();
+    }
     sockaddr_in client_address{};
     socklen_t client_len = sizeof(client_address);
+    const int bytes_received = recvfrom(socket_, reinterpret_cast<char*>(buffers_[0].data()),
+                                        core::MAX_DATAGRAM_SIZE, 0,
+                                        (sockaddr*)&client_address, &client_len);
+    if (bytes_received < 0) {
+        return handle_error("recvfrom");
+    }
+    if (bytes_received > 0) {
+        deliver(0, static_cast<size_t>(bytes_received), std::chrono::steady_clock::now());
+    }
+    return true;
+}
+
+#ifdef VOICE_ENGINE_HAVE_IO_URING
+void UdpReceiver::uring_loop() {
+    if (uring_->run(on_packet_received_)) {
+        return;
+    }
+    // Soket bloklayan modda; stop() shutdown ile uyandırır
+    std::cerr << "UYARI: io_uring multishot alimi desteklenmiyor, soket yoluna donuluyor." << std::endl;
+    backend_ = IoBackend::Socket;
     while (is_running_) {
-        int bytes_received = recvfrom(socket_, reinterpret_cast<char*>(buffer.data()),
-                                     buffer.size(), 0,
-                                     (sockaddr*)&client_address, &client_len);
-        if (bytes_received > 0) {
-            std::vector<uint8_t> received_data(buffer.begin(), buffer.begin() + bytes_received);
-            if (on_packet_received_) {
-                on_packet_received_(core::Packet::from_bytes(received_data));
-            }
-        } else if (bytes_received < 0 && is_running_) {
-            std::perror("recvfrom");
-        }
+        read_once();
+    }
+}
+#endif
+
+#ifdef VOICE_ENGINE_HAVE_EPOLL
+void UdpReceiver::on_readable() {
+    // Edge-triggered: kuyruk boşalana (EAGAIN) kadar oku
+    while (is_running_ && read_once()) {
+    }
+}
+#else
+void UdpReceiver::receive_loop() {
+    while (is_running_) {
+        read_once();
     }
     std::cout << "Receiver dongusu sonlandi." << std::endl;
 }
-}
\ No newline at end of file
+#endif
+}
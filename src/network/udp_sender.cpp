@@ -1,16 +1,102 @@
 #include "network/udp_sender.hpp"
+#include "network/io_uring_backend.hpp"
 #include <iostream>
 #include <stdexcept>
 #include <cstdio>
+#include <cerrno>
+#include <algorithm>
+#include <cstring>
+#include <chrono>
+#ifdef VOICE_ENGINE_HAVE_UDP_GSO
+#include <netinet/udp.h>
+#endif
 
 namespace network {
-    UdpSender::UdpSender() {
+    namespace {
+        // Kova, başlıklarıyla tam boy bir dilimi ve ardından gelen küçük bir paketi tutar
+        constexpr size_t PACER_BURST_BYTES = 1500;
+        constexpr size_t FEEDBACK_QUEUE_ARRIVALS = 256;
+        constexpr size_t FEEDBACK_BATCH_ARRIVALS = 64;
+        constexpr auto PACING_IDLE_INTERVAL = std::chrono::milliseconds(1);
+    }
+
+    UdpSender::UdpSender(size_t batch_size, IoBackend backend, const CongestionOptions& congestion)
+        : batch_size_(std::max<size_t>(1, batch_size)),
+#ifdef VOICE_ENGINE_HAVE_MMSG
+          batching_(batch_size_ > 1),
+#else
+          batching_(false),
+#endif
+          headers_(batch_size_ * core::PACKET_HEADER_SIZE),
+          views_(batch_size_),
+          congestion_(congestion) {
 #ifdef _WIN32
         if (WSAStartup(MAKEWORD(2, 2), &wsa_data_) != 0) { throw std::runtime_error("WSAStartup basarisiz oldu."); }
 #endif
+#ifdef VOICE_ENGINE_HAVE_MMSG
+        // Mesaj başlıkları bir kez kurulur; gönderimde sadece iovec'ler doldurulur
+        messages_.resize(batch_size_);
+        iovecs_.resize(batch_size_ * 2);
+        for (size_t i = 0; i < batch_size_; ++i) {
+            iovecs_[2 * i].iov_base = header(i);
+            iovecs_[2 * i].iov_len = core::PACKET_HEADER_SIZE;
+            messages_[i] = mmsghdr{};
+            messages_[i].msg_hdr.msg_name = &server_address_;
+            messages_[i].msg_hdr.msg_namelen = sizeof(server_address_);
+            messages_[i].msg_hdr.msg_iov = &iovecs_[2 * i];
+            messages_[i].msg_hdr.msg_iovlen = 2;
+        }
+#endif
+#ifdef VOICE_ENGINE_HAVE_UDP_GSO
+        // cmsg başlıkları bir kez yazılır; gönderimde sadece segment boyu güncellenir
+        const size_t control_size = CMSG_SPACE(sizeof(uint16_t));
+        segment_messages_.resize(batch_size_);
+        segment_first_.resize(batch_size_);
+        segment_control_.assign(batch_size_ * control_size, 0);
+        for (size_t i = 0; i < batch_size_; ++i) {
+            segment_messages_[i] = mmsghdr{};
+            segment_messages_[i].msg_hdr.msg_name = &server_address_;
+            segment_messages_[i].msg_hdr.msg_namelen = sizeof(server_address_);
+            segment_messages_[i].msg_hdr.msg_control = &segment_control_[i * control_size];
+            segment_messages_[i].msg_hdr.msg_controllen = control_size;
+            cmsghdr* control = CMSG_FIRSTHDR(&segment_messages_[i].msg_hdr);
+            control->cmsg_level = SOL_UDP;
+            control->cmsg_type = UDP_SEGMENT;
+            control->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+        }
+#endif
+        if (congestion_.enabled) {
+            const size_t slot_count = std::clamp<size_t>(congestion_.queue_packets, 1, UINT16_MAX);
+            controller_ = std::make_unique<DelayBasedController>(congestion_.rate);
+            pacer_ = std::make_unique<Pacer>(controller_->target_bitrate_bps() * congestion_.pacing_factor, PACER_BURST_BYTES);
+            slots_.resize(slot_count * core::MAX_DATAGRAM_SIZE);
+            queue_ = std::make_unique<core::SpscRingBuffer<QueuedPacket>>(slot_count);
+            free_slots_ = std::make_unique<core::SpscRingBuffer<uint16_t>>(slot_count);
+            for (size_t i = 0; i < slot_count; ++i) {
+                const uint16_t index = static_cast<uint16_t>(i);
+                free_slots_->push(&index, 1);
+            }
+            feedback_ = std::make_unique<core::SpscRingBuffer<PacketArrival>>(FEEDBACK_QUEUE_ARRIVALS);
+            paced_views_.resize(batch_size_);
+            paced_slots_.resize(batch_size_);
+            target_bitrate_bps_.store(controller_->target_bitrate_bps(), std::memory_order_relaxed);
+        }
+        if (backend == IoBackend::IoUring) {
+#ifdef VOICE_ENGINE_HAVE_IO_URING
+            try {
+                uring_ = std::make_unique<UringSendRing>(batch_size_);
+                backend_ = IoBackend::IoUring;
+            } catch (const std::runtime_error& e) {
+                std::cerr << "UYARI: io_uring kullanilamiyor (" << e.what() << "), soket yoluna donuluyor." << std::endl;
+            }
+#else
+            std::cerr << "UYARI: io_uring destegi derlenmedi, soket yolu kullaniliyor." << std::endl;
+#endif
+        }
     }
 
     UdpSender::~UdpSender() {
+        stop_pacing();
         if (socket_ != -1) {
 #ifdef _WIN32
             closesocket(socket_);
@@ -21,7 +107,7 @@ namespace network {
         }
     }
 
-    bool UdpSender::connect(const std::string& ip_address, int port) {
+    bool UdpSender::connect(const std::string& ip_address, int port, const SocketOptions& options) {
         socket_ = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
 #ifdef _WIN32
         if (socket_ == INVALID_SOCKET) {
@@ -46,22 +132,323 @@ namespace network {
 #endif
             return false;
         }
-        std::cout << "Sender " << ip_address << ":" << port << " adresine baglanmaya hazir." << std::endl;
+        if (options.gso) {
+#ifdef VOICE_ENGINE_HAVE_UDP_GSO
+            // Segment boyu mesaj başına cmsg ile verilir; soket seçeneği sadece desteği sınar
+            const int segment_size = 0;
+            if (!batching_) {
+                std::cerr << "UYARI: GSO toplu gonderim gerektirir, kullanilmiyor." << std::endl;
+            } else if (setsockopt(socket_, SOL_UDP, UDP_SEGMENT, &segment_size, sizeof(segment_size)) < 0) {
+                std::perror("UDP_SEGMENT");
+                std::cerr << "UYARI: Cekirdek UDP GSO desteklemiyor, normal toplu gonderim kullaniliyor." << std::endl;
+            } else {
+                gso_ = true;
+            }
+#else
+            std::cerr << "UYARI: UDP GSO destegi derlenmedi, normal gonderim kullaniliyor." << std::endl;
+#endif
+        }
+        std::cout << "Sender " << ip_address << ":" << port << " adresine baglanmaya hazir"
+                  << (gso_ ? " (GSO)" : "") << (congestion_.enabled ? " (pacing)." : ".") << std::endl;
+        if (congestion_.enabled && !pacing_running_) {
+            pacing_running_ = true;
+            pacing_thread_ = std::thread(&UdpSender::pacing_loop, this);
+        }
         return true;
     }
 
     void UdpSender::send(const core::Packet& packet) {
-        auto bytes = packet.to_bytes();
-        ssize_t sent = sendto(socket_, reinterpret_cast<const char*>(bytes.data()),
-                              bytes.size(), 0,
-                              (const sockaddr*)&server_address_,
-                              sizeof(server_address_));
-        if (sent < 0) {
-            std::perror("sendto");
-        }
+        send(packet.view());
     }
 
     void UdpSender::send(const std::vector<core::Packet>& packets) {
-        for (const auto& packet : packets) { send(packet); }
+        for (size_t offset = 0; offset < packets.size(); offset += batch_size_) {
+            const size_t count = std::min(batch_size_, packets.size() - offset);
+            for (size_t i = 0; i < count; ++i) {
+                views_[i] = packets[offset + i].view();
+            }
+            send(views_.data(), count);
+        }
+    }
+
+    void UdpSender::send(const core::PacketView& packet) {
+        send(&packet, 1);
+    }
+
+    void UdpSender::send(const core::PacketView* packets, size_t count) {
+        if (queue_) {
+            enqueue(packets, count);
+        } else {
+            transmit(packets, count);
+        }
+    }
+
+    void UdpSender::on_transport_feedback(const PacketArrival* arrivals, size_t count) {
+        if (feedback_) {
+            feedback_->push(arrivals, count);
+        }
+    }
+
+    void UdpSender::enqueue(const core::PacketView* packets, size_t count) {
+        const auto now = Pacer::Clock::now();
+        for (size_t i = 0; i < count; ++i) {
+            const core::PacketView& packet = packets[i];
+            if (packet.wire_size() > core::MAX_DATAGRAM_SIZE) {
+                std::cerr << "HATA: Paket datagram boyutunu asiyor: " << packet.wire_size() << " byte" << std::endl;
+                continue;
+            }
+            uint16_t index = 0;
+            if (free_slots_->pop(&index, 1) == 0) {
+                pacer_dropped_.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            std::copy(packet.data, packet.data + packet.size, slot(index));
+            const QueuedPacket queued{packet.sequence_number, packet.timestamp, packet.fragment_index,
+                                      packet.fragment_count, packet.frame_size, static_cast<uint16_t>(packet.size),
+                                      index, now};
+            queue_->push(&queued, 1);  // Slot sayısı kadar yer var, her zaman sığar
+        }
+    }
+
+    void UdpSender::pacing_loop() {
+        const auto max_queue_delay = std::chrono::milliseconds(congestion_.max_queue_delay_ms);
+        PacketArrival arrivals[FEEDBACK_BATCH_ARRIVALS];
+        while (pacing_running_) {
+            auto now = Pacer::Clock::now();
+
+            // Geri bildirim hedefi, hedef pacer hızını belirler
+            size_t arrival_count = 0;
+            while ((arrival_count = feedback_->pop(arrivals, FEEDBACK_BATCH_ARRIVALS)) > 0) {
+                if (controller_->on_feedback(arrivals, arrival_count, now)) {
+                    target_bitrate_bps_.store(controller_->target_bitrate_bps(), std::memory_order_relaxed);
+                    pacer_->set_rate(controller_->target_bitrate_bps() * congestion_.pacing_factor);
+                }
+            }
+
+            // Kova izin verdiği (veya paket fazla beklediği) sürece sıradaki paketler toplu gönderilir
+            size_t count = 0;
+            while (count < batch_size_ && (has_head_ || queue_->pop(&head_, 1) == 1)) {
+                has_head_ = true;
+                if (now - head_.enqueued < max_queue_delay && !pacer_->can_send(now)) {
+                    break;
+                }
+                core::PacketView& view = paced_views_[count];
+                view.sequence_number = head_.sequence_number;
+                view.timestamp = head_.timestamp;
+                view.fragment_index = head_.fragment_index;
+                view.fragment_count = head_.fragment_count;
+                view.frame_size = head_.frame_size;
+                view.data = slot(head_.slot);
+                view.size = head_.size;
+                paced_slots_[count] = head_.slot;
+                pacer_->on_sent(view.wire_size() + DelayBasedController::IP_UDP_HEADER_BYTES);
+                pacer_queue_delay_us_.store(
+                    std::chrono::duration_cast<std::chrono::microseconds>(now - head_.enqueued).count(),
+                    std::memory_order_relaxed);
+                has_head_ = false;
+                ++count;
+            }
+            if (count > 0) {
+                transmit(paced_views_.data(), count);
+                now = Pacer::Clock::now();
+                for (size_t i = 0; i < count; ++i) {
+                    const core::PacketView& view = paced_views_[i];
+                    if (!view.control()) {
+                        controller_->on_packet_sent(view.sequence_number,
+                                                    view.wire_size() + DelayBasedController::IP_UDP_HEADER_BYTES, now);
+                    }
+                    free_slots_->push(&paced_slots_[i], 1);
+                }
+            }
+
+            // Bekleyen paket varsa sırasının geleceği ana kadar, yoksa kısa aralıklarla
+            // yoklanır (gönderen thread bildirim yapmaz, ses callback'inde de çalışabilir)
+            if (has_head_) {
+                std::this_thread::sleep_until(std::min(pacer_->next_send_time(), head_.enqueued + max_queue_delay));
+            } else {
+                std::this_thread::sleep_for(PACING_IDLE_INTERVAL);
+            }
+        }
+    }
+
+    void UdpSender::stop_pacing() {
+        pacing_running_ = false;
+        if (pacing_thread_.joinable()) {
+            pacing_thread_.join();
+        }
+    }
+
+    void UdpSender::transmit(const core::PacketView* packets, size_t count) {
+        for (size_t offset = 0; offset < count; offset += batch_size_) {
+            const size_t chunk = std::min(batch_size_, count - offset);
+#ifdef VOICE_ENGINE_HAVE_IO_URING
+            if (uring_) {
+                if (uring_->send(socket_, server_address_, packets + offset, chunk) >= 0) {
+                    continue;
+                }
+                std::cerr << "UYARI: io_uring gonderimi basarisiz, soket yoluna donuluyor." << std::endl;
+                uring_.reset();
+                backend_ = IoBackend::Socket;
+            }
+#endif
+            if (batching_ && chunk > 1) {
+                send_batch(packets + offset, chunk);
+            } else {
+                for (size_t i = 0; i < chunk; ++i) { send_one(packets[offset + i]); }
+            }
+        }
+    }
+
+    void UdpSender::send_one(const core::PacketView& packet) {
+        if (packet.wire_size() > core::MAX_DATAGRAM_SIZE) {
+            std::cerr << "HATA: Paket datagram boyutunu asiyor: " << packet.wire_size() << " byte" << std::endl;
+            return;
+        }
+
+        // Başlık yığında; payload çağıranın buffer'ından okunur
+        uint8_t packet_header[core::PACKET_HEADER_SIZE];
+        packet.write_header(packet_header);
+#ifdef _WIN32
+        WSABUF buffers[2];
+        buffers[0].buf = reinterpret_cast<char*>(packet_header);
+        buffers[0].len = static_cast<ULONG>(core::PACKET_HEADER_SIZE);
+        buffers[1].buf = reinterpret_cast<char*>(const_cast<uint8_t*>(packet.data));
+        buffers[1].len = static_cast<ULONG>(packet.size);
+        DWORD sent = 0;
+        if (WSASendTo(socket_, buffers, 2, &sent, 0, (const sockaddr*)&server_address_,
+                      sizeof(server_address_), nullptr, nullptr) != 0) {
+            std::cerr << "HATA: WSASendTo basarisiz: " << WSAGetLastError() << std::endl;
+        }
+#else
+        iovec parts[2];
+        parts[0].iov_base = packet_header;
+        parts[0].iov_len = core::PACKET_HEADER_SIZE;
+        parts[1].iov_base = const_cast<uint8_t*>(packet.data);
+        parts[1].iov_len = packet.size;
+
+        msghdr message{};
+        message.msg_name = &server_address_;
+        message.msg_namelen = sizeof(server_address_);
+        message.msg_iov = parts;
+        message.msg_iovlen = 2;
+        if (sendmsg(socket_, &message, 0) < 0) {
+            std::perror("sendmsg");
+        }
+#endif
+    }
+
+    void UdpSender::send_batch(const core::PacketView* packets, size_t count) {
+#ifdef VOICE_ENGINE_HAVE_MMSG
+        size_t prepared = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const core::PacketView& packet = packets[i];
+            if (packet.wire_size() > core::MAX_DATAGRAM_SIZE) {
+                std::cerr << "HATA: Paket datagram boyutunu asiyor: " << packet.wire_size() << " byte" << std::endl;
+                continue;
+            }
+            packet.write_header(header(prepared));
+            iovecs_[2 * prepared + 1].iov_base = const_cast<uint8_t*>(packet.data);
+            iovecs_[2 * prepared + 1].iov_len = packet.size;
+            ++prepared;
+        }
+
+        size_t sent = 0;
+#ifdef VOICE_ENGINE_HAVE_UDP_GSO
+        if (gso_) {
+            sent = send_segmented(prepared);
+        }
+#endif
+        // sendmmsg daha az mesaj gönderebilir; kalanlar için tekrar çağrılır
+        while (sent < prepared) {
+            const int result = sendmmsg(socket_, messages_.data() + sent, static_cast<unsigned int>(prepared - sent), 0);
+            if (result >= 0) {
+                sent += static_cast<size_t>(result);
+                continue;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == ENOSYS) {
+                // Çekirdek desteklemiyor: kalıcı olarak paket başına gönderime geç. Başlıklar
+                // zaten yazıldığı için kalan mesajlar tek tek sendmsg ile gönderilir.
+                std::cerr << "UYARI: sendmmsg desteklenmiyor, paket basina gonderime donuluyor." << std::endl;
+                batching_ = false;
+                for (; sent < prepared; ++sent) {
+                    if (sendmsg(socket_, &messages_[sent].msg_hdr, 0) < 0) {
+                        std::perror("sendmsg");
+                    }
+                }
+                break;
+            }
+            // Diğer hatalarda (ör. ağ erişilemez) bu batch'in kalanı atılır; sendmsg ile aynı davranış
+            std::perror("sendmmsg");
+            break;
+        }
+#else
+        for (size_t i = 0; i < count; ++i) { send_one(packets[i]); }
+#endif
+    }
+
+    size_t UdpSender::send_segmented(size_t prepared) {
+#ifdef VOICE_ENGINE_HAVE_UDP_GSO
+        // Paketler iovecs_'te sırayla durur; her mesaj ardışık bir paket grubunu kapsar
+        auto wire_size = [this](size_t index) { return core::PACKET_HEADER_SIZE + iovecs_[2 * index + 1].iov_len; };
+        size_t message_count = 0;
+        for (size_t first = 0; first < prepared; ++message_count) {
+            const size_t segment_size = wire_size(first);
+            size_t end = first + 1;
+            size_t total = segment_size;
+            while (end < prepared && end - first < MAX_SEGMENTS) {
+                const size_t size = wire_size(end);
+                if (size > segment_size || total + size > MAX_SEGMENTED_SIZE) {
+                    break;
+                }
+                total += size;
+                ++end;
+                if (size < segment_size) {
+                    break;  // Kısa segment yalnızca sonda olabilir
+                }
+            }
+
+            msghdr& message = segment_messages_[message_count].msg_hdr;
+            message.msg_iov = &iovecs_[2 * first];
+            message.msg_iovlen = 2 * (end - first);
+            if (end - first > 1) {
+                // Uzunluk önce geri yüklenir: önceki tek paketlik mesajda 0 kaldıysa
+                // CMSG_FIRSTHDR NULL döner
+                message.msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+                const uint16_t size = static_cast<uint16_t>(segment_size);
+                std::memcpy(CMSG_DATA(CMSG_FIRSTHDR(&message)), &size, sizeof(size));
+            } else {
+                message.msg_controllen = 0;  // Tek paket: normal datagram
+            }
+            segment_first_[message_count] = first;
+            first = end;
+        }
+
+        size_t sent = 0;
+        while (sent < message_count) {
+            const int result = sendmmsg(socket_, segment_messages_.data() + sent,
+                                        static_cast<unsigned int>(message_count - sent), 0);
+            if (result >= 0) {
+                sent += static_cast<size_t>(result);
+                continue;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EIO || errno == EINVAL || errno == ENOSYS) {
+                // Aygıt checksum offload yapamıyor veya segment MTU'yu aşıyor: kalanlar
+                // normal toplu yoldan gönderilir
+                std::perror("sendmmsg (GSO)");
+                std::cerr << "UYARI: UDP GSO reddedildi, normal toplu gonderime donuluyor." << std::endl;
+                gso_ = false;
+                return segment_first_[sent];
+            }
+            std::perror("sendmmsg");
+            break;
+        }
+#endif
+        return prepared;
     }
-}
\ No newline at end of file
+}
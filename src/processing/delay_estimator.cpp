@@ -0,0 +1,173 @@
+#include "processing/delay_estimator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace processing {
+
+namespace {
+    constexpr size_t WINDOW_SAMPLES = 4096;     // 12 kHz'de ~340 ms
+    constexpr float MIN_FREQUENCY_HZ = 100.0f;  // DC ve şebeke uğultusu dışarıda kalsın
+    constexpr float SMOOTHING = 0.7f;           // Çapraz spektrumun güncellemeler arası yumuşatması
+    constexpr float MIN_WINDOW_POWER = 1e-6f;   // ~-60 dBFS; altındaki pencereler kullanılmaz
+    constexpr float MIN_CONFIDENCE = 8.0f;      // Tepe / ortalama |r|
+    constexpr long LAG_TOLERANCE = 1;           // Aynı kabul edilen gecikme farkı (seyreltilmiş)
+
+    size_t next_power_of_two(size_t value) {
+        size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    float mean_power(const float* samples, size_t count) {
+        double sum = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            sum += static_cast<double>(samples[i]) * samples[i];
+        }
+        return static_cast<float>(sum / static_cast<double>(count));
+    }
+}
+
+DelayEstimator::DelayEstimator(int sample_rate, int max_delay_ms)
+    : max_lag_(static_cast<size_t>(std::max(1, sample_rate / 1000 * max_delay_ms)) / DECIMATION),
+      window_(WINDOW_SAMPLES),
+      // Pencere + en büyük gecikme sıfır dolgulu FFT'ye sığmalı ki korelasyon dairesel katlanmasın
+      fft_size_(next_power_of_two(WINDOW_SAMPLES + max_lag_)),
+      update_interval_(static_cast<size_t>(sample_rate / 1000 * UPDATE_INTERVAL_MS) / DECIMATION),
+      min_bin_(static_cast<size_t>(MIN_FREQUENCY_HZ * fft_size_ / (static_cast<float>(sample_rate) / DECIMATION))),
+      fft_(fft_size_),
+      reference_history_(fft_size_),
+      capture_history_(fft_size_),
+      time_buffer_(fft_size_),
+      reference_spectrum_(fft_size_ / 2 + 1),
+      capture_spectrum_(fft_size_ / 2 + 1),
+      cross_spectrum_(fft_size_ / 2 + 1) {
+    if (sample_rate <= 0 || max_delay_ms <= 0) {
+        throw std::runtime_error("Geçersiz gecikme tahmincisi parametreleri");
+    }
+    reset();
+}
+
+void DelayEstimator::reset() {
+    std::fill(reference_history_.begin(), reference_history_.end(), 0.0f);
+    std::fill(capture_history_.begin(), capture_history_.end(), 0.0f);
+    std::fill(cross_spectrum_.begin(), cross_spectrum_.end(), std::complex<float>(0.0f, 0.0f));
+    history_pos_ = 0;
+    history_count_ = 0;
+    reference_acc_ = 0.0f;
+    capture_acc_ = 0.0f;
+    decimation_phase_ = 0;
+    samples_since_update_ = 0;
+    delay_ = -1;
+    candidate_ = -1;
+    candidate_count_ = 0;
+    confidence_ = 0.0f;
+}
+
+bool DelayEstimator::process(const int16_t* capture, const int16_t* reference, size_t count) {
+    constexpr float SCALE = 1.0f / (32768.0f * DECIMATION);
+    bool changed = false;
+
+    for (size_t i = 0; i < count; ++i) {
+        // Basit kutu filtresi ile seyreltme (4 örneğin ortalaması)
+        reference_acc_ += static_cast<float>(reference[i]);
+        if (capture) {
+            capture_acc_ += static_cast<float>(capture[i]);
+        }
+        if (++decimation_phase_ < DECIMATION) {
+            continue;
+        }
+
+        reference_history_[history_pos_] = reference_acc_ * SCALE;
+        capture_history_[history_pos_] = capture_acc_ * SCALE;
+        history_pos_ = (history_pos_ + 1) % fft_size_;
+        history_count_ = std::min(history_count_ + 1, fft_size_);
+        reference_acc_ = 0.0f;
+        capture_acc_ = 0.0f;
+        decimation_phase_ = 0;
+
+        if (++samples_since_update_ >= update_interval_ && history_count_ >= window_ + max_lag_) {
+            samples_since_update_ = 0;
+            changed = update() || changed;
+        }
+    }
+    return changed;
+}
+
+// Geçmişin son `length` örneğini eskiden yeniye sırayla out'a kopyalar
+void DelayEstimator::copy_history(const std::vector<float>& history, size_t length, float* out) const {
+    const size_t start = (history_pos_ + fft_size_ - length) % fft_size_;
+    const size_t first = std::min(length, fft_size_ - start);
+    std::copy(history.begin() + start, history.begin() + start + first, out);
+    std::copy(history.begin(), history.begin() + (length - first), out + first);
+}
+
+bool DelayEstimator::update() {
+    // x: son (W + L) referans örneği, y: son W mikrofon örneği L ofsetinde. Böylece
+    // r[k] = Σ y[n + k] · x[n] tepe noktası k = gecikme'de çıkar (0 <= k <= L).
+    std::fill(time_buffer_.begin(), time_buffer_.end(), 0.0f);
+    copy_history(reference_history_, window_ + max_lag_, time_buffer_.data());
+    const float reference_power = mean_power(time_buffer_.data() + max_lag_, window_);
+    fft_.forward(time_buffer_.data(), reference_spectrum_.data());
+
+    std::fill(time_buffer_.begin(), time_buffer_.end(), 0.0f);
+    copy_history(capture_history_, window_, time_buffer_.data() + max_lag_);
+    const float capture_power = mean_power(time_buffer_.data() + max_lag_, window_);
+    fft_.forward(time_buffer_.data(), capture_spectrum_.data());
+
+    // Karşı taraf sessizken korelasyon anlamsız; önceki birikimi bozma
+    if (reference_power < MIN_WINDOW_POWER || capture_power < MIN_WINDOW_POWER) {
+        return false;
+    }
+
+    // Yumuşatılmış çapraz spektrum ve faz dönüşümü (PHAT: genlik 1'e normalize edilir)
+    for (size_t k = 0; k < cross_spectrum_.size(); ++k) {
+        cross_spectrum_[k] = SMOOTHING * cross_spectrum_[k]
+                           + (1.0f - SMOOTHING) * capture_spectrum_[k] * std::conj(reference_spectrum_[k]);
+        const float magnitude = std::abs(cross_spectrum_[k]);
+        capture_spectrum_[k] = (k < min_bin_ || magnitude < 1e-20f)
+                             ? std::complex<float>(0.0f, 0.0f)
+                             : cross_spectrum_[k] / magnitude;
+    }
+    fft_.inverse(capture_spectrum_.data(), time_buffer_.data());
+
+    // Tepe arama; hoparlör kutuplaması ters olabileceği için mutlak değer
+    size_t best_lag = 0;
+    float best_value = 0.0f;
+    float sum = 0.0f;
+    for (size_t k = 0; k <= max_lag_; ++k) {
+        const float value = std::abs(time_buffer_[k]);
+        sum += value;
+        if (value > best_value) {
+            best_value = value;
+            best_lag = k;
+        }
+    }
+    const float mean = sum / static_cast<float>(max_lag_ + 1);
+    confidence_ = mean > 0.0f ? best_value / mean : 0.0f;
+    if (confidence_ < MIN_CONFIDENCE) {
+        candidate_count_ = 0;
+        return false;
+    }
+
+    // Histerezis: aday art arda STABLE_UPDATES kez görülmeli
+    const long lag = static_cast<long>(best_lag);
+    if (candidate_ >= 0 && std::abs(lag - candidate_) <= LAG_TOLERANCE) {
+        ++candidate_count_;
+    } else {
+        candidate_ = lag;
+        candidate_count_ = 1;
+    }
+    if (candidate_count_ < STABLE_UPDATES) {
+        return false;
+    }
+    if (delay_ >= 0 && std::abs(candidate_ - delay_) <= LAG_TOLERANCE) {
+        return false;
+    }
+    delay_ = candidate_;
+    return true;
+}
+
+}
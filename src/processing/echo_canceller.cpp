@@ -5,63 +5,193 @@
 
 namespace processing {
 
-EchoCanceller::EchoCanceller(size_t filter_length, float step_size)
-    : filter_length_(filter_length),
+namespace {
+    // Tek seferde dönüştürülen en fazla örnek sayısı
+    constexpr size_t CONVERSION_CHUNK = 1024;
+    // Referans FIFO'sunda toplu gecikmenin üzerine bekleyebilecek en fazla örnek
+    // (fazlası en eskiden atılır)
+    constexpr size_t REFERENCE_SLACK = 2048;
+    // Bu kadar örnekten (1 ms) büyük gecikme değişikliklerinde filtre yeniden öğrenir
+    constexpr size_t DELAY_RESET_THRESHOLD = 48;
+}
+
+EchoCanceller::EchoCanceller(size_t filter_length, float step_size, Engine engine)
+    : engine_(engine),
+      filter_length_(filter_length),
       step_size_(step_size),
       epsilon_(1e-6f),
-      filter_weights_(filter_length, 0.0f),
-      reference_buffer_(filter_length, 0.0f) {}
+      reference_fifo_(MAX_BULK_DELAY + REFERENCE_SLACK),
+      conversion_buffer_(CONVERSION_CHUNK, 0.0f),
+      capture_buffer_(CONVERSION_CHUNK, 0.0f),
+      kernels_(dsp::kernels()) {
+    if (engine_ == Engine::PartitionedBlock) {
+        block_filter_ = std::make_unique<PartitionedBlockFilter>(filter_length_, PARTITION_BLOCK_SIZE, step_size_);
+    } else {
+        filter_weights_.assign(filter_length_, 0.0f);
+        reference_history_.assign(filter_length_ * 2, 0.0f);
+    }
+}
 
 void EchoCanceller::reset() {
     std::lock_guard<std::mutex> lock(mutex_);
+    reset_adaptation();
+    std::fill(reference_history_.begin(), reference_history_.end(), 0.0f);
+    history_pos_ = 0;
+    reference_power_ = 0.0;
+    power_update_count_ = 0;
+    reference_fifo_.discard(reference_fifo_.size());
+    reference_count_ = 0;
+    capture_count_ = 0;
+}
+
+void EchoCanceller::reset_adaptation() {
     std::fill(filter_weights_.begin(), filter_weights_.end(), 0.0f);
-    std::fill(reference_buffer_.begin(), reference_buffer_.end(), 0.0f);
+    if (block_filter_) {
+        block_filter_->reset();
+    }
 }
 
-void EchoCanceller::on_playback(const std::vector<int16_t>& samples) {
+void EchoCanceller::set_bulk_delay(size_t samples) {
     std::lock_guard<std::mutex> lock(mutex_);
-    for (int16_t sample : samples) {
-        // Buffer'ı kaydır. Overlapping aralıklar nedeniyle move yerine
-        // copy_backward kullanılır.
-        std::copy_backward(reference_buffer_.begin(),
-                           reference_buffer_.end() - 1,
-                           reference_buffer_.end());
-
-        // Yeni örneği ekle (normalize edilmiş)
-        reference_buffer_[0] = static_cast<float>(sample) / 32768.0f;
+    samples = std::min(samples, MAX_BULK_DELAY);
+    const size_t change = samples > bulk_delay_ ? samples - bulk_delay_ : bulk_delay_ - samples;
+    bulk_delay_ = samples;
+    // Küçük kaymaları filtre kendisi takip eder; büyüklerde eski katsayılar yanlış yerdedir
+    if (change > DELAY_RESET_THRESHOLD) {
+        reset_adaptation();
     }
 }
 
-void EchoCanceller::process(std::vector<int16_t>& capture) {
+void EchoCanceller::skip_capture(size_t count) {
     std::lock_guard<std::mutex> lock(mutex_);
-    for (auto& sample_ref : capture) {
-        float mic_signal = static_cast<float>(sample_ref) / 32768.0f;
+    capture_count_ += count;
+}
 
-        // 1. Eko tahminini hesapla (filtering)
-        float echo_estimate = 0.0f;
-        for (size_t i = 0; i < filter_length_; ++i) {
-            echo_estimate += filter_weights_[i] * reference_buffer_[i];
+void EchoCanceller::on_playback(const std::vector<int16_t>& samples) {
+    on_playback(samples.data(), samples.size());
+}
+
+void EchoCanceller::on_playback(const int16_t* samples, size_t count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t offset = 0; offset < count; offset += CONVERSION_CHUNK) {
+        const size_t chunk = std::min(CONVERSION_CHUNK, count - offset);
+        kernels_.int16_to_float(samples + offset, conversion_buffer_.data(), chunk);
+
+        // FIFO dolarsa en eski referans örneklerini at (mikrofon işlenmiyorsa gecikme birikmesin)
+        const size_t free_space = reference_fifo_.capacity() - reference_fifo_.size();
+        if (chunk > free_space) {
+            reference_fifo_.discard(chunk - free_space);
         }
+        reference_fifo_.push(conversion_buffer_.data(), chunk);
+        reference_count_ += chunk;
+    }
+}
+
+// Sıradaki `count` mikrofon örneğiyle eşleşen referans örneklerini out'a yazar
+void EchoCanceller::take_reference(float* out, size_t count) {
+    const int64_t wanted = static_cast<int64_t>(capture_count_) - static_cast<int64_t>(bulk_delay_);
+    const int64_t front = static_cast<int64_t>(reference_count_ - reference_fifo_.size());
+
+    size_t filled = 0;
+    if (wanted < front) {
+        // Eşleşen referans FIFO'dan daha eski (başlangıç ya da gecikme yeni arttı): sessizlik
+        filled = static_cast<size_t>(std::min<int64_t>(front - wanted, static_cast<int64_t>(count)));
+        std::fill(out, out + filled, 0.0f);
+    } else if (wanted > front) {
+        // Gecikme azaldı ya da referans geç geldi: eşleşmesi geçmiş örnekleri at
+        reference_fifo_.discard(static_cast<size_t>(wanted - front));
+    }
+
+    // Referans henüz gelmediyse sessizlik varsay (geldiğinde yukarıda atılır)
+    const size_t popped = reference_fifo_.pop(out + filled, count - filled);
+    std::fill(out + filled + popped, out + count, 0.0f);
+    capture_count_ += count;
+}
+
+void EchoCanceller::push_history(float sample) {
+    history_pos_ = (history_pos_ == 0 ? filter_length_ : history_pos_) - 1;
+
+    // Bu konumdaki eski değer pencereden çıkan en eski örnektir
+    const float oldest = reference_history_[history_pos_];
+    reference_history_[history_pos_] = sample;
+    reference_history_[history_pos_ + filter_length_] = sample;
 
-        // 2. Hata sinyalini bul (temizlenmiş sinyal)
-        float error_signal = mic_signal - echo_estimate;
+    reference_power_ += static_cast<double>(sample) * sample - static_cast<double>(oldest) * oldest;
 
-        // 3. NLMS için referans sinyal gücünü hesapla
-        float ref_power = 0.0f;
-        for (float val : reference_buffer_) {
-            ref_power += val * val;
+    // Kayan nokta hatası birikmesin diye her filter_length_ örnekte bir tam hesapla
+    if (++power_update_count_ >= filter_length_) {
+        const float* window = reference_history_.data() + history_pos_;
+        double exact = 0.0;
+        for (size_t i = 0; i < filter_length_; ++i) {
+            exact += static_cast<double>(window[i]) * window[i];
         }
+        reference_power_ = exact;
+        power_update_count_ = 0;
+    }
+}
 
-        // 4. Filtre katsayılarını güncelle (adaptation)
-        if (ref_power > 0.0f) {
-            float adaptive_step = step_size_ / (epsilon_ + ref_power);
-            for (size_t i = 0; i < filter_length_; ++i) {
-                filter_weights_[i] += adaptive_step * error_signal * reference_buffer_[i];
+void EchoCanceller::process(std::vector<int16_t>& capture) {
+    process(capture.data(), capture.size());
+}
+
+void EchoCanceller::process(int16_t* capture, size_t count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (engine_ == Engine::PartitionedBlock) {
+        process_partitioned(capture, count);
+    } else {
+        process_time_domain(capture, count);
+    }
+}
+
+void EchoCanceller::process_partitioned(int16_t* capture, size_t count) {
+    for (size_t offset = 0; offset < count; offset += CONVERSION_CHUNK) {
+        const size_t chunk = std::min(CONVERSION_CHUNK, count - offset);
+
+        // Blok filtreye tam olarak bu mikrofon örnekleriyle eşleşen referansı ver
+        take_reference(conversion_buffer_.data(), chunk);
+        block_filter_->push_reference(conversion_buffer_.data(), chunk);
+
+        kernels_.int16_to_float(capture + offset, conversion_buffer_.data(), chunk);
+        block_filter_->process(conversion_buffer_.data(), chunk);
+        kernels_.float_to_int16(conversion_buffer_.data(), capture + offset, chunk);
+    }
+}
+
+void EchoCanceller::process_time_domain(int16_t* capture, size_t count) {
+    for (size_t offset = 0; offset < count; offset += CONVERSION_CHUNK) {
+        const size_t chunk = std::min(CONVERSION_CHUNK, count - offset);
+
+        // Bu mikrofon örnekleriyle eşleşen referans örnekleri
+        take_reference(conversion_buffer_.data(), chunk);
+
+        kernels_.int16_to_float(capture + offset, capture_buffer_.data(), chunk);
+
+        for (size_t n = 0; n < chunk; ++n) {
+            const float mic_signal = capture_buffer_[n];
+
+            push_history(conversion_buffer_[n]);
+            const float* reference = reference_history_.data() + history_pos_;
+
+            // 1. Eko tahminini hesapla (filtering)
+            const float echo_estimate = kernels_.dot(filter_weights_.data(), reference, filter_length_);
+
+            // 2. Hata sinyalini bul (temizlenmiş sinyal)
+            const float error_signal = mic_signal - echo_estimate;
+
+            // 3. NLMS için referans sinyal gücü (artımlı olarak takip edilir)
+            const float ref_power = static_cast<float>(std::max(0.0, reference_power_));
+
+            // 4. Filtre katsayılarını güncelle (adaptation)
+            if (ref_power > 0.0f) {
+                const float adaptive_step = step_size_ / (epsilon_ + ref_power);
+                kernels_.axpy(adaptive_step * error_signal, reference, filter_weights_.data(), filter_length_);
             }
+
+            capture_buffer_[n] = error_signal;
         }
-        
+
         // Çıktıyı int16'ya çevir
-        sample_ref = static_cast<int16_t>(std::clamp(error_signal * 32768.0f, -32768.0f, 32767.0f));
+        kernels_.float_to_int16(capture_buffer_.data(), capture + offset, chunk);
     }
 }
 
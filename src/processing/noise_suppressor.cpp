@@ -19,9 +19,12 @@ NoiseSuppressor::NoiseSuppressor(int frame_size, float suppression_db)
       output_buffer_(frame_size, 0.0f),
       frame_buffer_(frame_size),
       output_frame_buffer_(frame_size),
-      fft_buffer_(frame_size),
+      fft_(frame_size), // frame_size 2'nin kuvveti olmalı
+      fft_buffer_(frame_size / 2 + 1),
       magnitude_spectrum_(frame_size / 2 + 1),
       noise_spectrum_(frame_size / 2 + 1, 0.0f),
+      gain_spectrum_(frame_size / 2 + 1, 1.0f),
+      kernels_(dsp::kernels()),
       input_buffer_pos_(0),
       output_buffer_pos_(0),
       alpha_noise_(0.95f) {
@@ -39,25 +42,30 @@ void NoiseSuppressor::reset() {
     // Gürültüyü küçük bir başlangıç gücüyle başlat
     std::fill(noise_spectrum_.begin(), noise_spectrum_.end(), 1e-6f);
     input_buffer_pos_ = 0;
-    output_buffer_pos_ = hop_size_; // Gecikmeyi dengelemek için
+    output_buffer_pos_ = hop_size_ - 1; // Gecikmeyi dengelemek için
 }
 
 void NoiseSuppressor::process(std::vector<int16_t>& samples) {
-    for (size_t i = 0; i < samples.size(); ++i) {
-        // Orijinal girdi sinyalini sakla
-        const float original_input_sample = static_cast<float>(samples[i]) / 32768.0f;
+    process(samples.data(), samples.size());
+}
+
+void NoiseSuppressor::process(int16_t* samples, size_t count) {
+    const size_t hop = static_cast<size_t>(hop_size_);
+    size_t i = 0;
+    while (i < count) {
+        // Bir sonraki hop sınırına kadar olan örnekler toplu işlenir
+        const size_t input_pos = static_cast<size_t>(input_buffer_pos_);
+        const size_t output_pos = static_cast<size_t>(output_buffer_pos_);
+        const size_t run = std::min({count - i, hop - input_pos, hop - output_pos});
 
-        // İşlenmiş çıktıyı buffer'dan al
-        const float out_sample = output_buffer_[output_buffer_pos_];
-        
-        // Kullanıcının buffer'ını işlenmiş sinyal ile güncelle
-        samples[i] = static_cast<int16_t>(std::clamp(out_sample * 32768.0f, -32768.0f, 32767.0f));
-        
         // Orijinal, dokunulmamış sinyali bir sonraki frame'in işlenmesi için input buffer'a koy
-        input_buffer_[input_buffer_pos_] = original_input_sample;
+        kernels_.int16_to_float(samples + i, input_buffer_.data() + input_pos, run);
+        // Kullanıcının buffer'ını işlenmiş sinyal ile güncelle
+        kernels_.float_to_int16(output_buffer_.data() + output_pos, samples + i, run);
 
-        input_buffer_pos_++;
-        output_buffer_pos_++;
+        input_buffer_pos_ += static_cast<int>(run);
+        output_buffer_pos_ += static_cast<int>(run);
+        i += run;
         
         if (input_buffer_pos_ >= hop_size_) {
             process_frame();
@@ -75,11 +83,9 @@ void NoiseSuppressor::process(std::vector<int16_t>& samples) {
 
 void NoiseSuppressor::process_frame() {
     // Input buffer'dan frame'e kopyala ve window uygula
-    for(int i = 0; i < frame_size_; ++i) {
-        frame_buffer_[i] = input_buffer_[i] * window_[i];
-    }
+    kernels_.multiply(input_buffer_.data(), window_.data(), frame_buffer_.data(), frame_size_);
 
-    compute_fft(frame_buffer_, fft_buffer_);
+    fft_.forward(frame_buffer_.data(), fft_buffer_.data());
 
     // Magnitude ve gürültü spektrumlarını güncelle
     for (size_t i = 0; i < magnitude_spectrum_.size(); ++i) {
@@ -105,49 +111,20 @@ void NoiseSuppressor::process_frame() {
             gain = 0.0f;
         }
         
-        gain = std::max(gain, suppression_gain_); // Minimum kazancı uygula
-        
-        // Frekans bin'ini kazançla çarp
-        fft_buffer_[i] *= gain;
-        // Nyquist frekansı için simetriği
-        if (i > 0 && i < magnitude_spectrum_.size() - 1) {
-             fft_buffer_[frame_size_ - i] = std::conj(fft_buffer_[i]);
-        }
+        gain_spectrum_[i] = std::max(gain, suppression_gain_); // Minimum kazancı uygula
     }
 
-    compute_ifft(fft_buffer_, output_frame_buffer_);
+    // Frekans bin'lerini kazançla çarp (eşlenik simetrik yarı RealFft tarafından türetilir)
+    kernels_.apply_gain(fft_buffer_.data(), gain_spectrum_.data(), gain_spectrum_.size());
+
+    fft_.inverse(fft_buffer_.data(), output_frame_buffer_.data());
     
     // Overlap-add: İşlenmiş frame'i window ile çarpıp output buffer'a ekle
-    for(int i = 0; i < frame_size_; ++i) {
-        output_buffer_[i] += output_frame_buffer_[i] * window_[i];
-    }
+    kernels_.multiply_accumulate(output_frame_buffer_.data(), window_.data(), output_buffer_.data(), frame_size_);
     
     // Input buffer'ı kaydır
     std::move(input_buffer_.begin() + hop_size_, input_buffer_.end(), input_buffer_.begin());
     std::fill(input_buffer_.begin() + (frame_size_ - hop_size_), input_buffer_.end(), 0.0f);
 }
 
-
-void NoiseSuppressor::compute_fft(const std::vector<float>& input, std::vector<std::complex<float>>& output) {
-    for (size_t k = 0; k < frame_size_; ++k) {
-        std::complex<float> sum(0.0f, 0.0f);
-        for (size_t n = 0; n < frame_size_; ++n) {
-            float angle = -2.0f * M_PI * k * n / frame_size_;
-            sum += input[n] * std::complex<float>(std::cos(angle), std::sin(angle));
-        }
-        output[k] = sum;
-    }
-}
-
-void NoiseSuppressor::compute_ifft(const std::vector<std::complex<float>>& input, std::vector<float>& output) {
-    for (size_t n = 0; n < frame_size_; ++n) {
-        std::complex<float> sum(0.0f, 0.0f);
-        for (size_t k = 0; k < frame_size_; ++k) {
-            float angle = 2.0f * M_PI * k * n / frame_size_;
-            sum += input[k] * std::complex<float>(std::cos(angle), std::sin(angle));
-        }
-        output[n] = sum.real() / frame_size_;
-    }
-}
-
 }
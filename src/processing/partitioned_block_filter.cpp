@@ -0,0 +1,144 @@
+#include "processing/partitioned_block_filter.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace processing {
+
+namespace {
+    // Referans FIFO'sunda blok dışında tutulabilecek en fazla örnek. EchoCanceller
+    // referansı her process() parçasından (en fazla 1024 örnek) hemen önce verir; daha
+    // fazlası birikirse en eski örnekler atılır ki hizalama kaymasın.
+    constexpr size_t REFERENCE_SLACK = 1024;
+}
+
+PartitionedBlockFilter::PartitionedBlockFilter(size_t filter_length, size_t block_size, float step_size)
+    : block_size_(block_size),
+      fft_size_(block_size * 2),
+      bins_(block_size + 1),
+      partitions_(std::max<size_t>(1, (filter_length + block_size - 1) / block_size)),
+      step_size_(step_size),
+      epsilon_(1e-5f * static_cast<float>(block_size * 2)),
+      kernels_(dsp::kernels()),
+      fft_(block_size * 2),
+      reference_spectra_(partitions_ * bins_),
+      weights_(partitions_ * bins_),
+      newest_partition_(0),
+      constrain_partition_(0),
+      reference_fifo_(block_size + REFERENCE_SLACK),
+      fifo_read_(0),
+      fifo_size_(0),
+      reference_window_(block_size * 2),
+      capture_block_(block_size),
+      output_block_(block_size),
+      time_buffer_(block_size * 2),
+      spectrum_(bins_),
+      error_spectrum_(bins_),
+      power_(bins_),
+      block_pos_(0) {
+    if (filter_length == 0) {
+        throw std::runtime_error("Filtre uzunluğu sıfır olamaz");
+    }
+    reset();
+}
+
+void PartitionedBlockFilter::reset() {
+    std::fill(reference_spectra_.begin(), reference_spectra_.end(), std::complex<float>(0.0f, 0.0f));
+    std::fill(weights_.begin(), weights_.end(), std::complex<float>(0.0f, 0.0f));
+    std::fill(reference_window_.begin(), reference_window_.end(), 0.0f);
+    std::fill(capture_block_.begin(), capture_block_.end(), 0.0f);
+    std::fill(output_block_.begin(), output_block_.end(), 0.0f);
+    newest_partition_ = 0;
+    constrain_partition_ = 0;
+    fifo_read_ = 0;
+    fifo_size_ = 0;
+    block_pos_ = 0;
+}
+
+void PartitionedBlockFilter::push_reference(const float* samples, size_t count) {
+    const size_t capacity = reference_fifo_.size();
+    for (size_t i = 0; i < count; ++i) {
+        if (fifo_size_ == capacity) {
+            // En eski örneği at
+            fifo_read_ = (fifo_read_ + 1) % capacity;
+            --fifo_size_;
+        }
+        reference_fifo_[(fifo_read_ + fifo_size_) % capacity] = samples[i];
+        ++fifo_size_;
+    }
+}
+
+void PartitionedBlockFilter::pop_reference_block(float* out) {
+    const size_t capacity = reference_fifo_.size();
+    const size_t available = std::min(fifo_size_, block_size_);
+    for (size_t i = 0; i < available; ++i) {
+        out[i] = reference_fifo_[fifo_read_];
+        fifo_read_ = (fifo_read_ + 1) % capacity;
+    }
+    fifo_size_ -= available;
+    // Referans henüz gelmediyse sessizlik varsay
+    std::fill(out + available, out + block_size_, 0.0f);
+}
+
+void PartitionedBlockFilter::process(float* capture, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const float out = output_block_[block_pos_];
+        capture_block_[block_pos_] = capture[i];
+        capture[i] = out;
+
+        if (++block_pos_ == block_size_) {
+            process_block();
+            block_pos_ = 0;
+        }
+    }
+}
+
+void PartitionedBlockFilter::process_block() {
+    const size_t B = block_size_;
+
+    // 1. Referans penceresini kaydır ve yeni bloğun spektrumunu geçmişe ekle
+    std::copy(reference_window_.begin() + B, reference_window_.end(), reference_window_.begin());
+    pop_reference_block(reference_window_.data() + B);
+
+    newest_partition_ = (newest_partition_ + partitions_ - 1) % partitions_;
+    fft_.forward(reference_window_.data(), &reference_spectra_[newest_partition_ * bins_]);
+
+    // 2. Eko tahmini: Y = Σ W[p] · X[k - p]; aynı geçişte bin başına referans gücü
+    std::fill(spectrum_.begin(), spectrum_.end(), std::complex<float>(0.0f, 0.0f));
+    std::fill(power_.begin(), power_.end(), 0.0f);
+    for (size_t p = 0; p < partitions_; ++p) {
+        const std::complex<float>* x = &reference_spectra_[((newest_partition_ + p) % partitions_) * bins_];
+        kernels_.complex_multiply_accumulate(&weights_[p * bins_], x, spectrum_.data(), bins_);
+        kernels_.norm_accumulate(x, power_.data(), bins_);
+    }
+    fft_.inverse(spectrum_.data(), time_buffer_.data());
+
+    // 3. Hata sinyali (overlap-save: IFFT'nin son B örneği geçerlidir)
+    for (size_t i = 0; i < B; ++i) {
+        output_block_[i] = capture_block_[i] - time_buffer_[B + i];
+    }
+
+    // 4. Hata spektrumu: E = FFT([0 | e])
+    std::fill(time_buffer_.begin(), time_buffer_.begin() + B, 0.0f);
+    std::copy(output_block_.begin(), output_block_.end(), time_buffer_.begin() + B);
+    fft_.forward(time_buffer_.data(), error_spectrum_.data());
+
+    // 5. Normalize edilmiş güncelleme: W[p] += μ · conj(X[k - p]) · E / (Px + δ).
+    //    Güç dizisi bin başına adım boyuna çevrilir (bir sonraki blokta yeniden toplanır).
+    for (size_t k = 0; k < bins_; ++k) {
+        power_[k] = step_size_ / (power_[k] + epsilon_);
+    }
+    kernels_.apply_gain(error_spectrum_.data(), power_.data(), bins_);
+    for (size_t p = 0; p < partitions_; ++p) {
+        const std::complex<float>* x = &reference_spectra_[((newest_partition_ + p) % partitions_) * bins_];
+        kernels_.complex_conj_multiply_accumulate(x, error_spectrum_.data(), &weights_[p * bins_], bins_);
+    }
+
+    // 6. Sıradaki bölüme gradient kısıtı: zaman domeninde son B tap sıfırlanır
+    std::complex<float>* w = &weights_[constrain_partition_ * bins_];
+    fft_.inverse(w, time_buffer_.data());
+    std::fill(time_buffer_.begin() + B, time_buffer_.end(), 0.0f);
+    fft_.forward(time_buffer_.data(), w);
+    constrain_partition_ = (constrain_partition_ + 1) % partitions_;
+}
+
+}
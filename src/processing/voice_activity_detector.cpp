@@ -0,0 +1,124 @@
+#include "processing/voice_activity_detector.hpp"
+#include <algorithm>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace processing {
+
+namespace {
+    constexpr float MIN_LEVEL_DB = -100.0f;
+    constexpr float ABSOLUTE_SILENCE_DB = -65.0f;  // Bunun altı her zaman sessizlik
+    constexpr float STRONG_SNR_DB = 15.0f;         // Düzlükten bağımsız konuşma kabulü
+    constexpr float WEAK_SNR_DB = 6.0f;            // Düşük düzlükle birlikte konuşma kabulü
+    constexpr float MAX_SPEECH_FLATNESS = 0.25f;
+
+    // Gürültü tabanının frame başına yükselme hızı (dB). Harmonik konuşma sırasında
+    // yavaş, sessizlikte ve düz (gürültü benzeri) frame'lerde daha hızlı; böylece
+    // ani gürültü artışları kalıcı olarak konuşma sanılmaz. Taban düşüşleri bir
+    // sonraki frame'de yansır.
+    constexpr float FLOOR_RISE_ACTIVE_DB = 0.01f;   // 1 dB/s
+    constexpr float FLOOR_RISE_SILENT_DB = 0.1f;    // 10 dB/s
+    constexpr float FLOOR_FALL_SMOOTHING = 0.5f;
+
+    constexpr float BAND_LOW_HZ = 300.0f;
+    constexpr float BAND_HIGH_HZ = 4000.0f;
+
+    size_t next_power_of_two(size_t value) {
+        size_t result = 4;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+}
+
+VoiceActivityDetector::VoiceActivityDetector(int sample_rate, size_t frame_size)
+    : fft_size_(next_power_of_two(frame_size)),
+      low_bin_(static_cast<size_t>(BAND_LOW_HZ * fft_size_ / sample_rate)),
+      high_bin_(std::min(fft_size_ / 2, static_cast<size_t>(BAND_HIGH_HZ * fft_size_ / sample_rate))),
+      fft_(fft_size_),
+      kernels_(dsp::kernels()),
+      window_(frame_size),
+      frame_buffer_(fft_size_, 0.0f),
+      spectrum_(fft_size_ / 2 + 1) {
+    // Hanning window
+    for (size_t i = 0; i < frame_size; ++i) {
+        window_[i] = 0.5f * (1.0f - std::cos(2.0f * M_PI * i / (frame_size - 1)));
+    }
+    reset();
+}
+
+void VoiceActivityDetector::reset() {
+    initialized_ = false;
+    active_ = false;
+    hangover_ = 0;
+    level_db_ = MIN_LEVEL_DB;
+    noise_floor_db_ = MIN_LEVEL_DB;
+    flatness_ = 1.0f;
+}
+
+float VoiceActivityDetector::spectral_flatness(const int16_t* samples, size_t count) {
+    const size_t length = std::min(count, window_.size());
+    kernels_.int16_to_float(samples, frame_buffer_.data(), length);
+    kernels_.multiply(frame_buffer_.data(), window_.data(), frame_buffer_.data(), length);
+    std::fill(frame_buffer_.begin() + length, frame_buffer_.end(), 0.0f);
+    fft_.forward(frame_buffer_.data(), spectrum_.data());
+
+    double log_sum = 0.0;
+    double sum = 0.0;
+    for (size_t k = low_bin_; k <= high_bin_; ++k) {
+        const double power = static_cast<double>(std::norm(spectrum_[k])) + 1e-12;
+        log_sum += std::log(power);
+        sum += power;
+    }
+    const double bins = static_cast<double>(high_bin_ - low_bin_ + 1);
+    return static_cast<float>(std::exp(log_sum / bins) / (sum / bins));
+}
+
+bool VoiceActivityDetector::process(const int16_t* samples, size_t count) {
+    if (count == 0) {
+        return active_;
+    }
+
+    const float energy = kernels_.sum_squares_int16(samples, count) / (32768.0f * 32768.0f);
+    level_db_ = std::max(MIN_LEVEL_DB, 10.0f * std::log10(energy / static_cast<float>(count) + 1e-12f));
+    if (!initialized_) {
+        noise_floor_db_ = level_db_;
+        initialized_ = true;
+    }
+
+    bool speech = false;
+    bool harmonic = false;
+    const float snr_db = level_db_ - noise_floor_db_;
+    if (level_db_ > ABSOLUTE_SILENCE_DB && snr_db > WEAK_SNR_DB) {
+        // Spektral analiz sadece enerji yeterliyse yapılır
+        flatness_ = spectral_flatness(samples, count);
+        harmonic = flatness_ < MAX_SPEECH_FLATNESS;
+        speech = harmonic || snr_db > STRONG_SNR_DB;
+    } else {
+        flatness_ = 1.0f;
+    }
+
+    if (speech) {
+        hangover_ = HANGOVER_FRAMES;
+        active_ = true;
+    } else if (hangover_ > 0) {
+        --hangover_;
+        active_ = true;
+    } else {
+        active_ = false;
+    }
+
+    // Gürültü tabanını güncelle
+    if (level_db_ < noise_floor_db_) {
+        noise_floor_db_ += FLOOR_FALL_SMOOTHING * (level_db_ - noise_floor_db_);
+    } else {
+        noise_floor_db_ = std::min(level_db_, noise_floor_db_ + (harmonic ? FLOOR_RISE_ACTIVE_DB : FLOOR_RISE_SILENT_DB));
+    }
+    return active_;
+}
+
+}
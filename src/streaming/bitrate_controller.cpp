@@ -0,0 +1,90 @@
+#include "streaming/bitrate_controller.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace streaming {
+
+BitrateController::BitrateController(const Options& options)
+    : options_(options),
+      bitrate_bps_(options.max_bitrate_bps) {
+    settings_.bitrate_bps = options_.max_bitrate_bps;
+    settings_.complexity = options_.max_complexity;
+}
+
+bool BitrateController::on_report(const ReceiverReport& report) {
+    const EncoderSettings previous = settings_;
+    if (report.expected < MIN_EXPECTED_FRAMES) {
+        return false;
+    }
+
+    const double loss = report.loss();
+    smoothed_loss_ += LOSS_SMOOTHING * (loss - smoothed_loss_);
+
+    // Jitter ortalamanın belirgin üstündeyse darboğazda kuyruk birikiyordur
+    const double jitter_ms = report.jitter_ms();
+    const bool queue_building = has_jitter_ && jitter_ms > smoothed_jitter_ms_ + JITTER_RISE_MS;
+    smoothed_jitter_ms_ = has_jitter_ ? smoothed_jitter_ms_ + (jitter_ms - smoothed_jitter_ms_) / 8.0 : jitter_ms;
+    has_jitter_ = true;
+
+    const double receive_bps = report.receive_bitrate_bps;
+    if (loss > HIGH_LOSS) {
+        bitrate_bps_ *= 1.0 - 0.5 * loss;
+        if (receive_bps > 0.0) {
+            ceiling_bps_ = receive_bps;
+            bitrate_bps_ = std::min(bitrate_bps_, DRAIN_FACTOR * receive_bps);
+        }
+    } else if (loss >= LOW_LOSS && receive_bps > 0.0 && bitrate_bps_ > receive_bps) {
+        // Tutma bandında alınandan fazlası darboğazda atılıyordur: alınan hıza in
+        ceiling_bps_ = receive_bps;
+        bitrate_bps_ = DRAIN_FACTOR * receive_bps;
+    } else if (loss < LOW_LOSS && !queue_building) {
+        const bool near_ceiling = bitrate_bps_ >= CEILING_LOW * ceiling_bps_ && bitrate_bps_ <= CEILING_HIGH * ceiling_bps_;
+        const double increased = near_ceiling ? bitrate_bps_ + ADDITIVE_INCREASE_BPS : bitrate_bps_ * INCREASE_FACTOR;
+        bitrate_bps_ = std::max(bitrate_bps_, std::min(increased, RECEIVE_RATE_HEADROOM * receive_bps));
+    }
+    bitrate_bps_ = std::clamp(bitrate_bps_, static_cast<double>(options_.min_bitrate_bps),
+                              static_cast<double>(options_.max_bitrate_bps));
+    update_bitrate();
+
+    settings_.packet_loss_percent = std::clamp(static_cast<int>(std::ceil(smoothed_loss_ * 100.0)), 0, MAX_LOSS_PERCENT);
+    if (settings_.bitrate_bps >= FEC_MIN_BITRATE_BPS) {
+        if (smoothed_loss_ >= FEC_ON_LOSS) {
+            settings_.inband_fec = true;
+        } else if (smoothed_loss_ < FEC_OFF_LOSS) {
+            settings_.inband_fec = false;
+        }
+    }
+    return settings_ != previous;
+}
+
+bool BitrateController::set_rate_limit(int bitrate_bps) {
+    const EncoderSettings previous = settings_;
+    rate_limit_bps_ = std::max(0, bitrate_bps);
+    update_bitrate();
+    return settings_ != previous;
+}
+
+void BitrateController::update_bitrate() {
+    double bitrate_bps = bitrate_bps_;
+    if (rate_limit_bps_ > 0) {
+        bitrate_bps = std::max(std::min(bitrate_bps, static_cast<double>(rate_limit_bps_)),
+                               static_cast<double>(options_.min_bitrate_bps));
+    }
+    // Küçük adımlar encoder'ı her raporda yeniden yapılandırmasın diye 1 kbps'e yuvarlanır
+    settings_.bitrate_bps = static_cast<int>(std::lround(bitrate_bps / 1000.0)) * 1000;
+    if (settings_.bitrate_bps < FEC_MIN_BITRATE_BPS) {
+        settings_.inband_fec = false;
+    }
+}
+
+bool BitrateController::on_encode_load(double load) {
+    const int previous = settings_.complexity;
+    if (load > HIGH_ENCODE_LOAD) {
+        settings_.complexity = std::max(options_.min_complexity, settings_.complexity - 1);
+    } else if (load >= 0.0 && load < LOW_ENCODE_LOAD) {
+        settings_.complexity = std::min(options_.max_complexity, settings_.complexity + 1);
+    }
+    return settings_.complexity != previous;
+}
+
+}
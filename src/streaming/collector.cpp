@@ -0,0 +1,400 @@
+#include "streaming/collector.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace streaming {
+
+namespace {
+    // Sadece TOC byte'ı taşıyan paketler DTX / comfort noise işaretidir
+    constexpr size_t DTX_MAX_SIZE = 2;
+
+    size_t round_up_pow2(size_t value) {
+        size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+}
+
+Collector::Collector(int sample_rate, size_t frame_samples, size_t capacity)
+    : sample_rate_(sample_rate),
+      frame_samples_(static_cast<uint32_t>(frame_samples)),
+      frame_ms_(1000.0 * frame_samples / sample_rate),
+      capacity_(round_up_pow2(capacity)),
+      mask_(capacity_ - 1),
+      slots_(capacity_),
+      copy_pool_(capacity_ + 1, MAX_PAYLOAD_SIZE),
+      reassembly_(REASSEMBLY_SLOTS),
+      frame_pool_(capacity_ + REASSEMBLY_SLOTS + 1, MAX_FRAME_SIZE) {}
+
+void Collector::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::fill(slots_.begin(), slots_.end(), Slot());
+    std::fill(reassembly_.begin(), reassembly_.end(), Reassembly());
+    started_ = false;
+    buffering_ = true;
+    last_played_dtx_ = false;
+    has_last_played_ = false;
+    last_played_timestamp_ = 0;
+    next_sequence_ = 0;
+    depth_ = 0;
+    packet_frames_ = 1;
+    fec_.reset();
+    fec_frames_ = 0;
+    media_since_parity_ = 0;
+    has_transit_ = false;
+    last_transit_ = 0.0;
+    jitter_ = 0.0;
+    stats_ = JitterBufferStats();
+}
+
+void Collector::update_jitter(uint32_t timestamp, Clock::time_point arrival) {
+    if (!has_transit_) {
+        epoch_ = arrival;
+    }
+    // Geliş zamanı ve gönderim zaman damgası aynı birimde (sample) karşılaştırılır;
+    // zaman damgası taşmasında fark işaretli 32-bit olarak yorumlanır
+    const double arrival_samples = std::chrono::duration<double>(arrival - epoch_).count() * sample_rate_;
+    const double transit = arrival_samples - static_cast<double>(static_cast<int32_t>(timestamp));
+    if (has_transit_) {
+        const double d = std::fabs(transit - last_transit_);
+        jitter_ += (d - jitter_) / 16.0;
+    }
+    last_transit_ = transit;
+    has_transit_ = true;
+}
+
+double Collector::target_delay_ms() const {
+    const double jitter_ms = jitter_ * 1000.0 / sample_rate_;
+    // Kayıp bir datagram ancak grubunun paritesiyle kurulabilir: alt sınır grup süresini de kapsar
+    const size_t wait_frames = std::max(packet_frames_, fec_frames_);
+    const double min_delay_ms = std::min(MAX_DELAY_MS, std::max(MIN_DELAY_MS, (wait_frames + 1) * frame_ms_));
+    return std::clamp(JITTER_MULTIPLIER * jitter_ms + frame_ms_, min_delay_ms, MAX_DELAY_MS);
+}
+
+size_t Collector::target_packets() const {
+    return static_cast<size_t>(std::ceil(target_delay_ms() / frame_ms_));
+}
+
+void Collector::set_packet_frames(size_t frames) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    packet_frames_ = std::max<size_t>(1, frames);
+}
+
+Collector::InsertResult Collector::insert(const core::PacketView& packet, Clock::time_point arrival) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return insert_locked(packet, nullptr, arrival, false);
+}
+
+Collector::InsertResult Collector::insert(const core::PooledPacket& packet, Clock::time_point arrival) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return insert_locked(packet.view, &packet.buffer, arrival, false);
+}
+
+Collector::InsertResult Collector::insert_recovered(const core::PacketView& packet, Clock::time_point arrival) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return insert_locked(packet, nullptr, arrival, true);
+}
+
+size_t Collector::recover(const core::PacketView& datagram, core::PacketView* recovered, size_t max_recovered) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (datagram.control()) {
+        const size_t count = fec_.on_parity(datagram, recovered, max_recovered);
+        fec_frames_ = fec_.group_frames();
+        media_since_parity_ = 0;
+        return count;
+    }
+    // Gönderen FEC'i kapattıysa grup süresi artık gecikmeye eklenmez
+    if (++media_since_parity_ > FEC_EXPIRY_PACKETS) {
+        fec_frames_ = 0;
+    }
+    return fec_.on_media(datagram, recovered, max_recovered);
+}
+
+void Collector::release(Slot& slot) {
+    slot.filled = false;
+    slot.buffer.reset();
+    slot.data = nullptr;
+}
+
+Collector::InsertResult Collector::insert_locked(const core::PacketView& packet, const core::PooledBuffer* buffer,
+                                                 Clock::time_point arrival, bool recovered) {
+    if (packet.fragmented()) {
+        return insert_fragment(packet, arrival, recovered);
+    }
+    if (packet.control() || packet.size == 0 || packet.size > MAX_PAYLOAD_SIZE) {
+        ++stats_.discarded;
+        return InsertResult::Invalid;
+    }
+    return store_locked(packet, buffer, arrival, recovered);
+}
+
+void Collector::abandon(Reassembly& frame) {
+    frame.active = false;
+    frame.buffer.reset();
+    ++stats_.incomplete;
+}
+
+void Collector::expire_fragments(Clock::time_point now) {
+    for (Reassembly& frame : reassembly_) {
+        if (!frame.active) {
+            continue;
+        }
+        const bool timed_out =
+            std::chrono::duration<double, std::milli>(now - frame.first_arrival).count() > REASSEMBLY_TIMEOUT_MS;
+        const bool passed = started_ && static_cast<int32_t>(frame.sequence_number - next_sequence_) < 0;
+        if (timed_out || passed) {
+            abandon(frame);
+        }
+    }
+}
+
+Collector::InsertResult Collector::insert_fragment(const core::PacketView& packet, Clock::time_point arrival,
+                                                   bool recovered) {
+    // Parça, başlıktaki frame boyu ve parça sayısıyla tutarlı olmalıdır
+    const size_t count = packet.fragment_count;
+    const size_t frame_size = packet.frame_size;
+    const size_t stride = core::fragment_stride(frame_size, count);
+    const size_t offset = packet.fragment_index * stride;
+    if (frame_size == 0 || frame_size > MAX_FRAME_SIZE || offset >= frame_size ||
+        packet.size != std::min(stride, frame_size - offset)) {
+        ++stats_.discarded;
+        return InsertResult::Invalid;
+    }
+
+    const uint32_t sequence_number = packet.sequence_number;
+    if (started_ && static_cast<int32_t>(sequence_number - next_sequence_) < 0) {
+        ++stats_.late;
+        return InsertResult::Late;
+    }
+    const Slot& slot = slots_[sequence_number & mask_];
+    if (slot.filled && slot.sequence_number == sequence_number) {
+        ++stats_.duplicates;
+        return InsertResult::Duplicate;
+    }
+
+    Reassembly& frame = reassembly_[sequence_number & (REASSEMBLY_SLOTS - 1)];
+    if (frame.active && frame.sequence_number != sequence_number) {
+        if (static_cast<int32_t>(sequence_number - frame.sequence_number) < 0) {
+            // Slotu daha yeni bir frame kullanıyor; bu parçanın frame'i çoktan geride kaldı
+            ++stats_.late;
+            return InsertResult::Late;
+        }
+        abandon(frame);
+    }
+    if (!frame.active) {
+        frame.buffer = frame_pool_.acquire();
+        if (!frame.buffer) {
+            ++stats_.discarded;
+            return InsertResult::Invalid;
+        }
+        frame.active = true;
+        frame.sequence_number = sequence_number;
+        frame.timestamp = packet.timestamp;
+        frame.fragment_count = count;
+        frame.frame_size = frame_size;
+        frame.received = 0;
+        std::fill(std::begin(frame.received_mask), std::end(frame.received_mask), 0);
+        frame.first_arrival = arrival;
+    } else if (frame.fragment_count != count || frame.frame_size != frame_size) {
+        ++stats_.discarded;
+        return InsertResult::Invalid;
+    }
+
+    const uint64_t bit = uint64_t{1} << (packet.fragment_index % 64);
+    uint64_t& mask = frame.received_mask[packet.fragment_index / 64];
+    if (mask & bit) {
+        ++stats_.duplicates;
+        return InsertResult::Duplicate;
+    }
+    mask |= bit;
+    std::copy(packet.data, packet.data + packet.size, frame.buffer.data() + offset);
+    if (++frame.received < frame.fragment_count) {
+        return InsertResult::Partial;
+    }
+
+    // Tamamlandı: frame, buffer'ı taşınarak tek bir paket gibi eklenir
+    core::PacketView complete;
+    complete.sequence_number = frame.sequence_number;
+    complete.timestamp = frame.timestamp;
+    complete.data = frame.buffer.data();
+    complete.size = frame.frame_size;
+    const core::PooledBuffer buffer = std::move(frame.buffer);
+    frame.active = false;
+    ++stats_.reassembled;
+    return store_locked(complete, &buffer, arrival, recovered);
+}
+
+Collector::InsertResult Collector::store_locked(const core::PacketView& packet, const core::PooledBuffer* buffer,
+                                                Clock::time_point arrival, bool recovered) {
+    if (!recovered) {
+        update_jitter(packet.timestamp, arrival);
+    }
+
+    if (!started_) {
+        started_ = true;
+        buffering_ = true;
+        next_sequence_ = packet.sequence_number;
+    }
+
+    const int32_t offset = static_cast<int32_t>(packet.sequence_number - next_sequence_);
+    if (offset < 0) {
+        ++stats_.late;
+        return InsertResult::Late;
+    }
+
+    // Pencere dışı: uzun bir kesinti veya ani bir paket patlaması. Oynatılmayı bekleyen
+    // en eski paketler atılarak pencere yeni paketi kapsayacak şekilde kaydırılır.
+    if (static_cast<size_t>(offset) >= capacity_) {
+        const uint32_t new_next = packet.sequence_number - static_cast<uint32_t>(capacity_ - 1);
+        const size_t shift = std::min(static_cast<size_t>(static_cast<uint32_t>(new_next - next_sequence_)), capacity_);
+        for (size_t i = 0; i < shift; ++i) {
+            Slot& slot = slots_[(next_sequence_ + i) & mask_];
+            if (slot.filled) {
+                release(slot);
+                --depth_;
+                ++stats_.discarded;
+            }
+        }
+        next_sequence_ = new_next;
+    }
+
+    const size_t index = packet.sequence_number & mask_;
+    Slot& slot = slots_[index];
+    if (slot.filled) {
+        ++stats_.duplicates;
+        return InsertResult::Duplicate;
+    }
+
+    if (buffer) {
+        slot.buffer = *buffer;
+        slot.data = packet.data;
+    } else {
+        // Kopya havuzu slot sayısından büyük olduğu için boşalmaz
+        slot.buffer = copy_pool_.acquire();
+        if (!slot.buffer) {
+            ++stats_.discarded;
+            return InsertResult::Invalid;
+        }
+        std::copy(packet.data, packet.data + packet.size, slot.buffer.data());
+        slot.data = slot.buffer.data();
+    }
+    slot.filled = true;
+    slot.sequence_number = packet.sequence_number;
+    slot.timestamp = packet.timestamp;
+    slot.arrival = arrival;
+    slot.size = packet.size;
+    ++depth_;
+    ++stats_.received;
+    return InsertResult::Accepted;
+}
+
+void Collector::drop_oldest() {
+    // Sıradaki dolu slota kadar olan boşluklar kayıp sayılmaz; atlanan paketler
+    // sonradan gelirse geç olarak sayılır
+    while (!slots_[next_sequence_ & mask_].filled) {
+        ++next_sequence_;
+    }
+    release(slots_[next_sequence_ & mask_]);
+    ++next_sequence_;
+    --depth_;
+    ++stats_.discarded;
+}
+
+Collector::Playout Collector::pop(uint8_t* out, size_t capacity, size_t& size, Clock::time_point now) {
+    size = 0;
+    return pop(now, [&](Playout, const uint8_t* data, size_t length) {
+        size = std::min(length, capacity);
+        std::copy(data, data + size, out);
+    });
+}
+
+Collector::Playout Collector::pop_locked(Clock::time_point now, core::PooledBuffer& buffer, const uint8_t*& data,
+                                         size_t& size) {
+    data = nullptr;
+    size = 0;
+    expire_fragments(now);
+
+    if (depth_ == 0) {
+        // DTX işaretinden sonra boşalma beklenen bir durumdur; aksi halde ağ yetişemedi
+        if (started_ && !buffering_ && !last_played_dtx_) {
+            ++stats_.underruns;
+        }
+        buffering_ = true;
+        return Playout::Empty;
+    }
+
+    if (buffering_) {
+        // En eski paket hedef gecikme kadar beklediyse veya hedef derinliğe ulaşıldıysa başla
+        uint32_t oldest = next_sequence_;
+        while (!slots_[oldest & mask_].filled) {
+            ++oldest;
+        }
+        const double waited_ms =
+            std::chrono::duration<double, std::milli>(now - slots_[oldest & mask_].arrival).count();
+        if (depth_ < target_packets() && waited_ms < target_delay_ms()) {
+            return Playout::Empty;
+        }
+        buffering_ = false;
+        // Dolum sırasında oluşan baştaki boşluklar kayıp değil, henüz başlamamış akıştır
+        next_sequence_ = oldest;
+    }
+
+    // Gecikme hedefin belirgin şekilde üstündeyse (ör. ağ patlamasından sonra) geri çek
+    if (depth_ > target_packets() + MAX_EXCESS_PACKETS) {
+        drop_oldest();
+        if (depth_ == 0) {
+            buffering_ = true;
+            return Playout::Empty;
+        }
+    }
+
+    const size_t index = next_sequence_ & mask_;
+    Slot& slot = slots_[index];
+    ++next_sequence_;
+    if (!slot.filled) {
+        // Daha yeni paketler mevcut (depth_ > 0); bu paket kayıp kabul edilir
+        ++stats_.lost;
+        last_played_dtx_ = false;
+
+        // Opus in-band FEC, bir önceki frame'i bir sonraki pakette taşır. Sonraki paket
+        // zaman olarak kayıp frame'in hemen ardından geliyorsa (arada DTX yoksa) verilir.
+        const size_t next_index = next_sequence_ & mask_;
+        const Slot& next = slots_[next_index];
+        if (next.filled && has_last_played_ && next.timestamp - last_played_timestamp_ == 2 * frame_samples_) {
+            // Paket tamponda kalır; tüketici okurken atılabileceği için handle paylaşılır
+            buffer = next.buffer;
+            data = next.data;
+            size = next.size;
+        }
+        last_played_timestamp_ += frame_samples_;
+        return Playout::Lost;
+    }
+
+    // Buffer, tüketici bitene kadar pop()'taki handle ile tutulur
+    data = slot.data;
+    size = slot.size;
+    buffer = std::move(slot.buffer);
+    release(slot);
+    --depth_;
+    ++stats_.played;
+    last_played_dtx_ = slot.size <= DTX_MAX_SIZE;
+    has_last_played_ = true;
+    last_played_timestamp_ = slot.timestamp;
+    return Playout::Frame;
+}
+
+JitterBufferStats Collector::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    JitterBufferStats stats = stats_;
+    stats.depth = depth_;
+    stats.jitter_ms = jitter_ * 1000.0 / sample_rate_;
+    stats.target_delay_ms = target_delay_ms();
+    stats.fec_parity_received = fec_.stats().parity_received;
+    stats.fec_recovered = fec_.stats().recovered;
+    stats.fec_unrecoverable = fec_.stats().unrecoverable;
+    return stats;
+}
+
+}
@@ -0,0 +1,481 @@
+#include "streaming/fec.hpp"
+#include "streaming/feedback.hpp"
+#include "dsp/kernels.hpp"
+#include <algorithm>
+
+namespace streaming {
+
+namespace {
+    constexpr size_t PREFIX_SIZE = FecParityHeader::LENGTH_SIZE + core::PACKET_HEADER_SIZE;
+    // Encoder'ın parite buffer'ında sembolün yeri: en çok üyeli başlığa yer bırakılır
+    constexpr size_t SYMBOL_OFFSET =
+        FecParityHeader::HEADER_SIZE + FecParityHeader::MAX_MEDIA * FecParityHeader::ENTRY_SIZE;
+
+    struct Gf256Tables {
+        uint8_t exp[512];
+        uint8_t log[256];
+
+        Gf256Tables() : exp(), log() {
+            unsigned value = 1;
+            for (unsigned i = 0; i < 255; ++i) {
+                exp[i] = static_cast<uint8_t>(value);
+                log[value] = static_cast<uint8_t>(i);
+                value <<= 1;
+                if (value & 0x100) {
+                    value ^= 0x11D;
+                }
+            }
+            // Çarpımda log toplamı mod 255 alınmadan kullanılabilsin
+            for (unsigned i = 255; i < 512; ++i) {
+                exp[i] = exp[i - 255];
+            }
+        }
+    };
+
+    const Gf256Tables& gf_tables() {
+        static const Gf256Tables tables;
+        return tables;
+    }
+
+    void write_u16(uint8_t* out, size_t value) {
+        out[0] = static_cast<uint8_t>(value >> 8);
+        out[1] = static_cast<uint8_t>(value);
+    }
+
+    size_t read_u16(const uint8_t* in) {
+        return (static_cast<size_t>(in[0]) << 8) | in[1];
+    }
+
+    // out ^= c · in
+    void multiply_add(uint8_t coefficient, const uint8_t* in, uint8_t* out, size_t count) {
+        if (coefficient == 0 || count == 0) {
+            return;
+        }
+        if (coefficient == 1) {
+            dsp::kernels().xor_bytes(in, out, count);
+            return;
+        }
+        uint8_t tables[32];
+        gf256::multiply_tables(coefficient, tables);
+        dsp::kernels().gf256_multiply_add(tables, in, out, count);
+    }
+
+    // Datagramın sembolü: [boy][başlık] öneki ve payload ayrı parçalar olarak eklenir
+    void add_symbol(uint8_t coefficient, const uint8_t* prefix, const uint8_t* payload, size_t payload_size,
+                    uint8_t* out) {
+        multiply_add(coefficient, prefix, out, PREFIX_SIZE);
+        multiply_add(coefficient, payload, out + PREFIX_SIZE, payload_size);
+    }
+
+    // Küçük kare matrisin GF(256)'da tersi (Gauss-Jordan); Cauchy alt matrisleri tersinirdir
+    bool invert(uint8_t (*matrix)[FecParityHeader::MAX_PARITY], uint8_t (*inverse)[FecParityHeader::MAX_PARITY],
+                size_t n) {
+        if (n > FecParityHeader::MAX_PARITY) {
+            return false;
+        }
+        for (size_t r = 0; r < n; ++r) {
+            for (size_t c = 0; c < n; ++c) {
+                inverse[r][c] = r == c ? 1 : 0;
+            }
+        }
+        for (size_t column = 0; column < n; ++column) {
+            size_t pivot = column;
+            while (pivot < n && matrix[pivot][column] == 0) {
+                ++pivot;
+            }
+            if (pivot == n) {
+                return false;
+            }
+            std::swap(matrix[pivot], matrix[column]);
+            std::swap(inverse[pivot], inverse[column]);
+            const uint8_t scale = gf256::inverse(matrix[column][column]);
+            for (size_t c = 0; c < n; ++c) {
+                matrix[column][c] = gf256::multiply(matrix[column][c], scale);
+                inverse[column][c] = gf256::multiply(inverse[column][c], scale);
+            }
+            for (size_t r = 0; r < n; ++r) {
+                const uint8_t factor = matrix[r][column];
+                if (r == column || factor == 0) {
+                    continue;
+                }
+                for (size_t c = 0; c < n; ++c) {
+                    matrix[r][c] ^= gf256::multiply(factor, matrix[column][c]);
+                    inverse[r][c] ^= gf256::multiply(factor, inverse[column][c]);
+                }
+            }
+        }
+        return true;
+    }
+}
+
+namespace gf256 {
+    uint8_t multiply(uint8_t a, uint8_t b) {
+        if (a == 0 || b == 0) {
+            return 0;
+        }
+        const Gf256Tables& tables = gf_tables();
+        return tables.exp[tables.log[a] + tables.log[b]];
+    }
+
+    uint8_t inverse(uint8_t a) {
+        const Gf256Tables& tables = gf_tables();
+        return tables.exp[255 - tables.log[a]];
+    }
+
+    void multiply_tables(uint8_t coefficient, uint8_t* tables) {
+        for (unsigned i = 0; i < 16; ++i) {
+            tables[i] = multiply(coefficient, static_cast<uint8_t>(i));
+            tables[16 + i] = multiply(coefficient, static_cast<uint8_t>(i << 4));
+        }
+    }
+}
+
+size_t FecParityHeader::write(uint8_t* out, size_t capacity) const {
+    if (capacity < wire_size() || media_count == 0 || media_count > MAX_MEDIA) {
+        return 0;
+    }
+    const uint32_t base = members[0].sequence_number;
+    out[0] = static_cast<uint8_t>(media_count);
+    out[1] = static_cast<uint8_t>(parity_index);
+    out[2] = static_cast<uint8_t>(parity_count);
+    write_u16(out + 3, symbol_size);
+    out[5] = static_cast<uint8_t>(base >> 24);
+    out[6] = static_cast<uint8_t>(base >> 16);
+    out[7] = static_cast<uint8_t>(base >> 8);
+    out[8] = static_cast<uint8_t>(base);
+    for (size_t i = 0; i < media_count; ++i) {
+        out[HEADER_SIZE + i * ENTRY_SIZE] = static_cast<uint8_t>(members[i].sequence_number - base);
+        out[HEADER_SIZE + i * ENTRY_SIZE + 1] = members[i].fragment_index;
+    }
+    return wire_size();
+}
+
+bool FecParityHeader::parse(const uint8_t* data, size_t size, FecParityHeader& header) {
+    if (size < HEADER_SIZE) {
+        return false;
+    }
+    header.media_count = data[0];
+    header.parity_index = data[1];
+    header.parity_count = data[2];
+    header.symbol_size = read_u16(data + 3);
+    if (header.media_count == 0 || header.media_count > MAX_MEDIA || header.parity_count == 0 ||
+        header.parity_count > MAX_PARITY || header.parity_index >= header.parity_count ||
+        header.symbol_size < PREFIX_SIZE || header.symbol_size > MAX_SYMBOL_SIZE ||
+        size < header.wire_size() + header.symbol_size) {
+        return false;
+    }
+    const uint32_t base = (static_cast<uint32_t>(data[5]) << 24) | (static_cast<uint32_t>(data[6]) << 16) |
+                          (static_cast<uint32_t>(data[7]) << 8) | data[8];
+    for (size_t i = 0; i < header.media_count; ++i) {
+        header.members[i].sequence_number = base + data[HEADER_SIZE + i * ENTRY_SIZE];
+        header.members[i].fragment_index = data[HEADER_SIZE + i * ENTRY_SIZE + 1];
+    }
+    return true;
+}
+
+uint8_t FecParityHeader::coefficient(size_t parity_index, size_t media_index, size_t parity_count) {
+    if (parity_count == 1) {
+        return 1;
+    }
+    return gf256::inverse(static_cast<uint8_t>((MAX_MEDIA + parity_index) ^ media_index));
+}
+
+FecEncoder::FecEncoder()
+    : parity_(FecParityHeader::MAX_PARITY * core::MAX_DATAGRAM_SIZE, 0),
+      parity_views_() {}
+
+bool FecEncoder::configure(size_t media_count, size_t parity_count) {
+    if (parity_count > FecParityHeader::MAX_PARITY ||
+        (parity_count > 0 && (media_count == 0 || media_count > FecParityHeader::MAX_MEDIA))) {
+        return false;
+    }
+    pending_media_ = media_count;
+    pending_parity_ = parity_count;
+    return true;
+}
+
+void FecEncoder::start_group() {
+    media_count_ = pending_media_;
+    parity_count_ = pending_parity_;
+    for (size_t j = 0; j < FecParityHeader::MAX_PARITY; ++j) {
+        std::fill_n(parity_.data() + j * core::MAX_DATAGRAM_SIZE + SYMBOL_OFFSET, group_.symbol_size, 0);
+    }
+    group_.media_count = 0;
+    group_.parity_count = parity_count_;
+    group_.symbol_size = 0;
+}
+
+void FecEncoder::add(const core::PacketView& packet) {
+    if (group_.media_count == 0) {
+        start_group();
+    }
+    const size_t symbol_size = FecParityHeader::LENGTH_SIZE + packet.wire_size();
+    if (parity_count_ == 0 || packet.control() || symbol_size > FecParityHeader::MAX_SYMBOL_SIZE ||
+        group_.media_count == FecParityHeader::MAX_MEDIA) {
+        return;
+    }
+    // Üyeler ilk datagrama göre 1 byte'lık farkla yazılır; sığmayan grup (pratikte olmaz) bırakılır
+    if (group_.media_count > 0 && packet.sequence_number - group_.members[0].sequence_number > UINT8_MAX) {
+        start_group();
+    }
+
+    const size_t index = group_.media_count++;
+    if (index == 0) {
+        group_timestamp_ = packet.timestamp;
+    }
+    group_.members[index] = {packet.sequence_number, packet.fragment_index};
+
+    uint8_t prefix[PREFIX_SIZE];
+    write_u16(prefix, packet.wire_size());
+    packet.write_header(prefix + FecParityHeader::LENGTH_SIZE);
+    for (size_t j = 0; j < parity_count_; ++j) {
+        uint8_t* symbol = parity_.data() + j * core::MAX_DATAGRAM_SIZE + SYMBOL_OFFSET;
+        add_symbol(FecParityHeader::coefficient(j, index, parity_count_), prefix, packet.data, packet.size, symbol);
+    }
+    group_.symbol_size = std::max(group_.symbol_size, symbol_size);
+}
+
+size_t FecEncoder::end_frame() {
+    if (parity_count_ == 0 || group_.media_count == 0 || group_.media_count < media_count_) {
+        return 0;
+    }
+
+    // Grup tamamlandı: başlık, üye sayısına göre sembolün hemen önüne yazılır
+    const size_t header_size = group_.wire_size();
+    for (size_t j = 0; j < parity_count_; ++j) {
+        uint8_t* payload = parity_.data() + j * core::MAX_DATAGRAM_SIZE + SYMBOL_OFFSET - header_size;
+        group_.parity_index = j;
+        group_.write(payload, header_size);
+
+        core::PacketView& view = parity_views_[j];
+        view.sequence_number = group_sequence_;
+        view.timestamp = group_timestamp_;
+        view.fragment_index = static_cast<uint8_t>(ControlType::FecParity);
+        view.fragment_count = 0;
+        view.frame_size = 0;
+        view.data = payload;
+        view.size = header_size + group_.symbol_size;
+    }
+    ++group_sequence_;
+    group_.media_count = 0;
+    return parity_count_;
+}
+
+FecDecoder::FecDecoder()
+    : history_(MEDIA_HISTORY),
+      groups_(GROUP_HISTORY),
+      work_(2 * FecParityHeader::MAX_PARITY * FecParityHeader::MAX_SYMBOL_SIZE) {
+    for (Group& group : groups_) {
+        group.symbols.resize(FecParityHeader::MAX_PARITY * FecParityHeader::MAX_SYMBOL_SIZE);
+    }
+}
+
+void FecDecoder::reset() {
+    for (Datagram& datagram : history_) {
+        datagram.valid = false;
+    }
+    for (Group& group : groups_) {
+        group.active = false;
+    }
+    history_next_ = 0;
+    groups_next_ = 0;
+    group_frames_ = 0;
+    stats_ = FecStats();
+}
+
+void FecDecoder::remember(const core::PacketView& packet) {
+    Datagram& datagram = history_[history_next_];
+    history_next_ = (history_next_ + 1) % MEDIA_HISTORY;
+    datagram.valid = true;
+    datagram.sequence_number = packet.sequence_number;
+    datagram.fragment_index = packet.fragment_index;
+    datagram.size = packet.wire_size();
+    packet.write_header(datagram.bytes.data());
+    std::copy(packet.data, packet.data + packet.size, datagram.bytes.data() + core::PACKET_HEADER_SIZE);
+}
+
+void FecDecoder::remember(const uint8_t* bytes, size_t size, uint32_t sequence_number, uint8_t fragment_index) {
+    Datagram& datagram = history_[history_next_];
+    history_next_ = (history_next_ + 1) % MEDIA_HISTORY;
+    datagram.valid = true;
+    datagram.sequence_number = sequence_number;
+    datagram.fragment_index = fragment_index;
+    datagram.size = size;
+    std::copy(bytes, bytes + size, datagram.bytes.data());
+}
+
+const FecDecoder::Datagram* FecDecoder::find(const FecParityHeader::Member& member) const {
+    for (const Datagram& datagram : history_) {
+        if (datagram.valid && datagram.sequence_number == member.sequence_number &&
+            datagram.fragment_index == member.fragment_index) {
+            return &datagram;
+        }
+    }
+    return nullptr;
+}
+
+void FecDecoder::retire(Group& group) {
+    if (group.active && !group.resolved) {
+        stats_.unrecoverable += group.missing;
+    }
+    group.active = false;
+}
+
+size_t FecDecoder::on_media(const core::PacketView& packet, core::PacketView* recovered, size_t max_recovered) {
+    if (packet.control() || packet.wire_size() > core::MAX_DATAGRAM_SIZE) {
+        return 0;
+    }
+    remember(packet);
+
+    // Paritesi önce gelmiş (yeniden sıralanmış) grubunu tamamlayabilir; datagram tek bir
+    // grubun üyesidir
+    for (Group& group : groups_) {
+        if (!group.active || group.resolved) {
+            continue;
+        }
+        for (size_t i = 0; i < group.header.media_count; ++i) {
+            const FecParityHeader::Member& member = group.header.members[i];
+            if (member.sequence_number == packet.sequence_number && member.fragment_index == packet.fragment_index) {
+                return try_recover(group, recovered, max_recovered);
+            }
+        }
+    }
+    return 0;
+}
+
+size_t FecDecoder::on_parity(const core::PacketView& packet, core::PacketView* recovered, size_t max_recovered) {
+    FecParityHeader header;
+    if (!FecParityHeader::parse(packet.data, packet.size, header)) {
+        return 0;
+    }
+    ++stats_.parity_received;
+    group_frames_ = header.members[header.media_count - 1].sequence_number - header.members[0].sequence_number + 1;
+
+    Group* group = nullptr;
+    for (Group& candidate : groups_) {
+        if (candidate.active && candidate.sequence_number == packet.sequence_number) {
+            group = &candidate;
+            break;
+        }
+    }
+    if (!group) {
+        // En eski grup yerini yeni gruba bırakır
+        group = &groups_[groups_next_];
+        groups_next_ = (groups_next_ + 1) % GROUP_HISTORY;
+        retire(*group);
+        group->active = true;
+        group->resolved = false;
+        group->sequence_number = packet.sequence_number;
+        group->header = header;
+        group->parity_mask = 0;
+        group->missing = 0;
+    } else if (header.media_count != group->header.media_count || header.parity_count != group->header.parity_count ||
+               header.symbol_size != group->header.symbol_size) {
+        return 0;
+    }
+
+    const unsigned bit = 1u << header.parity_index;
+    if (group->resolved || (group->parity_mask & bit)) {
+        return 0;
+    }
+    group->parity_mask |= bit;
+    const uint8_t* symbol = packet.data + header.wire_size();
+    std::copy(symbol, symbol + header.symbol_size,
+              group->symbols.data() + header.parity_index * FecParityHeader::MAX_SYMBOL_SIZE);
+    return try_recover(*group, recovered, max_recovered);
+}
+
+size_t FecDecoder::try_recover(Group& group, core::PacketView* recovered, size_t max_recovered) {
+    const FecParityHeader& header = group.header;
+    const Datagram* known[FecParityHeader::MAX_MEDIA];
+    size_t missing[FecParityHeader::MAX_MEDIA];
+    size_t missing_count = 0;
+    for (size_t i = 0; i < header.media_count; ++i) {
+        known[i] = find(header.members[i]);
+        if (!known[i]) {
+            missing[missing_count++] = i;
+        }
+    }
+    group.missing = missing_count;
+    if (missing_count == 0) {
+        group.resolved = true;
+        return 0;
+    }
+
+    size_t rows[FecParityHeader::MAX_PARITY];
+    size_t row_count = 0;
+    for (size_t j = 0; j < header.parity_count && row_count < missing_count; ++j) {
+        if (group.parity_mask & (1u << j)) {
+            rows[row_count++] = j;
+        }
+    }
+    if (row_count < missing_count || missing_count > max_recovered) {
+        return 0;
+    }
+
+    // Sendrom: parite eksi bilinen üyelerin katkısı (GF(256)'da çıkarma da XOR'dur)
+    const size_t symbol_size = header.symbol_size;
+    uint8_t* syndromes = work_.data();
+    uint8_t* solved = work_.data() + FecParityHeader::MAX_PARITY * FecParityHeader::MAX_SYMBOL_SIZE;
+    for (size_t r = 0; r < row_count; ++r) {
+        uint8_t* syndrome = syndromes + r * FecParityHeader::MAX_SYMBOL_SIZE;
+        const uint8_t* parity = group.symbols.data() + rows[r] * FecParityHeader::MAX_SYMBOL_SIZE;
+        std::copy(parity, parity + symbol_size, syndrome);
+        for (size_t i = 0; i < header.media_count; ++i) {
+            if (!known[i]) {
+                continue;
+            }
+            if (FecParityHeader::LENGTH_SIZE + known[i]->size > symbol_size) {
+                // Parite bu datagramı kapsayamaz; grup tutarsız
+                group.resolved = true;
+                stats_.unrecoverable += missing_count;
+                return 0;
+            }
+            uint8_t length[FecParityHeader::LENGTH_SIZE];
+            write_u16(length, known[i]->size);
+            const uint8_t coefficient = FecParityHeader::coefficient(rows[r], i, header.parity_count);
+            multiply_add(coefficient, length, syndrome, FecParityHeader::LENGTH_SIZE);
+            multiply_add(coefficient, known[i]->bytes.data(), syndrome + FecParityHeader::LENGTH_SIZE, known[i]->size);
+        }
+    }
+
+    // Eksik sütunların katsayı matrisi tersiyle sendromlardan eksik semboller çözülür
+    uint8_t matrix[FecParityHeader::MAX_PARITY][FecParityHeader::MAX_PARITY];
+    uint8_t inverse[FecParityHeader::MAX_PARITY][FecParityHeader::MAX_PARITY];
+    for (size_t r = 0; r < missing_count; ++r) {
+        for (size_t c = 0; c < missing_count; ++c) {
+            matrix[r][c] = FecParityHeader::coefficient(rows[r], missing[c], header.parity_count);
+        }
+    }
+    group.resolved = true;
+    if (!invert(matrix, inverse, missing_count)) {
+        stats_.unrecoverable += missing_count;
+        return 0;
+    }
+
+    size_t count = 0;
+    for (size_t c = 0; c < missing_count; ++c) {
+        uint8_t* symbol = solved + c * FecParityHeader::MAX_SYMBOL_SIZE;
+        std::fill_n(symbol, symbol_size, 0);
+        for (size_t r = 0; r < missing_count; ++r) {
+            multiply_add(inverse[c][r], syndromes + r * FecParityHeader::MAX_SYMBOL_SIZE, symbol, symbol_size);
+        }
+
+        // Çözülen datagram, paritedeki üye bilgisiyle tutarlı olmalıdır
+        const FecParityHeader::Member& member = header.members[missing[c]];
+        const size_t size = read_u16(symbol);
+        core::PacketView view;
+        if (size + FecParityHeader::LENGTH_SIZE > symbol_size ||
+            !core::PacketView::parse(symbol + FecParityHeader::LENGTH_SIZE, size, view) || view.control() ||
+            view.sequence_number != member.sequence_number || view.fragment_index != member.fragment_index) {
+            ++stats_.unrecoverable;
+            continue;
+        }
+        remember(symbol + FecParityHeader::LENGTH_SIZE, size, member.sequence_number, member.fragment_index);
+        recovered[count++] = view;
+        ++stats_.recovered;
+    }
+    return count;
+}
+
+}
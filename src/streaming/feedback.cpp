@@ -0,0 +1,180 @@
+#include "streaming/feedback.hpp"
+#include <algorithm>
+
+namespace streaming {
+
+namespace {
+    void write_u32(uint8_t* out, uint32_t value) {
+        out[0] = static_cast<uint8_t>(value >> 24);
+        out[1] = static_cast<uint8_t>(value >> 16);
+        out[2] = static_cast<uint8_t>(value >> 8);
+        out[3] = static_cast<uint8_t>(value);
+    }
+
+    void write_u16(uint8_t* out, uint16_t value) {
+        out[0] = static_cast<uint8_t>(value >> 8);
+        out[1] = static_cast<uint8_t>(value);
+    }
+
+    uint32_t read_u32(const uint8_t* bytes) {
+        return (static_cast<uint32_t>(bytes[0]) << 24) | (static_cast<uint32_t>(bytes[1]) << 16) |
+               (static_cast<uint32_t>(bytes[2]) << 8) | static_cast<uint32_t>(bytes[3]);
+    }
+
+    uint16_t read_u16(const uint8_t* bytes) {
+        return static_cast<uint16_t>((bytes[0] << 8) | bytes[1]);
+    }
+
+    uint32_t saturate_u32(double value) {
+        return static_cast<uint32_t>(std::clamp(value, 0.0, static_cast<double>(UINT32_MAX)));
+    }
+}
+
+size_t ReceiverReport::write(uint8_t* out, size_t capacity) const {
+    if (!out || capacity < WIRE_SIZE) {
+        return 0;
+    }
+    write_u32(out, highest_sequence);
+    write_u32(out + 4, cumulative_lost);
+    write_u32(out + 8, jitter_us);
+    write_u32(out + 12, receive_bitrate_bps);
+    write_u16(out + 16, interval_ms);
+    write_u16(out + 18, expected);
+    out[20] = fraction_lost;
+    return WIRE_SIZE;
+}
+
+bool ReceiverReport::parse(const uint8_t* data, size_t size, ReceiverReport& report) {
+    if (!data || size < WIRE_SIZE) {
+        return false;
+    }
+    report.highest_sequence = read_u32(data);
+    report.cumulative_lost = read_u32(data + 4);
+    report.jitter_us = read_u32(data + 8);
+    report.receive_bitrate_bps = read_u32(data + 12);
+    report.interval_ms = read_u16(data + 16);
+    report.expected = read_u16(data + 18);
+    report.fraction_lost = data[20];
+    return true;
+}
+
+bool ArrivalFeedback::add(uint32_t sequence_number, int64_t arrival_us) {
+    if (count == MAX_PACKETS) {
+        return false;
+    }
+    if (count > 0) {
+        const int32_t sequence_offset = static_cast<int32_t>(sequence_number - packets[0].sequence_number);
+        const int64_t time_offset = (arrival_us - packets[0].arrival_us) / TIME_UNIT_US;
+        if (sequence_offset < INT16_MIN || sequence_offset > INT16_MAX || time_offset < 0 || time_offset > UINT16_MAX) {
+            return false;
+        }
+    }
+    packets[count++] = {sequence_number, arrival_us};
+    return true;
+}
+
+size_t ArrivalFeedback::write(uint8_t* out, size_t capacity) const {
+    if (!out || count == 0 || capacity < wire_size()) {
+        return 0;
+    }
+    const Entry& first = packets[0];
+    const uint64_t reference = static_cast<uint64_t>(first.arrival_us);
+    write_u32(out, static_cast<uint32_t>(reference >> 32));
+    write_u32(out + 4, static_cast<uint32_t>(reference));
+    write_u32(out + 8, first.sequence_number);
+    out[12] = static_cast<uint8_t>(count);
+    uint8_t* entry = out + HEADER_SIZE;
+    for (size_t i = 0; i < count; ++i, entry += ENTRY_SIZE) {
+        write_u16(entry, static_cast<uint16_t>(packets[i].sequence_number - first.sequence_number));
+        write_u16(entry + 2, static_cast<uint16_t>((packets[i].arrival_us - first.arrival_us) / TIME_UNIT_US));
+    }
+    return wire_size();
+}
+
+bool ArrivalFeedback::parse(const uint8_t* data, size_t size, ArrivalFeedback& feedback) {
+    if (!data || size < HEADER_SIZE) {
+        return false;
+    }
+    const size_t count = data[12];
+    if (count == 0 || count > MAX_PACKETS || size < HEADER_SIZE + count * ENTRY_SIZE) {
+        return false;
+    }
+    const int64_t reference = static_cast<int64_t>((static_cast<uint64_t>(read_u32(data)) << 32) | read_u32(data + 4));
+    const uint32_t base_sequence = read_u32(data + 8);
+    const uint8_t* entry = data + HEADER_SIZE;
+    for (size_t i = 0; i < count; ++i, entry += ENTRY_SIZE) {
+        feedback.packets[i].sequence_number = base_sequence + static_cast<uint32_t>(static_cast<int16_t>(read_u16(entry)));
+        feedback.packets[i].arrival_us = reference + read_u16(entry + 2) * TIME_UNIT_US;
+    }
+    feedback.count = count;
+    return true;
+}
+
+void ReceptionMonitor::on_frames(uint32_t sequence_number, size_t frames, size_t payload_bytes) {
+    received_bytes_.store(received_bytes_.load(std::memory_order_relaxed) + payload_bytes, std::memory_order_relaxed);
+    if (frames == 0) {
+        return;
+    }
+
+    const uint32_t last = sequence_number + static_cast<uint32_t>(frames - 1);
+    if (!started_.load(std::memory_order_relaxed)) {
+        base_sequence_ = sequence_number;
+        highest_sequence_.store(base_sequence_ + frames - 1, std::memory_order_relaxed);
+        received_.store(frames, std::memory_order_relaxed);
+        started_.store(true, std::memory_order_release);
+        return;
+    }
+
+    // Sıra numarası taşmaları işaretli farkla genişletilir; eski (sıra dışı) frame'ler
+    // en yüksek numarayı değiştirmez
+    const uint64_t highest = highest_sequence_.load(std::memory_order_relaxed);
+    const int32_t delta = static_cast<int32_t>(last - static_cast<uint32_t>(highest));
+    if (delta > 0) {
+        highest_sequence_.store(highest + static_cast<uint64_t>(delta), std::memory_order_relaxed);
+    }
+    received_.store(received_.load(std::memory_order_relaxed) + frames, std::memory_order_relaxed);
+}
+
+bool ReceptionMonitor::report(Clock::time_point now, double jitter_ms, ReceiverReport& out) {
+    if (!started_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    const uint64_t highest = highest_sequence_.load(std::memory_order_relaxed);
+    const uint64_t expected = highest - base_sequence_ + 1;
+    const uint64_t received = received_.load(std::memory_order_relaxed);
+    const uint64_t bytes = received_bytes_.load(std::memory_order_relaxed);
+
+    if (!has_prior_) {
+        has_prior_ = true;
+        prior_time_ = now;
+        prior_expected_ = expected;
+        prior_received_ = received;
+        prior_bytes_ = bytes;
+        return false;
+    }
+
+    const double interval_ms = std::chrono::duration<double, std::milli>(now - prior_time_).count();
+    if (interval_ms <= 0.0) {
+        return false;
+    }
+    const int64_t expected_interval = static_cast<int64_t>(expected - prior_expected_);
+    const int64_t lost_interval = expected_interval - static_cast<int64_t>(received - prior_received_);
+
+    out.highest_sequence = static_cast<uint32_t>(highest);
+    out.cumulative_lost = expected > received ? static_cast<uint32_t>(std::min<uint64_t>(expected - received, UINT32_MAX)) : 0;
+    out.jitter_us = saturate_u32(jitter_ms * 1000.0);
+    out.receive_bitrate_bps = saturate_u32((bytes - prior_bytes_) * 8.0 * 1000.0 / interval_ms);
+    out.interval_ms = static_cast<uint16_t>(std::min(interval_ms, static_cast<double>(UINT16_MAX)));
+    out.expected = static_cast<uint16_t>(std::clamp<int64_t>(expected_interval, 0, UINT16_MAX));
+    out.fraction_lost = (expected_interval > 0 && lost_interval > 0)
+        ? static_cast<uint8_t>(std::min<int64_t>(255, (lost_interval << 8) / expected_interval))
+        : 0;
+
+    prior_time_ = now;
+    prior_expected_ = expected;
+    prior_received_ = received;
+    prior_bytes_ = bytes;
+    return true;
+}
+
+}
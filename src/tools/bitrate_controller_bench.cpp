@@ -0,0 +1,214 @@
+// src/tools/bitrate_controller_bench.cpp - Alıcı geri bildirimli bitrate kontrolü simülasyonu
+//
+// Gönderici her 10 ms'de bir frame'i, kapasitesi zamanla değişen bir darboğaz
+// bağlantısından (drop-tail kuyruk) geçirir. Alıcı ReceptionMonitor ile her 250 ms'de
+// bir rapor üretir; rapor ters yönden (tıkanmasız) göndericiye ulaşır ve
+// BitrateController kodlayıcı ayarlarını günceller. Sabit 64 kbps ile karşılaştırılır:
+// kısıtlı fazlarda kayıp ve kuyruk gecikmesi, kapasite geri geldiğinde toparlanma süresi
+// raporlanır. Bir süre yüksek kodlama yükü verilerek karmaşıklığın düşüp geri çıktığı
+// da doğrulanır. Sonuçlar eşiklerin dışındaysa sıfırdan farklı bir kodla çıkar.
+
+#include "streaming/feedback.hpp"
+#include "streaming/bitrate_controller.hpp"
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cmath>
+
+#define RESET   "\033[0m"
+#define RED     "\033[31m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define CYAN    "\033[36m"
+
+namespace {
+    constexpr int FRAME_MS = 10;
+    constexpr int REPORT_MS = 250;
+    constexpr int PROPAGATION_MS = 20;
+    constexpr double QUEUE_LIMIT_MS = 100.0;    // Drop-tail kuyruğun tutabildiği süre
+    constexpr size_t HEADER_BYTES = 40;         // IPv4 + UDP + paket başlığı
+    constexpr int HIGH_LOAD_START_MS = 30000;   // Bu aralıkta kodlama yükü frame süresinin %70'i
+    constexpr int HIGH_LOAD_END_MS = 34000;
+
+    struct Phase {
+        int start_ms;
+        double capacity_kbps;  // Başlıklar dahil bağlantı kapasitesi
+    };
+
+    const Phase PHASES[] = {
+        {0,     200.0},
+        {20000,  64.0},   // 64 kbps: payload için ~32 kbps kalır
+        {40000,  48.0},   // ~16 kbps
+        {60000, 200.0},
+    };
+    constexpr size_t PHASE_COUNT = sizeof(PHASES) / sizeof(PHASES[0]);
+    constexpr int DURATION_MS = 80000;
+
+    struct PhaseResult {
+        size_t sent = 0;
+        size_t delivered = 0;
+        double payload_bits = 0.0;
+        double queue_delay_ms = 0.0;
+    };
+
+    struct Result {
+        PhaseResult phases[PHASE_COUNT];
+        double recovery_ms = -1.0;      // Son fazda bitrate'in maksimumun %90'ına dönmesi
+        int min_complexity = 0;
+        int final_complexity = 0;
+        int final_bitrate_bps = 0;
+        size_t reports = 0;
+    };
+
+    struct InFlight {
+        uint32_t sequence;
+        size_t payload_bytes;
+        int send_ms;
+        double arrival_ms;
+    };
+
+    size_t phase_at(int t) {
+        size_t phase = 0;
+        while (phase + 1 < PHASE_COUNT && PHASES[phase + 1].start_ms <= t) {
+            ++phase;
+        }
+        return phase;
+    }
+
+    Result simulate(bool adaptive) {
+        streaming::BitrateController::Options options;
+        streaming::BitrateController controller(options);
+        streaming::ReceptionMonitor monitor;
+        const auto epoch = streaming::ReceptionMonitor::Clock::now();
+
+        Result result;
+        result.min_complexity = controller.settings().complexity;
+        std::deque<InFlight> in_flight;
+        std::deque<std::pair<double, streaming::ReceiverReport>> reports;
+        double link_free_ms = 0.0;
+        uint32_t sequence = 0;
+
+        // RFC 3550 jitter (ms)
+        double jitter_ms = 0.0;
+        double last_transit = 0.0;
+        bool has_transit = false;
+
+        for (int t = 0; t < DURATION_MS; ++t) {
+            const size_t phase = phase_at(t);
+
+            // Alıcı: geliş
+            while (!in_flight.empty() && in_flight.front().arrival_ms <= t) {
+                const InFlight& packet = in_flight.front();
+                monitor.on_frames(packet.sequence, 1, packet.payload_bytes);
+                const double transit = packet.arrival_ms - packet.send_ms;
+                if (has_transit) {
+                    jitter_ms += (std::fabs(transit - last_transit) - jitter_ms) / 16.0;
+                }
+                last_transit = transit;
+                has_transit = true;
+                in_flight.pop_front();
+            }
+
+            // Alıcı: rapor (tıkanmasız ters yol)
+            if (t % REPORT_MS == 0) {
+                streaming::ReceiverReport report;
+                const auto now = epoch + std::chrono::milliseconds(t);
+                if (monitor.report(now, jitter_ms, report)) {
+                    reports.emplace_back(t + PROPAGATION_MS, report);
+                }
+            }
+
+            // Gönderici: rapor işleme
+            while (!reports.empty() && reports.front().first <= t) {
+                ++result.reports;
+                if (adaptive) {
+                    controller.on_report(reports.front().second);
+                    const bool high_load = t >= HIGH_LOAD_START_MS && t < HIGH_LOAD_END_MS;
+                    controller.on_encode_load(high_load ? 0.7 : 0.1);
+                    result.min_complexity = std::min(result.min_complexity, controller.settings().complexity);
+                }
+                reports.pop_front();
+            }
+
+            // Gönderici: frame
+            if (t % FRAME_MS == 0) {
+                const int bitrate_bps = adaptive ? controller.settings().bitrate_bps : options.max_bitrate_bps;
+                const size_t payload_bytes = static_cast<size_t>(bitrate_bps) * FRAME_MS / 8000;
+                PhaseResult& stats = result.phases[phase];
+                ++stats.sent;
+
+                // Drop-tail kuyruk: bağlantı paketi kuyruktaki süre sınırı içinde gönderemiyorsa atılır
+                const double service_ms = (payload_bytes + HEADER_BYTES) * 8.0 / PHASES[phase].capacity_kbps;
+                const double start_ms = std::max(link_free_ms, static_cast<double>(t));
+                if (start_ms - t <= QUEUE_LIMIT_MS) {
+                    link_free_ms = start_ms + service_ms;
+                    in_flight.push_back({sequence, payload_bytes, t, link_free_ms + PROPAGATION_MS});
+                    ++stats.delivered;
+                    stats.payload_bits += payload_bytes * 8.0;
+                    stats.queue_delay_ms += link_free_ms - t;
+                }
+                ++sequence;
+
+                if (adaptive && phase == PHASE_COUNT - 1 && result.recovery_ms < 0.0 &&
+                    bitrate_bps >= 0.9 * options.max_bitrate_bps) {
+                    result.recovery_ms = t - PHASES[phase].start_ms;
+                }
+            }
+        }
+
+        result.final_complexity = controller.settings().complexity;
+        result.final_bitrate_bps = adaptive ? controller.settings().bitrate_bps : options.max_bitrate_bps;
+        return result;
+    }
+
+    double loss_percent(const PhaseResult& phase) {
+        return phase.sent > 0 ? 100.0 * (phase.sent - phase.delivered) / phase.sent : 0.0;
+    }
+
+    void print(const char* name, const Result& result) {
+        std::cout << "\n" << YELLOW << "📊 " << name << RESET << " (" << result.reports << " rapor)" << std::endl;
+        for (size_t i = 0; i < PHASE_COUNT; ++i) {
+            const PhaseResult& phase = result.phases[i];
+            const int end_ms = i + 1 < PHASE_COUNT ? PHASES[i + 1].start_ms : DURATION_MS;
+            std::cout << "   " << PHASES[i].start_ms / 1000 << "-" << end_ms / 1000 << " s, kapasite "
+                      << PHASES[i].capacity_kbps << " kbps: payload " << phase.payload_bits / (end_ms - PHASES[i].start_ms)
+                      << " kbps, kayıp %" << loss_percent(phase) << ", kuyruk gecikmesi ort "
+                      << (phase.delivered > 0 ? phase.queue_delay_ms / phase.delivered : 0.0) << " ms" << std::endl;
+        }
+    }
+}
+
+int main() {
+    std::cout << CYAN << "🧪 Bitrate Kontrolü Simülasyonu (rapor aralığı " << REPORT_MS << " ms, kuyruk "
+              << QUEUE_LIMIT_MS << " ms, başlık " << HEADER_BYTES << " byte)" << RESET << std::endl;
+
+    const Result fixed = simulate(false);
+    const Result adaptive = simulate(true);
+    print("Sabit 64 kbps", fixed);
+    print("Uyarlanır", adaptive);
+
+    // Kısıtlı fazlar (1 ve 2) boyunca kayıp
+    auto constrained_loss = [](const Result& result) {
+        const size_t sent = result.phases[1].sent + result.phases[2].sent;
+        const size_t delivered = result.phases[1].delivered + result.phases[2].delivered;
+        return 100.0 * (sent - delivered) / sent;
+    };
+    const double fixed_loss = constrained_loss(fixed);
+    const double adaptive_loss = constrained_loss(adaptive);
+    const bool loss_ok = adaptive_loss < 5.0 && adaptive_loss < fixed_loss / 4.0;
+    const bool recovery_ok = adaptive.recovery_ms >= 0.0 && adaptive.recovery_ms <= 15000.0;
+    const bool complexity_ok = adaptive.min_complexity < adaptive.final_complexity &&
+                               adaptive.final_complexity == streaming::BitrateController::Options().max_complexity;
+
+    std::cout << "\n" << YELLOW << "📊 Sonuç" << RESET << std::endl;
+    std::cout << "   Kısıtlı fazlarda kayıp: sabit %" << fixed_loss << ", uyarlanır %" << adaptive_loss
+              << "  " << (loss_ok ? GREEN "OK" : RED "FAIL") << RESET << std::endl;
+    std::cout << "   Kapasite geri gelince %90'a dönüş: " << adaptive.recovery_ms / 1000.0 << " s (son bitrate "
+              << adaptive.final_bitrate_bps / 1000 << " kbps)  " << (recovery_ok ? GREEN "OK" : RED "FAIL") << RESET << std::endl;
+    std::cout << "   Karmaşıklık: yüksek yükte en düşük " << adaptive.min_complexity << ", sonda "
+              << adaptive.final_complexity << "  " << (complexity_ok ? GREEN "OK" : RED "FAIL") << RESET << std::endl;
+    return loss_ok && recovery_ok && complexity_ok ? 0 : 1;
+}
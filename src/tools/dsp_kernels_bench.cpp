@@ -0,0 +1,226 @@
+// src/tools/dsp_kernels_bench.cpp - SIMD kernellerinin doğrulaması ve benchmark'ı
+//
+// Bu makinede desteklenen her SIMD seviyesini skaler referansla karşılaştırır:
+// eleman bazlı kerneller bit-bit aynı olmalı, toplama yapan kerneller (dot,
+// sum_squares) göreli tolerans içinde kalmalı. Karmaşık çarpıp toplama ve güç
+// kernelleri (PBFDAF eko filtresinin bin döngüleri) de eleman bazlıdır ve bit-bit
+// karşılaştırılır. FEC'in byte kernelleri (XOR ve GF(256) çarpıp toplama) rastgele yarım
+// byte tablolarıyla aynı şekilde bit-bit karşılaştırılır. Kuyruk yollarını da kapsamak
+// için 0-67 arası tüm uzunluklar ve tipik frame boyutları denenir. Uyuşmazlıkta
+// sıfırdan farklı bir kodla çıkar.
+
+#include "dsp/kernels.hpp"
+#include <iostream>
+#include <vector>
+#include <complex>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <algorithm>
+
+#define RESET   "\033[0m"
+#define RED     "\033[31m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define CYAN    "\033[36m"
+
+namespace {
+    constexpr float SUM_TOLERANCE = 1e-5f;
+
+    struct TestData {
+        std::vector<int16_t> samples;
+        std::vector<float> a;
+        std::vector<float> b;
+        std::vector<float> y;
+        std::vector<float> gains;
+        std::vector<std::complex<float>> bins;
+        std::vector<std::complex<float>> weights;
+        std::vector<std::complex<float>> spectrum;
+        std::vector<uint8_t> bytes;
+        std::vector<uint8_t> parity;
+        uint8_t tables[32];
+
+        explicit TestData(size_t n, std::mt19937& rng)
+            : samples(n), a(n), b(n), y(n), gains(n), bins(n), weights(n), spectrum(n), bytes(n), parity(n) {
+            std::uniform_int_distribution<int> sample_dist(-32768, 32767);
+            // [-1.5, 1.5]: float_to_int16'nın kırpma yolunu da kapsar
+            std::uniform_real_distribution<float> value_dist(-1.5f, 1.5f);
+            std::uniform_real_distribution<float> gain_dist(0.0f, 1.0f);
+            for (size_t i = 0; i < n; ++i) {
+                samples[i] = static_cast<int16_t>(sample_dist(rng));
+                a[i] = value_dist(rng);
+                b[i] = value_dist(rng);
+                y[i] = value_dist(rng);
+                gains[i] = gain_dist(rng);
+                bins[i] = std::complex<float>(value_dist(rng), value_dist(rng));
+                weights[i] = std::complex<float>(value_dist(rng), value_dist(rng));
+                spectrum[i] = std::complex<float>(value_dist(rng), value_dist(rng));
+                bytes[i] = static_cast<uint8_t>(rng());
+                parity[i] = static_cast<uint8_t>(rng());
+            }
+            for (uint8_t& entry : tables) {
+                entry = static_cast<uint8_t>(rng());
+            }
+        }
+    };
+
+    template <typename T>
+    bool bit_equal(const std::vector<T>& lhs, const std::vector<T>& rhs) {
+        return lhs.empty() || std::memcmp(lhs.data(), rhs.data(), lhs.size() * sizeof(T)) == 0;
+    }
+
+    bool sum_close(float reference, float value, float scale) {
+        return std::abs(reference - value) <= SUM_TOLERANCE * std::max(1.0f, scale);
+    }
+
+    // Bir seviyeyi tek bir uzunlukta skaler referansla karşılaştırır
+    bool verify(const dsp::KernelTable& ref, const dsp::KernelTable& simd, size_t n, std::mt19937& rng,
+                const char*& failed_kernel) {
+        const TestData d(n, rng);
+
+        std::vector<float> ref_f(n), simd_f(n);
+        ref.int16_to_float(d.samples.data(), ref_f.data(), n);
+        simd.int16_to_float(d.samples.data(), simd_f.data(), n);
+        if (!bit_equal(ref_f, simd_f)) { failed_kernel = "int16_to_float"; return false; }
+
+        std::vector<int16_t> ref_s(n), simd_s(n);
+        ref.float_to_int16(d.a.data(), ref_s.data(), n);
+        simd.float_to_int16(d.a.data(), simd_s.data(), n);
+        if (!bit_equal(ref_s, simd_s)) { failed_kernel = "float_to_int16"; return false; }
+
+        float abs_dot = 0.0f;
+        for (size_t i = 0; i < n; ++i) { abs_dot += std::abs(d.a[i] * d.b[i]); }
+        if (!sum_close(ref.dot(d.a.data(), d.b.data(), n), simd.dot(d.a.data(), d.b.data(), n), abs_dot)) {
+            failed_kernel = "dot";
+            return false;
+        }
+
+        std::vector<float> ref_y = d.y, simd_y = d.y;
+        ref.axpy(0.37f, d.a.data(), ref_y.data(), n);
+        simd.axpy(0.37f, d.a.data(), simd_y.data(), n);
+        if (!bit_equal(ref_y, simd_y)) { failed_kernel = "axpy"; return false; }
+
+        ref.multiply(d.a.data(), d.b.data(), ref_f.data(), n);
+        simd.multiply(d.a.data(), d.b.data(), simd_f.data(), n);
+        if (!bit_equal(ref_f, simd_f)) { failed_kernel = "multiply"; return false; }
+
+        ref_y = d.y;
+        simd_y = d.y;
+        ref.multiply_accumulate(d.a.data(), d.b.data(), ref_y.data(), n);
+        simd.multiply_accumulate(d.a.data(), d.b.data(), simd_y.data(), n);
+        if (!bit_equal(ref_y, simd_y)) { failed_kernel = "multiply_accumulate"; return false; }
+
+        const float ref_energy = ref.sum_squares_int16(d.samples.data(), n);
+        if (!sum_close(ref_energy, simd.sum_squares_int16(d.samples.data(), n), ref_energy)) {
+            failed_kernel = "sum_squares_int16";
+            return false;
+        }
+
+        std::vector<std::complex<float>> ref_bins = d.bins, simd_bins = d.bins;
+        ref.apply_gain(ref_bins.data(), d.gains.data(), n);
+        simd.apply_gain(simd_bins.data(), d.gains.data(), n);
+        if (!bit_equal(ref_bins, simd_bins)) { failed_kernel = "apply_gain"; return false; }
+
+        ref_bins = d.spectrum;
+        simd_bins = d.spectrum;
+        ref.complex_multiply_accumulate(d.weights.data(), d.bins.data(), ref_bins.data(), n);
+        simd.complex_multiply_accumulate(d.weights.data(), d.bins.data(), simd_bins.data(), n);
+        if (!bit_equal(ref_bins, simd_bins)) { failed_kernel = "complex_multiply_accumulate"; return false; }
+
+        ref_bins = d.spectrum;
+        simd_bins = d.spectrum;
+        ref.complex_conj_multiply_accumulate(d.bins.data(), d.weights.data(), ref_bins.data(), n);
+        simd.complex_conj_multiply_accumulate(d.bins.data(), d.weights.data(), simd_bins.data(), n);
+        if (!bit_equal(ref_bins, simd_bins)) { failed_kernel = "complex_conj_multiply_accumulate"; return false; }
+
+        ref_y = d.y;
+        simd_y = d.y;
+        ref.norm_accumulate(d.bins.data(), ref_y.data(), n);
+        simd.norm_accumulate(d.bins.data(), simd_y.data(), n);
+        if (!bit_equal(ref_y, simd_y)) { failed_kernel = "norm_accumulate"; return false; }
+
+        std::vector<uint8_t> ref_b = d.parity, simd_b = d.parity;
+        ref.xor_bytes(d.bytes.data(), ref_b.data(), n);
+        simd.xor_bytes(d.bytes.data(), simd_b.data(), n);
+        if (!bit_equal(ref_b, simd_b)) { failed_kernel = "xor_bytes"; return false; }
+
+        ref.gf256_multiply_add(d.tables, d.bytes.data(), ref_b.data(), n);
+        simd.gf256_multiply_add(d.tables, d.bytes.data(), simd_b.data(), n);
+        if (!bit_equal(ref_b, simd_b)) { failed_kernel = "gf256_multiply_add"; return false; }
+
+        return true;
+    }
+
+    // Tipik bir frame'deki kernel zincirinin maliyeti (ns / çağrı turu)
+    double time_ns(const dsp::KernelTable& k, size_t n, int iterations) {
+        std::mt19937 rng(3);
+        TestData d(n, rng);
+        std::vector<float> f(n);
+        std::vector<int16_t> s(n);
+        volatile float sink = 0.0f;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int it = 0; it < iterations; ++it) {
+            k.int16_to_float(d.samples.data(), f.data(), n);
+            sink = sink + k.dot(f.data(), d.b.data(), n);
+            k.axpy(1e-6f, f.data(), d.y.data(), n);
+            k.multiply(f.data(), d.gains.data(), f.data(), n);
+            k.multiply_accumulate(f.data(), d.gains.data(), d.a.data(), n);
+            sink = sink + k.sum_squares_int16(d.samples.data(), n);
+            k.apply_gain(d.bins.data(), d.gains.data(), n);
+            k.complex_multiply_accumulate(d.weights.data(), d.bins.data(), d.spectrum.data(), n);
+            k.complex_conj_multiply_accumulate(d.bins.data(), d.spectrum.data(), d.weights.data(), n);
+            k.norm_accumulate(d.bins.data(), d.a.data(), n);
+            k.float_to_int16(f.data(), s.data(), n);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+    }
+}
+
+int main() {
+    std::cout << CYAN << "🧪 DSP Kernel Doğrulama ve Benchmark" << RESET << std::endl;
+    std::cout << "   Seçilen seviye: " << GREEN << dsp::simd_level_name(dsp::simd_level()) << RESET << std::endl;
+
+    const dsp::SimdLevel levels[] = {dsp::SimdLevel::Scalar, dsp::SimdLevel::Sse41, dsp::SimdLevel::Avx2,
+                                     dsp::SimdLevel::Avx512, dsp::SimdLevel::Neon};
+    const size_t frame_sizes[] = {240, 480, 960, 1024};
+    const dsp::KernelTable& scalar = *dsp::kernels_for(dsp::SimdLevel::Scalar);
+    std::mt19937 rng(42);
+    bool all_ok = true;
+
+    for (dsp::SimdLevel level : levels) {
+        const dsp::KernelTable* table = dsp::kernels_for(level);
+        if (!table) {
+            std::cout << "   " << YELLOW << dsp::simd_level_name(level) << RESET << "  desteklenmiyor, atlandı" << std::endl;
+            continue;
+        }
+
+        bool ok = true;
+        const char* failed_kernel = "";
+        size_t failed_length = 0;
+        for (size_t n = 0; n < 68 && ok; ++n) {
+            ok = verify(scalar, *table, n, rng, failed_kernel);
+            failed_length = n;
+        }
+        for (size_t n : frame_sizes) {
+            if (!ok) { break; }
+            ok = verify(scalar, *table, n, rng, failed_kernel);
+            failed_length = n;
+        }
+        all_ok = all_ok && ok;
+
+        std::cout << "   " << YELLOW << dsp::simd_level_name(level) << RESET;
+        for (size_t n : {480, 1024}) {
+            std::cout << "  n=" << n << ": " << time_ns(*table, n, 20000) << " ns";
+        }
+        if (ok) {
+            std::cout << "  " << GREEN << "OK" << RESET << std::endl;
+        } else {
+            std::cout << "  " << RED << "FAIL (" << failed_kernel << ", n=" << failed_length << ")" << RESET << std::endl;
+        }
+    }
+
+    return all_ok ? 0 : 1;
+}
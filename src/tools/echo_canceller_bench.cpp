@@ -0,0 +1,111 @@
+// src/tools/echo_canceller_bench.cpp - EchoCanceller benchmark'ı
+//
+// 128-4096 tap aralığında 10ms'lik (480 örnek) bir frame için on_playback + process
+// maliyetini ölçer. Karşılaştırma için eski uygulama (her referans örneğinde
+// copy_backward ile kaydırma ve her mikrofon örneğinde sıfırdan güç hesabı) burada
+// birebir tutulur.
+
+#include "processing/echo_canceller.hpp"
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+#define RESET   "\033[0m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define CYAN    "\033[36m"
+
+namespace {
+    constexpr size_t FRAME_SAMPLES = 480;
+
+    // Eski EchoCanceller'ın kopyası
+    class LegacyEchoCanceller {
+    public:
+        LegacyEchoCanceller(size_t filter_length, float step_size)
+            : filter_length_(filter_length), step_size_(step_size), epsilon_(1e-6f),
+              filter_weights_(filter_length, 0.0f), reference_buffer_(filter_length, 0.0f) {}
+
+        void on_playback(const int16_t* samples, size_t count) {
+            for (size_t n = 0; n < count; ++n) {
+                std::copy_backward(reference_buffer_.begin(), reference_buffer_.end() - 1, reference_buffer_.end());
+                reference_buffer_[0] = static_cast<float>(samples[n]) / 32768.0f;
+            }
+        }
+
+        void process(int16_t* capture, size_t count) {
+            for (size_t n = 0; n < count; ++n) {
+                float mic_signal = static_cast<float>(capture[n]) / 32768.0f;
+                float echo_estimate = 0.0f;
+                for (size_t i = 0; i < filter_length_; ++i) {
+                    echo_estimate += filter_weights_[i] * reference_buffer_[i];
+                }
+                float error_signal = mic_signal - echo_estimate;
+                float ref_power = 0.0f;
+                for (float val : reference_buffer_) {
+                    ref_power += val * val;
+                }
+                if (ref_power > 0.0f) {
+                    float adaptive_step = step_size_ / (epsilon_ + ref_power);
+                    for (size_t i = 0; i < filter_length_; ++i) {
+                        filter_weights_[i] += adaptive_step * error_signal * reference_buffer_[i];
+                    }
+                }
+                capture[n] = static_cast<int16_t>(std::clamp(error_signal * 32768.0f, -32768.0f, 32767.0f));
+            }
+        }
+
+    private:
+        const size_t filter_length_;
+        const float step_size_;
+        const float epsilon_;
+        std::vector<float> filter_weights_;
+        std::vector<float> reference_buffer_;
+    };
+
+    // Frame başına ortalama süre (µs)
+    template <typename Canceller>
+    double time_per_frame_us(Canceller& canceller, int frames) {
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<int> dist(-8000, 8000);
+        std::vector<int16_t> capture(FRAME_SAMPLES);
+        std::vector<int16_t> playback(FRAME_SAMPLES);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int f = 0; f < frames; ++f) {
+            for (auto& s : capture) { s = static_cast<int16_t>(dist(rng)); }
+            for (auto& s : playback) { s = static_cast<int16_t>(dist(rng)); }
+            canceller.process(capture.data(), capture.size());
+            canceller.on_playback(playback.data(), playback.size());
+        }
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / frames;
+    }
+}
+
+int main() {
+    std::cout << CYAN << "🧪 Echo Canceller Benchmark (µs / 10ms frame)" << RESET << std::endl;
+
+    for (size_t length = 128; length <= 4096; length *= 2) {
+        const int frames = length <= 512 ? 100 : 20;
+
+        LegacyEchoCanceller legacy(length, 0.1f);
+        processing::EchoCanceller nlms(length, 0.1f, processing::EchoCanceller::Engine::TimeDomainNlms);
+        processing::EchoCanceller block(length, 0.5f, processing::EchoCanceller::Engine::PartitionedBlock);
+
+        const double legacy_us = time_per_frame_us(legacy, frames);
+        const double nlms_us = time_per_frame_us(nlms, frames);
+        const double block_us = time_per_frame_us(block, frames * 10);
+
+        std::cout << "   " << YELLOW << "taps=" << length << RESET
+                  << "  legacy: " << legacy_us << " µs"
+                  << ", circular NLMS: " << nlms_us << " µs"
+                  << " (" << GREEN << (legacy_us / nlms_us) << "x" << RESET << ")"
+                  << ", partitioned: " << block_us << " µs"
+                  << " (" << GREEN << (legacy_us / block_us) << "x" << RESET << ")" << std::endl;
+    }
+    return 0;
+}
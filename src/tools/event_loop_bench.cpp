@@ -0,0 +1,146 @@
+// src/tools/event_loop_bench.cpp - Tek event loop thread'inde çok soketli UDP alımı
+//
+// Loopback üzerinde SOCKET_COUNT alıcı aynı EventLoop'a ve aynı buffer havuzuna
+// kaydedilir. Toplu gönderici her sokete sırayla paket gönderir; alınan paketlerin
+// doğru sokete ulaştığı, süreç thread sayısı ve döngünün durma süresi ölçülür.
+
+#include "network/event_loop.hpp"
+#include "network/udp_receiver.hpp"
+#include "network/udp_sender.hpp"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+
+#define RESET   "\033[0m"
+#define RED     "\033[31m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define CYAN    "\033[36m"
+
+#ifndef VOICE_ENGINE_HAVE_EPOLL
+int main() {
+    std::cout << YELLOW << "epoll mevcut değil; event loop benchmark'ı atlandı" << RESET << std::endl;
+    return 0;
+}
+#else
+
+namespace {
+    constexpr size_t SOCKET_COUNT = 256;
+    constexpr size_t PACKETS_PER_SOCKET = 400;
+    constexpr size_t PAYLOAD_SIZE = 100;
+    constexpr size_t RECEIVER_BATCH = 8;   // Alıcı başına slot (havuzda tutulan buffer)
+    constexpr int BASE_PORT = 47900;
+
+    using Clock = std::chrono::steady_clock;
+
+    int thread_count() {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.rfind("Threads:", 0) == 0) {
+                return std::stoi(line.substr(8));
+            }
+        }
+        return -1;
+    }
+}
+
+int main() {
+    std::cout << CYAN << "🧪 Event Loop Benchmark'ı (" << SOCKET_COUNT << " soket, soket başına "
+              << PACKETS_PER_SOCKET << " paket)" << RESET << std::endl;
+
+    network::EventLoop loop;
+    core::BufferPool pool(SOCKET_COUNT * RECEIVER_BATCH * 2, core::MAX_DATAGRAM_SIZE);
+
+    std::vector<std::atomic<size_t>> received(SOCKET_COUNT);
+    std::atomic<size_t> misrouted{0};
+    std::vector<std::unique_ptr<network::UdpReceiver>> receivers;
+    for (size_t i = 0; i < SOCKET_COUNT; ++i) {
+        receivers.push_back(std::make_unique<network::UdpReceiver>(RECEIVER_BATCH, &pool, &loop));
+        const bool started = receivers.back()->start(BASE_PORT + static_cast<int>(i),
+            [&, i](const core::PooledPacket& packet) {
+                // Paket, gönderildiği soketin numarasını taşır
+                if (packet.view.sequence_number % SOCKET_COUNT != i) {
+                    misrouted.fetch_add(1, std::memory_order_relaxed);
+                }
+                received[i].fetch_add(1, std::memory_order_relaxed);
+            });
+        if (!started) {
+            std::cerr << RED << "HATA: " << (BASE_PORT + i) << " portu açılamadı" << RESET << std::endl;
+            return 1;
+        }
+    }
+    loop.start();
+    std::cout << "   Kayıtlı soket: " << loop.size() << ", süreç thread sayısı: " << thread_count() << std::endl;
+
+    std::vector<std::unique_ptr<network::UdpSender>> senders;
+    for (size_t i = 0; i < SOCKET_COUNT; ++i) {
+        senders.push_back(std::make_unique<network::UdpSender>());
+        senders.back()->connect("127.0.0.1", BASE_PORT + static_cast<int>(i));
+    }
+
+    std::vector<core::Packet> packets(network::UdpSender::DEFAULT_BATCH_SIZE);
+    for (auto& packet : packets) {
+        packet.data.resize(PAYLOAD_SIZE);
+    }
+
+    const auto start = Clock::now();
+    size_t sent = 0;
+    for (size_t round = 0; round < PACKETS_PER_SOCKET; round += packets.size()) {
+        for (size_t i = 0; i < SOCKET_COUNT; ++i) {
+            for (size_t p = 0; p < packets.size(); ++p) {
+                packets[p].sequence_number = static_cast<uint32_t>((round + p) * SOCKET_COUNT + i);
+            }
+            senders[i]->send(packets);
+            sent += packets.size();
+        }
+    }
+
+    // Döngü kuyrukları boşaltana kadar bekle
+    auto total = [&] {
+        size_t sum = 0;
+        for (const auto& count : received) {
+            sum += count.load();
+        }
+        return sum;
+    };
+    size_t previous = 0;
+    do {
+        previous = total();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    } while (total() != previous);
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count() - 0.05;
+
+    size_t silent_sockets = 0;
+    for (const auto& count : received) {
+        silent_sockets += count.load() == 0 ? 1 : 0;
+    }
+
+    const auto stop_start = Clock::now();
+    loop.stop();
+    const double stop_ms = std::chrono::duration<double, std::milli>(Clock::now() - stop_start).count();
+    // Alıcılar slot buffer'larını bıraktığında havuz tamamen geri dönmelidir
+    receivers.clear();
+
+    const size_t delivered = total();
+    const bool ok = delivered > 0 && silent_sockets == 0 && misrouted.load() == 0 && pool.stats().in_use == 0;
+
+    std::cout << "\n" << YELLOW << "📊 Sonuç" << RESET << std::endl;
+    std::cout << "   Alınan: " << delivered << "/" << sent << " (" << (100.0 * delivered / sent) << "%), "
+              << GREEN << static_cast<uint64_t>(delivered / seconds) << " paket/s" << RESET << std::endl;
+    std::cout << "   Paketsiz soket: " << silent_sockets << ", yanlış sokete giden: " << misrouted.load() << std::endl;
+    const auto stats = pool.stats();
+    std::cout << "   Havuz: tepe " << stats.peak_in_use << "/" << stats.capacity << ", boşalma "
+              << stats.exhausted << ", bırakılmamış " << stats.in_use << std::endl;
+    std::cout << "   Döngü durma süresi: " << stop_ms << " ms" << std::endl;
+    std::cout << "   " << (ok ? GREEN "OK" : RED "FAIL") << RESET << std::endl;
+    return ok ? 0 : 1;
+}
+
+#endif
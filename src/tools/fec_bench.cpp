@@ -0,0 +1,384 @@
+// src/tools/fec_bench.cpp - Paket FEC (XOR / Reed–Solomon) doğrulaması ve simülasyonu
+//
+// 1) Doğrulama: her (medya, parite) yapılandırması için Slicer'ın ürettiği gruplardan
+//    en çok parite sayısı kadar rastgele datagram (medya veya parite) düşürülür; eksik
+//    medya datagramlarının FecDecoder ile byte byte geri kurulması beklenir.
+// 2) Simülasyon: 10 ms'lik konuşma frame'leri patlamalı kayıplı (Gilbert–Elliott) bir
+//    ağdan geçirilir, alıcı uygulamadaki gibi Collector::recover() / insert_recovered()
+//    kullanır ve oynatma her 10 ms'de bir pop() ile yapılır. FEC kapalı, XOR ve
+//    Reed–Solomon için oynatmadaki kayıp ve bant genişliği yükü raporlanır; kurulan
+//    paketlerin oynatma noktasına yetişmesi (geç sayısı) da denetlenir.
+// 3) Hız: kodlama ve tek eksikli çözme süresi (seçilen SIMD seviyesiyle).
+// Sonuçlar eşiklerin dışındaysa sıfırdan farklı bir kodla çıkar.
+
+#include "streaming/collector.hpp"
+#include "streaming/fec.hpp"
+#include "streaming/slicer.hpp"
+#include "streaming/feedback.hpp"
+#include "dsp/kernels.hpp"
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+
+#define RESET   "\033[0m"
+#define RED     "\033[31m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define CYAN    "\033[36m"
+
+namespace {
+    constexpr int SAMPLE_RATE = 48000;
+    constexpr uint32_t FRAME_SAMPLES = 480;
+    constexpr int FRAME_MS = 10;
+    constexpr int DURATION_MS = 120000;
+    constexpr size_t MAX_SLICE_SIZE = 1200;
+    constexpr size_t MAX_PACKETS = core::MAX_FRAGMENTS + streaming::FecParityHeader::MAX_PARITY;
+
+    core::Packet copy(const core::PacketView& view) {
+        core::Packet packet;
+        packet.sequence_number = view.sequence_number;
+        packet.timestamp = view.timestamp;
+        packet.fragment_index = view.fragment_index;
+        packet.fragment_count = view.fragment_count;
+        packet.frame_size = view.frame_size;
+        packet.data.assign(view.data, view.data + view.size);
+        return packet;
+    }
+
+    bool same(const core::PacketView& a, const core::Packet& b) {
+        return a.sequence_number == b.sequence_number && a.timestamp == b.timestamp &&
+               a.fragment_index == b.fragment_index && a.fragment_count == b.fragment_count &&
+               a.frame_size == b.frame_size && a.size == b.data.size() &&
+               (a.size == 0 || std::memcmp(a.data, b.data.data(), a.size) == 0);
+    }
+
+    // Slicer'dan bir frame'in datagramlarını ve (grup kapandıysa) paritelerini alır
+    size_t send_frame(streaming::Slicer& slicer, const std::vector<uint8_t>& payload, uint32_t timestamp,
+                      std::vector<core::Packet>& out) {
+        core::PacketView views[MAX_PACKETS];
+        size_t count = slicer.slice(payload.data(), payload.size(), MAX_SLICE_SIZE, timestamp, views, core::MAX_FRAGMENTS);
+        count += slicer.parity(views + count, MAX_PACKETS - count);
+        for (size_t i = 0; i < count; ++i) {
+            out.push_back(copy(views[i]));
+        }
+        return count;
+    }
+
+    struct VerifyResult {
+        size_t groups = 0;
+        size_t dropped = 0;
+        size_t recovered = 0;
+        size_t mismatched = 0;
+    };
+
+    // Her grup için parite sayısı kadar datagram düşürülür; kalanlar karışık sırayla
+    // çözücüye verilir ve düşen medya datagramlarının tamamı geri kurulmalıdır
+    VerifyResult verify(size_t media_count, size_t parity_count, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<size_t> frame_size(1, 400);
+        std::uniform_int_distribution<int> byte(0, 255);
+        std::uniform_int_distribution<int> fragmented(0, 9);
+
+        streaming::Slicer slicer;
+        slicer.set_fec(media_count, parity_count);
+        streaming::FecDecoder decoder;
+        VerifyResult result;
+
+        std::vector<core::Packet> group;
+        uint32_t timestamp = 0;
+        while (result.groups < 200) {
+            // Ara sıra MTU'dan büyük frame: parçaları aynı gruba girer
+            std::vector<uint8_t> payload(fragmented(rng) == 0 ? 2 * MAX_SLICE_SIZE + frame_size(rng) : frame_size(rng));
+            for (auto& b : payload) {
+                b = static_cast<uint8_t>(byte(rng));
+            }
+            send_frame(slicer, payload, timestamp, group);
+            timestamp += FRAME_SAMPLES;
+            if (group.empty() || !group.back().view().control()) {
+                continue;
+            }
+
+            // Grup kapandı: parity_count datagram düşür, kalanı karıştırıp ver
+            std::vector<size_t> order(group.size());
+            for (size_t i = 0; i < order.size(); ++i) {
+                order[i] = i;
+            }
+            std::shuffle(order.begin(), order.end(), rng);
+            std::vector<bool> dropped(group.size(), false);
+            for (size_t i = 0; i < parity_count && i < order.size(); ++i) {
+                dropped[order[i]] = true;
+            }
+            std::shuffle(order.begin(), order.end(), rng);
+
+            // Parite, karışık sırada henüz verilmemiş üyeleri de erkenden kurabilir; kurulan her
+            // datagram gruptaki bir datagramla birebir eşleşmelidir
+            std::vector<bool> delivered(group.size(), false);
+            std::vector<bool> restored(group.size(), false);
+            core::PacketView recovered[streaming::FecParityHeader::MAX_PARITY];
+            for (size_t index : order) {
+                if (dropped[index]) {
+                    continue;
+                }
+                delivered[index] = true;
+                const core::PacketView view = group[index].view();
+                const size_t count = view.control() ? decoder.on_parity(view, recovered, parity_count)
+                                                    : decoder.on_media(view, recovered, parity_count);
+                for (size_t r = 0; r < count; ++r) {
+                    bool matched = false;
+                    for (size_t m = 0; m < group.size() && !matched; ++m) {
+                        if (!delivered[m] && !restored[m] && same(recovered[r], group[m])) {
+                            restored[m] = matched = true;
+                        }
+                    }
+                    result.mismatched += matched ? 0 : 1;
+                }
+            }
+            // Yalnızca grubun ilk MAX_MEDIA medya datagramı korunur (sığmayan parçalar korunmaz)
+            size_t media = 0;
+            for (size_t m = 0; m < group.size(); ++m) {
+                if (group[m].view().control() || media++ >= streaming::FecParityHeader::MAX_MEDIA) {
+                    continue;
+                }
+                result.dropped += dropped[m] ? 1 : 0;
+                result.recovered += (dropped[m] && restored[m]) ? 1 : 0;
+            }
+            group.clear();
+            ++result.groups;
+        }
+        return result;
+    }
+
+    struct Scenario {
+        const char* name;
+        size_t media_count;
+        size_t parity_count;     // 0: FEC kapalı
+        double max_loss_ratio;   // Oynatmadaki kaybın FEC kapalıdakine oranı için üst sınır
+    };
+
+    struct Result {
+        double network_loss_percent = 0.0;
+        double playout_loss_percent = 0.0;
+        double overhead_percent = 0.0;   // Parite byte'ları / medya byte'ları
+        size_t corrupted = 0;
+        streaming::JitterBufferStats stats;
+    };
+
+    // Gilbert–Elliott kanalı: iyi durumda %0.5, kötü durumda %50 kayıp; kötü durum
+    // ortalama 4 paket sürer (Wi-Fi patlamaları). Ortalama kayıp ~%3.
+    Result simulate(const Scenario& scenario, unsigned seed) {
+        constexpr double GOOD_TO_BAD = 0.015;
+        constexpr double BAD_TO_GOOD = 0.25;
+        constexpr double GOOD_LOSS = 0.005;
+        constexpr double BAD_LOSS = 0.5;
+        constexpr double BASE_DELAY_MS = 40.0;
+        constexpr double JITTER_MS = 5.0;
+        constexpr size_t FRAME_BYTES = 120;
+
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        std::normal_distribution<double> jitter(0.0, JITTER_MS);
+
+        struct Sent {
+            core::Packet packet;
+            double arrival_ms;
+        };
+        auto pattern = [](int send_ms, size_t index) { return static_cast<uint8_t>(send_ms / FRAME_MS + index * 7); };
+
+        streaming::Slicer slicer;
+        slicer.set_fec(scenario.media_count, scenario.parity_count);
+        std::vector<Sent> sent;
+        std::vector<core::Packet> packets;
+        bool bad = false;
+        size_t frames = 0;
+        size_t network_lost = 0;
+        size_t media_bytes = 0;
+        size_t parity_bytes = 0;
+        for (int t = 0; t < DURATION_MS; t += FRAME_MS) {
+            std::vector<uint8_t> frame(FRAME_BYTES);
+            for (int b = 0; b < 4; ++b) {
+                frame[b] = static_cast<uint8_t>(t >> (8 * b));
+            }
+            for (size_t b = 4; b < frame.size(); ++b) {
+                frame[b] = pattern(t, b);
+            }
+            packets.clear();
+            send_frame(slicer, frame, static_cast<uint32_t>(t / FRAME_MS) * FRAME_SAMPLES, packets);
+            ++frames;
+
+            // Bir frame'in datagramları ve pariteleri tek send() ile art arda gider: aynı gecikme
+            const double arrival_ms = t + BASE_DELAY_MS + std::fabs(jitter(rng));
+            for (const core::Packet& packet : packets) {
+                const bool parity = packet.view().control();
+                (parity ? parity_bytes : media_bytes) += core::PACKET_HEADER_SIZE + packet.data.size();
+                bad = bad ? uniform(rng) >= BAD_TO_GOOD : uniform(rng) < GOOD_TO_BAD;
+                if (uniform(rng) < (bad ? BAD_LOSS : GOOD_LOSS)) {
+                    network_lost += parity ? 0 : 1;
+                    continue;
+                }
+                sent.push_back({packet, arrival_ms});
+            }
+        }
+        std::stable_sort(sent.begin(), sent.end(), [](const Sent& a, const Sent& b) { return a.arrival_ms < b.arrival_ms; });
+
+        streaming::Collector collector(SAMPLE_RATE, FRAME_SAMPLES);
+        const auto epoch = streaming::Collector::Clock::now();
+        auto at = [&](double ms) {
+            return epoch + std::chrono::duration_cast<streaming::Collector::Clock::duration>(
+                std::chrono::duration<double, std::milli>(ms));
+        };
+
+        std::vector<uint8_t> out(streaming::Collector::MAX_FRAME_SIZE);
+        core::PacketView recovered[streaming::FecParityHeader::MAX_PARITY];
+        size_t next_arrival = 0;
+        size_t played = 0;
+        size_t corrupted = 0;
+        for (int t = 0; t < DURATION_MS + 1000; t += FRAME_MS) {
+            while (next_arrival < sent.size() && sent[next_arrival].arrival_ms <= t) {
+                const Sent& arrived = sent[next_arrival++];
+                const core::PacketView view = arrived.packet.view();
+                const auto arrival = at(arrived.arrival_ms);
+                // Uygulamadaki sıra: datagram önce FEC'e verilir, medyaysa ardından eklenir
+                const size_t count = collector.recover(view, recovered, streaming::FecParityHeader::MAX_PARITY);
+                if (!view.control()) {
+                    collector.insert(view, arrival);
+                }
+                for (size_t i = 0; i < count; ++i) {
+                    collector.insert_recovered(recovered[i], arrival);
+                }
+            }
+            size_t size = 0;
+            const auto status = collector.pop(out.data(), out.size(), size, at(t));
+            if (status == streaming::Collector::Playout::Frame && size > 0) {
+                ++played;
+                int send_ms = 0;
+                for (int b = 0; b < 4; ++b) {
+                    send_ms |= static_cast<int>(out[b]) << (8 * b);
+                }
+                bool intact = size == FRAME_BYTES;
+                for (size_t b = 4; intact && b < size; ++b) {
+                    intact = out[b] == pattern(send_ms, b);
+                }
+                corrupted += intact ? 0 : 1;
+            }
+        }
+
+        Result result;
+        result.stats = collector.stats();
+        result.corrupted = corrupted;
+        result.network_loss_percent = 100.0 * network_lost / frames;
+        result.playout_loss_percent = 100.0 * (frames - std::min(frames, played)) / frames;
+        result.overhead_percent = media_bytes > 0 ? 100.0 * parity_bytes / media_bytes : 0.0;
+        return result;
+    }
+
+    // Grup başına kodlama ve tek eksikli çözme süresi (mikrosaniye)
+    void measure(size_t media_count, size_t parity_count, size_t datagram_bytes, double& encode_us, double& decode_us) {
+        constexpr size_t GROUPS = 2000;
+        streaming::Slicer slicer;
+        slicer.set_fec(media_count, parity_count);
+        std::vector<uint8_t> payload(datagram_bytes - core::PACKET_HEADER_SIZE, 0x5A);
+
+        // Kodlama: kopyalama olmadan ölçülür
+        core::PacketView views[MAX_PACKETS];
+        size_t sent = 0;
+        const auto encode_start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < GROUPS * media_count; ++i) {
+            sent += slicer.slice(payload.data(), payload.size(), MAX_SLICE_SIZE, static_cast<uint32_t>(i) * FRAME_SAMPLES,
+                                 views, core::MAX_FRAGMENTS);
+            sent += slicer.parity(views, MAX_PACKETS);
+        }
+        const auto encode_end = std::chrono::steady_clock::now();
+        if (sent == 0) {
+            return;
+        }
+
+        // Çözme için gruplar ayrı bir Slicer'la yeniden üretilir ve saklanır
+        streaming::Slicer recorder;
+        recorder.set_fec(media_count, parity_count);
+        std::vector<std::vector<core::Packet>> groups(GROUPS);
+        for (size_t g = 0; g < GROUPS; ++g) {
+            for (size_t i = 0; i < media_count; ++i) {
+                send_frame(recorder, payload, static_cast<uint32_t>(g * media_count + i) * FRAME_SAMPLES, groups[g]);
+            }
+        }
+
+        streaming::FecDecoder decoder;
+        core::PacketView recovered[streaming::FecParityHeader::MAX_PARITY];
+        double decode_seconds = 0.0;
+        for (const auto& group : groups) {
+            // İlk medya datagramı kayıp: gelenler önce, parite en son çözmeyi tetikler
+            const auto start = std::chrono::steady_clock::now();
+            for (size_t i = 1; i < group.size(); ++i) {
+                const core::PacketView view = group[i].view();
+                if (view.control()) {
+                    decoder.on_parity(view, recovered, parity_count);
+                } else {
+                    decoder.on_media(view, recovered, parity_count);
+                }
+            }
+            decode_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        encode_us = std::chrono::duration<double, std::micro>(encode_end - encode_start).count() / GROUPS;
+        decode_us = decode_seconds * 1e6 / GROUPS;
+    }
+}
+
+int main() {
+    std::cout << CYAN << "🧪 Paket FEC (XOR / Reed–Solomon)" << RESET << std::endl;
+    std::cout << "SIMD: " << dsp::simd_level_name(dsp::simd_level()) << std::endl;
+
+    bool all_ok = true;
+
+    std::cout << "\n" << YELLOW << "📊 Doğrulama (grup başına parite sayısı kadar kayıp)" << RESET << std::endl;
+    const size_t configs[][2] = {{1, 1}, {5, 1}, {2, 2}, {5, 2}, {10, 3}, {8, 4}, {16, 4}};
+    for (const auto& config : configs) {
+        const VerifyResult r = verify(config[0], config[1], 7);
+        const bool ok = r.groups > 0 && r.recovered == r.dropped && r.mismatched == 0;
+        all_ok = all_ok && ok;
+        std::cout << "   " << config[0] << "+" << config[1] << ": " << r.groups << " grup, düşen medya "
+                  << r.dropped << ", geri kurulan " << r.recovered << ", hatalı " << r.mismatched << "  "
+                  << (ok ? GREEN "OK" : RED "FAIL") << RESET << std::endl;
+    }
+
+    const Scenario scenarios[] = {
+        {"FEC kapalı",        5, 0, 1.0},
+        {"XOR 5+1",           5, 1, 0.75},
+        {"Reed–Solomon 5+2",  5, 2, 0.5},
+        {"Reed–Solomon 10+3", 10, 3, 0.5},
+    };
+    double baseline_loss = 0.0;
+    for (const Scenario& scenario : scenarios) {
+        const Result r = simulate(scenario, 11);
+        if (scenario.parity_count == 0) {
+            baseline_loss = r.playout_loss_percent;
+        }
+        // Kapalı senaryo ilk sıradadır; FEC açıkken kayıp ona göre belirgin azalmalı
+        const bool ok = r.playout_loss_percent <= scenario.max_loss_ratio * baseline_loss && r.corrupted == 0 &&
+                        r.stats.late <= r.stats.fec_recovered / 20;
+        all_ok = all_ok && ok;
+
+        std::cout << "\n" << YELLOW << "📊 " << scenario.name << RESET << " (patlamalı kayıp, 40 ms gecikme)" << std::endl;
+        std::cout << "   Ağ kaybı: " << r.network_loss_percent << "%, oynatmada kayıp: " << r.playout_loss_percent
+                  << "%, parite yükü: " << r.overhead_percent << "%" << std::endl;
+        std::cout << "   parite/kurulan/kurulamayan: " << r.stats.fec_parity_received << "/" << r.stats.fec_recovered
+                  << "/" << r.stats.fec_unrecoverable << ", geç/kayıp: " << r.stats.late << "/" << r.stats.lost
+                  << ", hedef gecikme " << r.stats.target_delay_ms
+                  << " ms, bozuk: " << r.corrupted << "  " << (ok ? GREEN "OK" : RED "FAIL") << RESET << std::endl;
+    }
+
+    std::cout << "\n" << YELLOW << "📊 Hız (160 byte'lık datagramlar, grup başına)" << RESET << std::endl;
+    const size_t speeds[][2] = {{5, 1}, {5, 2}, {10, 3}, {16, 4}};
+    for (const auto& config : speeds) {
+        double encode_us = 0.0;
+        double decode_us = 0.0;
+        measure(config[0], config[1], 160, encode_us, decode_us);
+        std::cout << "   " << config[0] << "+" << config[1] << ": kodlama " << encode_us << " µs, çözme "
+                  << decode_us << " µs" << std::endl;
+    }
+    return all_ok ? 0 : 1;
+}
@@ -0,0 +1,114 @@
+// src/tools/fft_bench.cpp - RealFft ile eski O(N²) DFT'nin karşılaştırması
+//
+// NoiseSuppressor'ın eski compute_fft/compute_ifft uygulaması (her bin için cos/sin
+// çağıran naif DFT) ile dsp::RealFft'i 128-2048 frame boyutlarında ölçer ve
+// sonuçların eşleştiğini doğrular.
+
+#include "dsp/fft.hpp"
+#include <iostream>
+#include <vector>
+#include <complex>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <algorithm>
+#include <string>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define RESET   "\033[0m"
+#define RED     "\033[31m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define CYAN    "\033[36m"
+
+namespace {
+    // NoiseSuppressor'daki eski uygulamanın birebir kopyası
+    void naive_fft(const std::vector<float>& input, std::vector<std::complex<float>>& output, size_t n_size) {
+        for (size_t k = 0; k < n_size; ++k) {
+            std::complex<float> sum(0.0f, 0.0f);
+            for (size_t n = 0; n < n_size; ++n) {
+                float angle = -2.0f * M_PI * k * n / n_size;
+                sum += input[n] * std::complex<float>(std::cos(angle), std::sin(angle));
+            }
+            output[k] = sum;
+        }
+    }
+
+    void naive_ifft(const std::vector<std::complex<float>>& input, std::vector<float>& output, size_t n_size) {
+        for (size_t n = 0; n < n_size; ++n) {
+            std::complex<float> sum(0.0f, 0.0f);
+            for (size_t k = 0; k < n_size; ++k) {
+                float angle = 2.0f * M_PI * k * n / n_size;
+                sum += input[k] * std::complex<float>(std::cos(angle), std::sin(angle));
+            }
+            output[n] = sum.real() / n_size;
+        }
+    }
+
+    template <typename Fn>
+    double time_us(Fn&& fn, int iterations) {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            fn();
+        }
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+    }
+}
+
+int main() {
+    std::cout << CYAN << "🧪 FFT Benchmark (forward + inverse)" << RESET << std::endl;
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    bool all_ok = true;
+
+    for (size_t n = 128; n <= 2048; n *= 2) {
+        std::vector<float> input(n);
+        for (auto& v : input) { v = dist(rng); }
+
+        std::vector<std::complex<float>> naive_spectrum(n);
+        std::vector<float> naive_output(n);
+        std::vector<std::complex<float>> fast_spectrum(n / 2 + 1);
+        std::vector<float> fast_output(n);
+        dsp::RealFft fft(n);
+
+        // Doğruluk kontrolü
+        naive_fft(input, naive_spectrum, n);
+        fft.forward(input.data(), fast_spectrum.data());
+        fft.inverse(fast_spectrum.data(), fast_output.data());
+        float spectrum_error = 0.0f;
+        for (size_t k = 0; k <= n / 2; ++k) {
+            spectrum_error = std::max(spectrum_error, std::abs(naive_spectrum[k] - fast_spectrum[k]));
+        }
+        float roundtrip_error = 0.0f;
+        for (size_t i = 0; i < n; ++i) {
+            roundtrip_error = std::max(roundtrip_error, std::abs(input[i] - fast_output[i]));
+        }
+        const bool ok = spectrum_error < 1e-2f && roundtrip_error < 1e-4f;
+        all_ok = all_ok && ok;
+
+        // Hız ölçümü
+        const int naive_iterations = n <= 512 ? 20 : 3;
+        const double naive_us = time_us([&]() {
+            naive_fft(input, naive_spectrum, n);
+            naive_ifft(naive_spectrum, naive_output, n);
+        }, naive_iterations);
+        const double fast_us = time_us([&]() {
+            fft.forward(input.data(), fast_spectrum.data());
+            fft.inverse(fast_spectrum.data(), fast_output.data());
+        }, 20000);
+
+        std::cout << "   " << YELLOW << "N=" << n << RESET
+                  << "  naive DFT: " << naive_us << " µs"
+                  << ", RealFft: " << fast_us << " µs"
+                  << ", speedup: " << GREEN << (naive_us / fast_us) << "x" << RESET
+                  << "  (max err: " << spectrum_error << " / " << roundtrip_error << ") "
+                  << (ok ? GREEN "OK" : RED "FAIL") << RESET << std::endl;
+    }
+
+    return all_ok ? 0 : 1;
+}
@@ -0,0 +1,172 @@
+// src/tools/gso_bench.cpp - UDP GSO/GRO segmentasyon offload'unun CPU maliyeti
+//
+// Loopback üzerinde toplu gönderici PACKET_COUNT küçük (Opus boyunda) paket gönderir;
+// üç yapılandırma karşılaştırılır: normal sendmmsg/recvmmsg, gönderimde GSO ve
+// gönderimde GSO + alımda GRO. Gönderici thread'inin CPU süresi gönderilen paket başına,
+// alıcı thread'lerinin CPU süresi alınan paket başına raporlanır. Son yapılandırmada
+// boyları artan (her mesajı tek paketlik) batch'ler eşit boylu batch'lerle dönüşümlü
+// gönderilir; mesaj slotlarının tek paketten segmentli gönderime geçişi de denetlenir.
+
+#include "network/udp_sender.hpp"
+#include "network/udp_receiver.hpp"
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+
+#define RESET   "\033[0m"
+#define RED     "\033[31m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define CYAN    "\033[36m"
+
+#ifndef VOICE_ENGINE_HAVE_UDP_GSO
+int main() {
+    std::cout << YELLOW << "UDP GSO/GRO derlenmedi; segmentasyon benchmark'ı atlandı" << RESET << std::endl;
+    return 0;
+}
+#else
+
+namespace {
+    constexpr size_t PACKET_COUNT = 256000;
+    constexpr size_t PAYLOAD_SIZE = 80;
+    constexpr size_t SENDER_BATCH = network::UdpSender::MAX_SEGMENTS;
+    constexpr int BASE_PORT = 48200;
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Config {
+        const char* name;
+        bool gso;
+        bool gro;
+        bool mixed;   // Çift numaralı batch'lerde paket boyları artar
+    };
+
+    size_t payload_size(const Config& config, size_t sequence) {
+        const bool mixed_batch = config.mixed && (sequence / SENDER_BATCH) % 2 == 0;
+        return mixed_batch ? PAYLOAD_SIZE + sequence % SENDER_BATCH : PAYLOAD_SIZE;
+    }
+
+    struct Result {
+        bool gso = false;
+        bool gro = false;
+        size_t received = 0;
+        double packets_per_second = 0.0;
+        double sender_us_per_packet = 0.0;
+        double receiver_us_per_packet = 0.0;
+        size_t corrupted = 0;
+    };
+
+    double cpu_seconds(clockid_t clock) {
+        timespec time{};
+        clock_gettime(clock, &time);
+        return time.tv_sec + time.tv_nsec / 1e9;
+    }
+
+    Result measure(const Config& config, int port) {
+        Result result;
+        std::atomic<size_t> received{0};
+        std::atomic<size_t> corrupted{0};
+
+        network::UdpReceiver receiver;
+        network::UdpReceiver::SocketOptions receive_options;
+        receive_options.gro = config.gro;
+        const bool started = receiver.start(port, [&](const core::PooledPacket& packet) {
+            // Segmentler doğru ayrıldıysa her paket kendi boyunu ve sırasını taşır
+            if (packet.view.size != payload_size(config, packet.view.sequence_number) || packet.view.data[0] != static_cast<uint8_t>(packet.view.sequence_number)) {
+                corrupted.fetch_add(1, std::memory_order_relaxed);
+            }
+            received.fetch_add(1, std::memory_order_relaxed);
+        }, receive_options);
+        if (!started) {
+            return result;
+        }
+
+        network::UdpSender sender(SENDER_BATCH);
+        network::UdpSender::SocketOptions send_options;
+        send_options.gso = config.gso;
+        sender.connect("127.0.0.1", port, send_options);
+        result.gso = sender.gso();
+        result.gro = receiver.gro();
+
+        std::vector<core::Packet> packets(SENDER_BATCH);
+
+        const double process_start = cpu_seconds(CLOCK_PROCESS_CPUTIME_ID);
+        const double sender_start = cpu_seconds(CLOCK_THREAD_CPUTIME_ID);
+        const auto start = Clock::now();
+        for (size_t sent = 0; sent < PACKET_COUNT; sent += packets.size()) {
+            for (size_t i = 0; i < packets.size(); ++i) {
+                packets[i].sequence_number = static_cast<uint32_t>(sent + i);
+                packets[i].data.resize(payload_size(config, sent + i));
+                packets[i].data[0] = static_cast<uint8_t>(sent + i);
+            }
+            sender.send(packets);
+        }
+        const double sender_seconds = cpu_seconds(CLOCK_THREAD_CPUTIME_ID) - sender_start;
+
+        size_t previous = 0;
+        do {
+            previous = received.load();
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        } while (received.load() != previous);
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count() - 0.05;
+        const double receiver_seconds = cpu_seconds(CLOCK_PROCESS_CPUTIME_ID) - process_start - sender_seconds;
+        receiver.stop();
+
+        result.received = received.load();
+        result.corrupted = corrupted.load();
+        result.sender_us_per_packet = sender_seconds * 1e6 / PACKET_COUNT;
+        if (result.received > 0) {
+            result.packets_per_second = result.received / seconds;
+            result.receiver_us_per_packet = receiver_seconds * 1e6 / result.received;
+        }
+        return result;
+    }
+}
+
+int main() {
+    std::cout << CYAN << "🧪 UDP GSO/GRO Benchmark'ı (loopback, " << PACKET_COUNT << " paket, "
+              << PAYLOAD_SIZE << " byte payload, gönderim batch'i " << SENDER_BATCH << ")" << RESET << std::endl;
+
+    const Config configs[] = {
+        {"sendmmsg/recvmmsg", false, false, false},
+        {"GSO", true, false, false},
+        {"GSO + GRO", true, true, false},
+        {"GSO, karışık boylu batch'ler", true, false, true},
+    };
+
+    bool all_ok = true;
+    double baseline_sender = 0.0;
+    double baseline_receiver = 0.0;
+    int port = BASE_PORT;
+    for (const Config& config : configs) {
+        const Result result = measure(config, port++);
+        const bool ok = result.received > 0 && result.corrupted == 0;
+        all_ok = all_ok && ok;
+        if (!config.gso && !config.mixed) {
+            baseline_sender = result.sender_us_per_packet;
+            baseline_receiver = result.receiver_us_per_packet;
+        }
+
+        std::cout << "\n" << YELLOW << "📊 " << config.name << RESET << " (GSO: " << (result.gso ? "açık" : "kapalı")
+                  << ", GRO: " << (result.gro ? "açık" : "kapalı") << ")" << std::endl;
+        std::cout << "   Alım:      " << GREEN << static_cast<uint64_t>(result.packets_per_second) << " paket/s" << RESET
+                  << ", alınan " << result.received << "/" << PACKET_COUNT << std::endl;
+        std::cout << "   Gönderici: " << result.sender_us_per_packet << " µs/paket";
+        if (baseline_sender > 0.0) {
+            std::cout << " (" << (result.sender_us_per_packet / baseline_sender) << "x)";
+        }
+        std::cout << std::endl;
+        std::cout << "   Alıcı:     " << result.receiver_us_per_packet << " µs/paket";
+        if (baseline_receiver > 0.0) {
+            std::cout << " (" << (result.receiver_us_per_packet / baseline_receiver) << "x)";
+        }
+        std::cout << ", bozuk " << result.corrupted << "  " << (ok ? GREEN "OK" : RED "FAIL") << RESET << std::endl;
+    }
+    return all_ok ? 0 : 1;
+}
+
+#endif
@@ -0,0 +1,451 @@
+// src/tools/impairment_proxy.cpp - Darboğaz bağlantısını taklit eden yerel UDP proxy'si
+//
+// Kullanım:
+//   impairment_proxy <dinleme portu> <hedef ip> <hedef port> [kapasite kbps] [kuyruk ms] [gecikme ms] [kayıp %]
+//     Dinleme portuna gelen datagramları sabit kapasiteli, drop-tail kuyruklu bir
+//     bağlantıdan geçirip hedefe iletir; iki voice_engine arasında bir yöne konur.
+//     Enter ile durur.
+//   impairment_proxy
+//     Kendi kendini sınar: loopback'te gönderici -> proxy -> alıcı kurulur, alıcı geliş
+//     zamanlarını göndericiye geri bildirir. Kapasite 200 -> 64 -> 200 kbps değişirken
+//     tıkanıklık kontrolsüz (sabit 64 kbps payload) ve gecikme tabanlı kontrollü gönderim
+//     karşılaştırılır: kısıtlı fazda kuyruk gecikmesi ve kayıp, kapasite geri gelince
+//     hedefin toparlanması raporlanır. Sonuçlar eşiklerin dışındaysa sıfırdan farklı
+//     bir kodla çıkar.
+
+#include "network/udp_sender.hpp"
+#include "network/udp_receiver.hpp"
+#include "streaming/feedback.hpp"
+#include "core/spsc_ring_buffer.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <array>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+#define RESET   "\033[0m"
+#define RED     "\033[31m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define CYAN    "\033[36m"
+
+#ifndef __linux__
+int main() {
+    std::cout << YELLOW << "impairment_proxy sadece Linux'ta derlenir" << RESET << std::endl;
+    return 0;
+}
+#else
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr size_t IP_UDP_HEADER_BYTES = network::DelayBasedController::IP_UDP_HEADER_BYTES;
+
+    // Kapasitesi çalışırken değiştirilebilen tek yönlü bağlantı: kuyruk, kapasite kadar
+    // hızla boşalır; kuyrukta queue_limit'ten uzun bekleyecek datagram atılır. Ardından
+    // sabit yayılım gecikmesi ve rastgele kayıp uygulanır.
+    class ImpairedLink {
+    public:
+        struct Stats {
+            uint64_t received = 0;
+            uint64_t dropped = 0;          // Kuyruk taşması
+            uint64_t lost = 0;             // Rastgele kayıp
+            uint64_t forwarded_bytes = 0;  // IP/UDP başlıkları dahil
+            double queue_delay_ms = 0.0;   // İletilen datagramların kuyruk gecikmesi toplamı
+        };
+
+        ImpairedLink(double capacity_kbps, double queue_limit_ms, double delay_ms, double loss_percent)
+            : capacity_kbps_(capacity_kbps),
+              queue_limit_(std::chrono::microseconds(static_cast<int64_t>(queue_limit_ms * 1000.0))),
+              delay_(std::chrono::microseconds(static_cast<int64_t>(delay_ms * 1000.0))),
+              loss_percent_(loss_percent) {}
+
+        ~ImpairedLink() { stop(); }
+
+        bool start(int listen_port, const std::string& target_ip, int target_port) {
+            socket_ = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+            if (socket_ < 0) {
+                std::perror("socket");
+                return false;
+            }
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_port = htons(static_cast<uint16_t>(listen_port));
+            address.sin_addr.s_addr = htonl(INADDR_ANY);
+            target_.sin_family = AF_INET;
+            target_.sin_port = htons(static_cast<uint16_t>(target_port));
+            if (bind(socket_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0 ||
+                inet_pton(AF_INET, target_ip.c_str(), &target_.sin_addr) <= 0) {
+                std::perror("bind/inet_pton");
+                close(socket_);
+                socket_ = -1;
+                return false;
+            }
+            running_ = true;
+            thread_ = std::thread(&ImpairedLink::run, this);
+            return true;
+        }
+
+        void stop() {
+            running_ = false;
+            if (thread_.joinable()) {
+                thread_.join();
+            }
+            if (socket_ >= 0) {
+                close(socket_);
+                socket_ = -1;
+            }
+        }
+
+        void set_capacity_kbps(double capacity_kbps) { capacity_kbps_.store(capacity_kbps); }
+
+        Stats stats() const {
+            Stats stats;
+            stats.received = received_.load();
+            stats.dropped = dropped_.load();
+            stats.lost = lost_.load();
+            stats.forwarded_bytes = forwarded_bytes_.load();
+            stats.queue_delay_ms = queue_delay_us_.load() / 1000.0;
+            return stats;
+        }
+
+    private:
+        struct Datagram {
+            std::array<uint8_t, core::MAX_DATAGRAM_SIZE> data;
+            size_t size;
+            Clock::time_point departure;
+        };
+
+        void run() {
+            std::mt19937 random(1234);
+            std::uniform_real_distribution<double> uniform(0.0, 100.0);
+            std::deque<Datagram> in_flight;
+            Datagram incoming;
+            Clock::time_point link_free = Clock::now();
+
+            while (running_) {
+                // Bir sonraki çıkışa kadar (en fazla 1 ms) yeni datagram beklenir
+                auto now = Clock::now();
+                timespec timeout{0, 1000000};
+                if (!in_flight.empty()) {
+                    const auto wait = std::max(Clock::duration::zero(), in_flight.front().departure - now);
+                    timeout.tv_nsec = std::min<long>(1000000, std::chrono::duration_cast<std::chrono::nanoseconds>(wait).count());
+                }
+                pollfd descriptor{socket_, POLLIN, 0};
+                if (ppoll(&descriptor, 1, &timeout, nullptr) > 0) {
+                    const ssize_t size = recv(socket_, incoming.data.data(), incoming.data.size(), 0);
+                    now = Clock::now();
+                    if (size > 0) {
+                        received_.fetch_add(1);
+                        incoming.size = static_cast<size_t>(size);
+                        const auto start = std::max(link_free, now);
+                        if (start - now > queue_limit_) {
+                            dropped_.fetch_add(1);
+                        } else {
+                            const double wire_bits = (incoming.size + IP_UDP_HEADER_BYTES) * 8.0;
+                            link_free = start + std::chrono::microseconds(
+                                static_cast<int64_t>(wire_bits * 1000.0 / capacity_kbps_.load()));
+                            if (uniform(random) < loss_percent_) {
+                                lost_.fetch_add(1);
+                            } else {
+                                incoming.departure = link_free + delay_;
+                                in_flight.push_back(incoming);
+                                forwarded_bytes_.fetch_add(incoming.size + IP_UDP_HEADER_BYTES);
+                                queue_delay_us_.fetch_add(static_cast<uint64_t>(
+                                    std::chrono::duration_cast<std::chrono::microseconds>(link_free - now).count()));
+                            }
+                        }
+                    }
+                }
+
+                now = Clock::now();
+                while (!in_flight.empty() && in_flight.front().departure <= now) {
+                    const Datagram& datagram = in_flight.front();
+                    sendto(socket_, datagram.data.data(), datagram.size, 0,
+                           reinterpret_cast<const sockaddr*>(&target_), sizeof(target_));
+                    in_flight.pop_front();
+                }
+            }
+        }
+
+        std::atomic<double> capacity_kbps_;
+        const Clock::duration queue_limit_;
+        const Clock::duration delay_;
+        const double loss_percent_;
+        int socket_ = -1;
+        sockaddr_in target_{};
+        std::thread thread_;
+        std::atomic<bool> running_{false};
+
+        std::atomic<uint64_t> received_{0};
+        std::atomic<uint64_t> dropped_{0};
+        std::atomic<uint64_t> lost_{0};
+        std::atomic<uint64_t> forwarded_bytes_{0};
+        std::atomic<uint64_t> queue_delay_us_{0};
+    };
+
+    // Kendi kendini sınama
+    constexpr int PROXY_PORT = 48400;
+    constexpr int FRAME_MS = 10;
+    constexpr int FEEDBACK_MS = 50;
+    constexpr int MAX_PAYLOAD_BPS = 64000;
+    constexpr int MIN_PAYLOAD_BPS = 6000;
+    constexpr double QUEUE_LIMIT_MS = 200.0;   // Derin (bufferbloat'lı) kuyruk
+    constexpr double PROPAGATION_MS = 20.0;
+
+    struct Phase {
+        int start_ms;
+        double capacity_kbps;  // Başlıklar dahil
+    };
+
+    const Phase PHASES[] = {
+        {0,     200.0},
+        {6000,   64.0},   // 10 ms'lik paketlerde payload için ~32 kbps kalır
+        {18000, 200.0},
+    };
+    constexpr size_t PHASE_COUNT = sizeof(PHASES) / sizeof(PHASES[0]);
+    constexpr int DURATION_MS = 28000;
+
+    struct PhaseResult {
+        ImpairedLink::Stats link;
+        double payload_kbps = 0.0;
+        double average_target_kbps = 0.0;
+        double max_pacer_delay_ms = 0.0;
+    };
+
+    struct Result {
+        PhaseResult phases[PHASE_COUNT];
+        double recovery_ms = -1.0;  // Son fazda hedefin başlangıç hızına dönmesi
+        uint64_t pacer_dropped = 0;
+    };
+
+    int64_t to_us(Clock::time_point time) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+    }
+
+    Result run_scenario(bool congestion_control, int port) {
+        Result result;
+        ImpairedLink link(PHASES[0].capacity_kbps, QUEUE_LIMIT_MS, PROPAGATION_MS, 0.0);
+        if (!link.start(port, "127.0.0.1", port + 1)) {
+            return result;
+        }
+
+        // Alıcı geliş zamanlarını kuyruğa atar; gönderen thread onları toplayıp geri bildirir
+        core::SpscRingBuffer<streaming::ArrivalFeedback::Entry> arrivals(1024);
+        network::UdpReceiver receiver;
+        const bool started = receiver.start(port + 1, [&](const core::PooledPacket& packet) {
+            const streaming::ArrivalFeedback::Entry arrival{packet.view.sequence_number, to_us(packet.arrival)};
+            arrivals.push(&arrival, 1);
+        });
+        if (!started) {
+            return result;
+        }
+
+        network::UdpSender::CongestionOptions congestion;
+        congestion.enabled = congestion_control;
+        network::UdpSender sender(network::UdpSender::DEFAULT_BATCH_SIZE, network::IoBackend::Socket, congestion);
+        sender.connect("127.0.0.1", port);
+        const int start_target = congestion.rate.start_bitrate_bps;
+        const int overhead_bps = static_cast<int>((IP_UDP_HEADER_BYTES + core::PACKET_HEADER_SIZE) * 8 * 1000 / FRAME_MS);
+
+        std::vector<uint8_t> payload(MAX_PAYLOAD_BPS * FRAME_MS / 8000);
+        std::array<uint8_t, streaming::ArrivalFeedback::MAX_WIRE_SIZE> wire;
+        streaming::ArrivalFeedback feedback;
+        streaming::ArrivalFeedback parsed;
+        network::PacketArrival reported[streaming::ArrivalFeedback::MAX_PACKETS];
+        auto report = [&]() {
+            if (feedback.count == 0) {
+                return;
+            }
+            // Kablo formatından geçirilir (250 µs'lik çözünürlük dahil)
+            const size_t size = feedback.write(wire.data(), wire.size());
+            if (streaming::ArrivalFeedback::parse(wire.data(), size, parsed)) {
+                for (size_t i = 0; i < parsed.count; ++i) {
+                    reported[i] = {parsed.packets[i].sequence_number, parsed.packets[i].arrival_us};
+                }
+                sender.on_transport_feedback(reported, parsed.count);
+            }
+            feedback.clear();
+        };
+
+        const auto epoch = Clock::now();
+        ImpairedLink::Stats phase_start_stats;
+        double phase_payload_bits = 0.0;
+        double phase_target_sum = 0.0;
+        size_t phase_frames = 0;
+        size_t phase = 0;
+        auto finish_phase = [&](int end_ms) {
+            const ImpairedLink::Stats stats = link.stats();
+            PhaseResult& finished = result.phases[phase];
+            finished.link.received = stats.received - phase_start_stats.received;
+            finished.link.dropped = stats.dropped - phase_start_stats.dropped;
+            finished.link.lost = stats.lost - phase_start_stats.lost;
+            finished.link.forwarded_bytes = stats.forwarded_bytes - phase_start_stats.forwarded_bytes;
+            finished.link.queue_delay_ms = stats.queue_delay_ms - phase_start_stats.queue_delay_ms;
+            finished.payload_kbps = phase_payload_bits / (end_ms - PHASES[phase].start_ms);
+            finished.average_target_kbps = phase_frames > 0 ? phase_target_sum / phase_frames / 1000.0 : 0.0;
+            phase_start_stats = stats;
+            phase_payload_bits = 0.0;
+            phase_target_sum = 0.0;
+            phase_frames = 0;
+        };
+
+        uint32_t sequence = 0;
+        for (int t = 0; t < DURATION_MS; t += FRAME_MS) {
+            std::this_thread::sleep_until(epoch + std::chrono::milliseconds(t));
+
+            if (phase + 1 < PHASE_COUNT && t >= PHASES[phase + 1].start_ms) {
+                finish_phase(t);
+                ++phase;
+                link.set_capacity_kbps(PHASES[phase].capacity_kbps);
+            }
+
+            // Kodlayıcı: kontrol açıksa payload hızı, hedeften başlıklar düşülerek bulunur
+            const int target = congestion_control ? sender.target_bitrate_bps() : start_target;
+            const int payload_bps = congestion_control
+                ? std::clamp(target - overhead_bps, MIN_PAYLOAD_BPS, MAX_PAYLOAD_BPS) : MAX_PAYLOAD_BPS;
+            core::PacketView packet;
+            packet.sequence_number = sequence++;
+            packet.timestamp = static_cast<uint32_t>(t * 48);
+            packet.data = payload.data();
+            packet.size = static_cast<size_t>(payload_bps) * FRAME_MS / 8000;
+            sender.send(packet);
+
+            PhaseResult& stats = result.phases[phase];
+            phase_payload_bits += packet.size * 8.0;
+            phase_target_sum += target;
+            ++phase_frames;
+            stats.max_pacer_delay_ms = std::max(stats.max_pacer_delay_ms, sender.pacer_queue_delay_ms());
+            if (phase == PHASE_COUNT - 1 && result.recovery_ms < 0.0 && target >= start_target) {
+                result.recovery_ms = t - PHASES[phase].start_ms;
+            }
+
+            // Alıcının geri bildirimi (ters yol tıkanmasız)
+            streaming::ArrivalFeedback::Entry arrival;
+            while (arrivals.pop(&arrival, 1) == 1) {
+                if (!feedback.add(arrival.sequence_number, arrival.arrival_us)) {
+                    report();
+                    feedback.add(arrival.sequence_number, arrival.arrival_us);
+                }
+            }
+            if (t % FEEDBACK_MS == 0) {
+                report();
+            }
+        }
+
+        finish_phase(DURATION_MS);
+        result.pacer_dropped = sender.pacer_dropped();
+        receiver.stop();
+        link.stop();
+        return result;
+    }
+
+    double loss_percent(const ImpairedLink::Stats& stats) {
+        return stats.received > 0 ? 100.0 * stats.dropped / stats.received : 0.0;
+    }
+
+    double average_queue_delay_ms(const ImpairedLink::Stats& stats) {
+        const uint64_t forwarded = stats.received - stats.dropped - stats.lost;
+        return forwarded > 0 ? stats.queue_delay_ms / forwarded : 0.0;
+    }
+
+    void print(const char* name, const Result& result) {
+        std::cout << "\n" << YELLOW << "📊 " << name << RESET << std::endl;
+        for (size_t i = 0; i < PHASE_COUNT; ++i) {
+            const PhaseResult& phase = result.phases[i];
+            const int end_ms = i + 1 < PHASE_COUNT ? PHASES[i + 1].start_ms : DURATION_MS;
+            std::cout << "   " << PHASES[i].start_ms / 1000 << "-" << end_ms / 1000 << " s, kapasite "
+                      << PHASES[i].capacity_kbps << " kbps: payload " << phase.payload_kbps << " kbps, hedef ort "
+                      << phase.average_target_kbps << " kbps, kayıp %" << loss_percent(phase.link)
+                      << ", darboğaz kuyruğu ort " << average_queue_delay_ms(phase.link) << " ms, pacer maks "
+                      << phase.max_pacer_delay_ms << " ms" << std::endl;
+        }
+    }
+
+    int self_test() {
+        std::cout << CYAN << "🧪 Tıkanıklık Kontrolü / Pacer Sınaması (loopback proxy, kuyruk " << QUEUE_LIMIT_MS
+                  << " ms, yayılım " << PROPAGATION_MS << " ms, geri bildirim " << FEEDBACK_MS << " ms)"
+                  << RESET << std::endl;
+
+        const Result fixed = run_scenario(false, PROXY_PORT);
+        const Result controlled = run_scenario(true, PROXY_PORT + 2);
+        print("Kontrolsüz (sabit 64 kbps payload)", fixed);
+        print("Gecikme tabanlı kontrol + pacer", controlled);
+
+        const ImpairedLink::Stats& fixed_link = fixed.phases[1].link;
+        const ImpairedLink::Stats& controlled_link = controlled.phases[1].link;
+        const bool delay_ok = average_queue_delay_ms(controlled_link) < 50.0 &&
+                              average_queue_delay_ms(controlled_link) < average_queue_delay_ms(fixed_link) / 3.0;
+        const bool loss_ok = loss_percent(controlled_link) < 2.0;
+        const bool recovery_ok = controlled.recovery_ms >= 0.0 && controlled.recovery_ms <= 8000.0;
+        const bool pacer_ok = controlled.pacer_dropped == 0;
+
+        std::cout << "\n" << YELLOW << "📊 Sonuç" << RESET << std::endl;
+        std::cout << "   Kısıtlı fazda darboğaz kuyruğu: kontrolsüz " << average_queue_delay_ms(fixed_link)
+                  << " ms, kontrollü " << average_queue_delay_ms(controlled_link) << " ms  "
+                  << (delay_ok ? GREEN "OK" : RED "FAIL") << RESET << std::endl;
+        std::cout << "   Kısıtlı fazda kayıp: kontrolsüz %" << loss_percent(fixed_link) << ", kontrollü %"
+                  << loss_percent(controlled_link) << "  " << (loss_ok ? GREEN "OK" : RED "FAIL") << RESET << std::endl;
+        std::cout << "   Kapasite geri gelince hedefin başlangıca dönüşü: " << controlled.recovery_ms / 1000.0 << " s  "
+                  << (recovery_ok ? GREEN "OK" : RED "FAIL") << RESET << std::endl;
+        std::cout << "   Pacer kuyruğunda atılan: " << controlled.pacer_dropped << "  "
+                  << (pacer_ok ? GREEN "OK" : RED "FAIL") << RESET << std::endl;
+        return delay_ok && loss_ok && recovery_ok && pacer_ok ? 0 : 1;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc == 1) {
+        return self_test();
+    }
+    if (argc < 4) {
+        std::cerr << "Kullanım: " << argv[0]
+                  << " <dinleme portu> <hedef ip> <hedef port> [kapasite kbps] [kuyruk ms] [gecikme ms] [kayıp %]"
+                  << std::endl;
+        return 1;
+    }
+
+    const int listen_port = std::atoi(argv[1]);
+    const std::string target_ip = argv[2];
+    const int target_port = std::atoi(argv[3]);
+    const double capacity_kbps = argc > 4 ? std::atof(argv[4]) : 64.0;
+    const double queue_ms = argc > 5 ? std::atof(argv[5]) : 200.0;
+    const double delay_ms = argc > 6 ? std::atof(argv[6]) : 20.0;
+    const double loss = argc > 7 ? std::atof(argv[7]) : 0.0;
+    if (capacity_kbps <= 0.0) {
+        std::cerr << "HATA: Kapasite pozitif olmalı" << std::endl;
+        return 1;
+    }
+
+    ImpairedLink link(capacity_kbps, queue_ms, delay_ms, loss);
+    if (!link.start(listen_port, target_ip, target_port)) {
+        return 1;
+    }
+    std::cout << CYAN << "🔀 " << listen_port << " -> " << target_ip << ":" << target_port << ", kapasite "
+              << capacity_kbps << " kbps, kuyruk " << queue_ms << " ms, gecikme " << delay_ms << " ms, kayıp %"
+              << loss << RESET << std::endl;
+    std::cout << ">>> Durdurmak için Enter'a basın <<<" << std::endl;
+
+    std::string line;
+    std::getline(std::cin, line);
+    link.stop();
+    const ImpairedLink::Stats stats = link.stats();
+    std::cout << "📊 Alınan " << stats.received << ", kuyruk taşması " << stats.dropped << ", rastgele kayıp "
+              << stats.lost << ", darboğaz kuyruğu ort " << average_queue_delay_ms(stats) << " ms" << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,178 @@
+// src/tools/io_backend_bench.cpp - Soket ve io_uring ağ arka uçlarının karşılaştırması
+//
+// Loopback üzerinde her arka uç için:
+//  - Verim: toplu gönderici PACKET_COUNT paket gönderir; alım hızı (ilk/son paket arası),
+//    kayıp ve paket başına süreç CPU süresi (sistem çağrısı giriş/çıkışı dahil) ölçülür.
+//  - Gecikme: LATENCY_PACKETS paket tek tek, aralıklı gönderilir; payload'daki gönderim
+//    zamanından alıcı callback'ine kadar geçen tek yön süre ölçülür (p50 / p99).
+// io_uring derlenmediyse veya çekirdek izin vermiyorsa sadece soket yolu ölçülür.
+
+#include "network/udp_sender.hpp"
+#include "network/udp_receiver.hpp"
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <cstring>
+#include <cstdint>
+#include <ctime>
+
+#define RESET   "\033[0m"
+#define RED     "\033[31m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define CYAN    "\033[36m"
+
+namespace {
+    constexpr size_t PACKET_COUNT = 200000;
+    constexpr size_t LATENCY_PACKETS = 2000;
+    constexpr size_t PAYLOAD_SIZE = 100;
+    constexpr auto LATENCY_INTERVAL = std::chrono::microseconds(200);
+    constexpr int PORT = 47813;
+
+    using Clock = std::chrono::steady_clock;
+
+    int64_t now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+    struct Result {
+        size_t received = 0;
+        double packets_per_second = 0.0;
+        double cpu_us_per_packet = 0.0;
+        double latency_p50_us = 0.0;
+        double latency_p99_us = 0.0;
+        network::IoBackend sender_backend = network::IoBackend::Socket;
+        network::IoBackend receiver_backend = network::IoBackend::Socket;
+    };
+
+    void wait_until_idle(const std::atomic<size_t>& received) {
+        size_t previous = 0;
+        do {
+            previous = received.load();
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        } while (received.load() != previous);
+    }
+
+    Result measure(network::IoBackend backend) {
+        Result result;
+        std::atomic<size_t> received{0};
+        std::atomic<int64_t> first_ns{0};
+        std::atomic<int64_t> last_ns{0};
+        std::atomic<bool> measure_latency{false};
+        std::mutex latency_mutex;
+        std::vector<double> latencies_us;
+        latencies_us.reserve(LATENCY_PACKETS);
+
+        network::UdpReceiver receiver(network::UdpReceiver::DEFAULT_BATCH_SIZE, nullptr, nullptr, backend);
+        const bool started = receiver.start(PORT, [&](const core::PooledPacket& packet) {
+            const int64_t now = now_ns();
+            if (measure_latency.load(std::memory_order_relaxed) && packet.view.size >= sizeof(int64_t)) {
+                int64_t sent_ns = 0;
+                std::memcpy(&sent_ns, packet.view.data, sizeof(sent_ns));
+                std::lock_guard<std::mutex> lock(latency_mutex);
+                latencies_us.push_back((now - sent_ns) / 1000.0);
+            }
+            if (received.fetch_add(1, std::memory_order_relaxed) == 0) {
+                first_ns.store(now, std::memory_order_relaxed);
+            }
+            last_ns.store(now, std::memory_order_relaxed);
+        });
+        if (!started) {
+            return result;
+        }
+
+        network::UdpSender sender(network::UdpSender::DEFAULT_BATCH_SIZE, backend);
+        sender.connect("127.0.0.1", PORT);
+        result.sender_backend = sender.backend();
+        result.receiver_backend = receiver.backend();
+
+        // Verim
+        std::vector<core::Packet> packets(network::UdpSender::DEFAULT_BATCH_SIZE);
+        for (size_t i = 0; i < packets.size(); ++i) {
+            packets[i].sequence_number = static_cast<uint32_t>(i);
+            packets[i].data.resize(PAYLOAD_SIZE);
+        }
+        const std::clock_t cpu_start = std::clock();
+        for (size_t sent = 0; sent < PACKET_COUNT; sent += packets.size()) {
+            sender.send(packets);
+        }
+        wait_until_idle(received);
+        const double cpu_seconds = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+        result.received = received.load();
+        const double seconds = (last_ns.load() - first_ns.load()) / 1e9;
+        if (result.received > 1 && seconds > 0.0) {
+            result.packets_per_second = (result.received - 1) / seconds;
+            // Gönderici + alıcı CPU'su, alınan paket başına
+            result.cpu_us_per_packet = cpu_seconds * 1e6 / result.received;
+        }
+
+        // Gecikme (boş kuyrukta, tek tek paketler)
+        measure_latency = true;
+        core::Packet probe;
+        probe.data.resize(PAYLOAD_SIZE);
+        for (size_t i = 0; i < LATENCY_PACKETS; ++i) {
+            const int64_t sent_ns = now_ns();
+            std::memcpy(probe.data.data(), &sent_ns, sizeof(sent_ns));
+            sender.send(probe);
+            std::this_thread::sleep_for(LATENCY_INTERVAL);
+        }
+        wait_until_idle(received);
+        receiver.stop();
+
+        if (!latencies_us.empty()) {
+            std::sort(latencies_us.begin(), latencies_us.end());
+            result.latency_p50_us = latencies_us[latencies_us.size() / 2];
+            result.latency_p99_us = latencies_us[latencies_us.size() * 99 / 100];
+        }
+        return result;
+    }
+}
+
+int main() {
+    std::cout << CYAN << "🧪 Ağ Arka Ucu Benchmark'ı (loopback, " << PACKET_COUNT << " paket, "
+              << PAYLOAD_SIZE << " byte payload)" << RESET << std::endl;
+
+    std::vector<network::IoBackend> backends{network::IoBackend::Socket};
+    if (network::io_uring_available()) {
+        backends.push_back(network::IoBackend::IoUring);
+    } else {
+        std::cout << YELLOW << "   io_uring mevcut değil (derlenmedi veya çekirdek izin vermiyor); "
+                  << "sadece soket yolu ölçülüyor" << RESET << std::endl;
+    }
+
+    bool all_ok = true;
+    double baseline_pps = 0.0;
+    double baseline_cpu = 0.0;
+    for (network::IoBackend backend : backends) {
+        const Result result = measure(backend);
+        const bool ok = result.received > 0 && result.receiver_backend == backend && result.sender_backend == backend;
+        all_ok = all_ok && ok;
+        if (backend == network::IoBackend::Socket) {
+            baseline_pps = result.packets_per_second;
+            baseline_cpu = result.cpu_us_per_packet;
+        }
+
+        std::cout << "\n" << YELLOW << "📊 " << network::to_string(backend) << RESET
+                  << " (gönderici: " << network::to_string(result.sender_backend)
+                  << ", alıcı: " << network::to_string(result.receiver_backend) << ")" << std::endl;
+        std::cout << "   Alım:    " << GREEN << static_cast<uint64_t>(result.packets_per_second) << " paket/s" << RESET;
+        if (baseline_pps > 0.0) {
+            std::cout << " (" << (result.packets_per_second / baseline_pps) << "x)";
+        }
+        std::cout << ", alınan " << result.received << "/" << PACKET_COUNT
+                  << std::endl;
+        std::cout << "   CPU:     " << result.cpu_us_per_packet << " µs/paket";
+        if (baseline_cpu > 0.0) {
+            std::cout << " (" << (result.cpu_us_per_packet / baseline_cpu) << "x)";
+        }
+        std::cout << std::endl;
+        std::cout << "   Gecikme: p50 " << result.latency_p50_us << " µs, p99 " << result.latency_p99_us << " µs"
+                  << "  " << (ok ? GREEN "OK" : RED "FAIL") << RESET << std::endl;
+    }
+    return all_ok ? 0 : 1;
+}
@@ -0,0 +1,259 @@
+// src/tools/jitter_buffer_bench.cpp - Collector jitter buffer simülasyonu
+//
+// 10 ms'lik frame'ler (konuşma sırasında her frame, sessizlikte 200 ms'de bir
+// comfort noise) gecikme, jitter, kayıp ve tekrar içeren sanal bir ağdan geçirilir.
+// Oynatma her 10 ms'de bir pop() ile yapılır. Her senaryo için ağızdan kulağa
+// gecikme (gönderim -> oynatma), geç / kayıp oranları ve hedef gecikme raporlanır.
+// Frame'ler Slicer ile bölünür; MTU'dan büyük frame'lerin parçaları ağda ayrı ayrı
+// gecikir, kaybolur veya tekrarlanır ve oynatılan her frame byte byte doğrulanır.
+// Paket başına birden fazla frame gönderilen senaryolarda alıcı, uygulamadaki gibi
+// paketi frame'lerine bölerek ekler (sıra numarası frame başına artar, geliş zamanı son
+// frame'e hizalanır).
+// Sonuçlar eşiklerin dışındaysa sıfırdan farklı bir kodla çıkar.
+
+#include "streaming/collector.hpp"
+#include "streaming/slicer.hpp"
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cmath>
+
+#define RESET   "\033[0m"
+#define RED     "\033[31m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define CYAN    "\033[36m"
+
+namespace {
+    constexpr int SAMPLE_RATE = 48000;
+    constexpr uint32_t FRAME_SAMPLES = 480;
+    constexpr int FRAME_MS = 10;
+    constexpr int DURATION_MS = 60000;
+    constexpr int TALKSPURT_MS = 2000;
+    constexpr int SILENCE_MS = 1000;
+    constexpr int COMFORT_NOISE_MS = 200;
+    constexpr size_t MAX_SLICE_SIZE = 1200;
+
+    struct Scenario {
+        const char* name;
+        double base_delay_ms;
+        double jitter_ms;        // Normal dağılımlı gecikme sapması
+        double spike_probability; // Ağ tıkanması: 100 ms ek gecikme
+        double loss;
+        double duplicate;
+        double max_latency_ms;   // Ortalama gecikme için üst sınır
+        double max_late_percent; // Ağ kaybı dışındaki bozulma (geç + buffer kaybı)
+        size_t frame_bytes;      // Konuşma frame'inin kodlanmış boyu (> MAX_SLICE_SIZE: parçalı)
+        size_t packet_frames;    // Pakette birleştirilen konuşma frame'i (20-60 ms paketler)
+    };
+
+    struct Sent {
+        core::Packet packet;
+        size_t frames;           // Paketteki frame sayısı (her biri frame_bytes)
+        double arrival_ms;
+    };
+
+    struct Result {
+        double average_latency_ms = 0.0;
+        double p95_latency_ms = 0.0;
+        double degraded_percent = 0.0;
+        double network_loss_percent = 0.0;
+        double fec_available_percent = 0.0;  // FEC için sonraki paketi verilen kayıplar
+        size_t corrupted = 0;                // İçeriği gönderilenle eşleşmeyen frame'ler
+        streaming::JitterBufferStats stats;
+    };
+
+    Result simulate(const Scenario& scenario, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::normal_distribution<double> jitter(0.0, scenario.jitter_ms);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+        // Gönderilen paketler; konuşma payload'ının ilk 4 byte'ı gönderim zamanıdır,
+        // kalan byte'lar gönderim zamanından türetilen bir desendir
+        auto pattern = [](int send_ms, size_t index) { return static_cast<uint8_t>(send_ms / FRAME_MS + index * 7); };
+        std::vector<Sent> sent;
+        streaming::Slicer slicer;
+        size_t speech_packets = 0;
+        size_t network_lost = 0;
+
+        // Paketi t anında gönderir; parçalardan biri kaybolursa paketin tüm frame'leri kaybolur
+        auto send = [&](const std::vector<uint8_t>& payload, uint32_t timestamp, int t, size_t frames, bool speech) {
+            core::PacketView views[core::MAX_FRAGMENTS];
+            const size_t count = slicer.slice(payload.data(), payload.size(), MAX_SLICE_SIZE, timestamp,
+                                              views, core::MAX_FRAGMENTS, static_cast<uint32_t>(frames));
+            bool lost = false;
+            for (size_t i = 0; i < count; ++i) {
+                core::Packet packet;
+                packet.sequence_number = views[i].sequence_number;
+                packet.timestamp = views[i].timestamp;
+                packet.fragment_index = views[i].fragment_index;
+                packet.fragment_count = views[i].fragment_count;
+                packet.frame_size = views[i].frame_size;
+                packet.data.assign(views[i].data, views[i].data + views[i].size);
+                if (uniform(rng) < scenario.loss) {
+                    lost = true;
+                    continue;
+                }
+                double delay = scenario.base_delay_ms + std::fabs(jitter(rng));
+                if (uniform(rng) < scenario.spike_probability) {
+                    delay += 100.0;
+                }
+                sent.push_back({packet, frames, t + delay});
+                if (uniform(rng) < scenario.duplicate) {
+                    sent.push_back({packet, frames, t + delay + 5.0});
+                }
+            }
+            network_lost += (speech && lost) ? frames : 0;
+        };
+
+        std::vector<uint8_t> bundle;
+        size_t bundle_frames = 0;
+        uint32_t bundle_timestamp = 0;
+        for (int t = 0; t < DURATION_MS; t += FRAME_MS) {
+            const int phase = t % (TALKSPURT_MS + SILENCE_MS);
+            const bool speech = phase < TALKSPURT_MS;
+            if (!speech && (phase - TALKSPURT_MS) % COMFORT_NOISE_MS != 0) {
+                continue;
+            }
+
+            const uint32_t timestamp = static_cast<uint32_t>(t / FRAME_MS) * FRAME_SAMPLES;
+            if (!speech) {
+                // Konuşmanın son frame'leri comfort noise işaretinden önce gider
+                if (bundle_frames > 0) {
+                    send(bundle, bundle_timestamp, t, bundle_frames, true);
+                    bundle.clear();
+                    bundle_frames = 0;
+                }
+                send(std::vector<uint8_t>{0x44}, timestamp, t, 1, false);
+                continue;
+            }
+
+            std::vector<uint8_t> frame(scenario.frame_bytes);
+            for (size_t b = 4; b < frame.size(); ++b) {
+                frame[b] = pattern(t, b);
+            }
+            for (int b = 0; b < 4; ++b) {
+                frame[b] = static_cast<uint8_t>(t >> (8 * b));
+            }
+            ++speech_packets;
+
+            if (bundle_frames == 0) {
+                bundle_timestamp = timestamp;
+            }
+            bundle.insert(bundle.end(), frame.begin(), frame.end());
+            if (++bundle_frames == scenario.packet_frames) {
+                send(bundle, bundle_timestamp, t, bundle_frames, true);
+                bundle.clear();
+                bundle_frames = 0;
+            }
+        }
+        std::stable_sort(sent.begin(), sent.end(), [](const Sent& a, const Sent& b) { return a.arrival_ms < b.arrival_ms; });
+
+        // Oynatma: her 10 ms'de bir pop()
+        streaming::Collector collector(SAMPLE_RATE, FRAME_SAMPLES);
+        collector.set_packet_frames(scenario.packet_frames);
+        const auto epoch = streaming::Collector::Clock::now();
+        auto at = [&](double ms) {
+            return epoch + std::chrono::duration_cast<streaming::Collector::Clock::duration>(
+                std::chrono::duration<double, std::milli>(ms));
+        };
+
+        std::vector<double> latencies;
+        std::vector<uint8_t> out(streaming::Collector::MAX_FRAME_SIZE);
+        size_t next_arrival = 0;
+        size_t lost_with_fec = 0;
+        size_t corrupted = 0;
+        for (int t = 0; t < DURATION_MS + 1000; t += FRAME_MS) {
+            while (next_arrival < sent.size() && sent[next_arrival].arrival_ms <= t) {
+                const Sent& arrived = sent[next_arrival++];
+                if (arrived.frames == 1) {
+                    collector.insert(arrived.packet, at(arrived.arrival_ms));
+                    continue;
+                }
+                // Paket frame'lerine bölünür; frame i bir sonraki sıra numarasını alır ve
+                // geliş zamanı son frame'e hizalanır (uygulamadaki gibi)
+                for (size_t i = 0; i < arrived.frames; ++i) {
+                    core::PacketView frame = arrived.packet.view();
+                    frame.sequence_number += static_cast<uint32_t>(i);
+                    frame.timestamp += static_cast<uint32_t>(i) * FRAME_SAMPLES;
+                    frame.data += i * scenario.frame_bytes;
+                    frame.size = scenario.frame_bytes;
+                    collector.insert(frame, at(arrived.arrival_ms - static_cast<double>((arrived.frames - 1 - i) * FRAME_MS)));
+                }
+            }
+            size_t size = 0;
+            const auto status = collector.pop(out.data(), out.size(), size, at(t));
+            lost_with_fec += (status == streaming::Collector::Playout::Lost && size > 0) ? 1 : 0;
+            if (status == streaming::Collector::Playout::Frame && size > 1) {
+                int send_ms = 0;
+                for (int b = 0; b < 4; ++b) {
+                    send_ms |= static_cast<int>(out[b]) << (8 * b);
+                }
+                latencies.push_back(t - send_ms);
+                bool intact = size == scenario.frame_bytes;
+                for (size_t b = 4; intact && b < size; ++b) {
+                    intact = out[b] == pattern(send_ms, b);
+                }
+                corrupted += intact ? 0 : 1;
+            }
+        }
+
+        Result result;
+        result.stats = collector.stats();
+        result.corrupted = corrupted;
+        std::sort(latencies.begin(), latencies.end());
+        if (!latencies.empty()) {
+            double sum = 0.0;
+            for (double latency : latencies) {
+                sum += latency;
+            }
+            result.average_latency_ms = sum / latencies.size();
+            result.p95_latency_ms = latencies[latencies.size() * 95 / 100];
+        }
+        const size_t delivered = speech_packets - network_lost;
+        result.degraded_percent = 100.0 * (delivered - std::min(delivered, latencies.size())) / speech_packets;
+        result.network_loss_percent = 100.0 * network_lost / speech_packets;
+        if (result.stats.lost > 0) {
+            result.fec_available_percent = 100.0 * lost_with_fec / result.stats.lost;
+        }
+        return result;
+    }
+}
+
+int main() {
+    std::cout << CYAN << "🧪 Jitter Buffer Simülasyonu" << RESET << std::endl;
+
+    const Scenario scenarios[] = {
+        {"LAN",              2.0,  1.0, 0.0,   0.0,  0.0,   40.0, 1.0,   80, 1},
+        {"WAN",             40.0, 15.0, 0.0,   0.01, 0.005, 130.0, 2.0,  80, 1},
+        {"WAN + tıkanma",   40.0, 10.0, 0.01,  0.02, 0.0,   160.0, 3.0,  80, 1},
+        {"Mobil",           60.0, 30.0, 0.005, 0.03, 0.01,  220.0, 3.0,  80, 1},
+        {"WAN, 3 parçalı",  40.0, 15.0, 0.0,   0.01, 0.005, 130.0, 2.0, 3000, 1},
+        {"LAN, 60 ms paket", 2.0,  1.0, 0.0,   0.0,  0.0,   90.0, 1.0,   80, 6},
+        {"WAN, 40 ms paket", 40.0, 15.0, 0.0,  0.01, 0.005, 170.0, 2.0,  80, 4},
+    };
+
+    bool all_ok = true;
+    for (const Scenario& scenario : scenarios) {
+        const Result r = simulate(scenario, 11);
+        const bool ok = r.average_latency_ms <= scenario.max_latency_ms &&
+                        r.degraded_percent <= scenario.max_late_percent && r.corrupted == 0;
+        all_ok = all_ok && ok;
+
+        std::cout << "\n" << YELLOW << "📊 " << scenario.name << RESET << " (taban " << scenario.base_delay_ms
+                  << " ms, jitter σ=" << scenario.jitter_ms << " ms, kayıp " << (scenario.loss * 100.0) << "%, frame "
+                  << scenario.frame_bytes << " byte, paket " << scenario.packet_frames * FRAME_MS << " ms)" << std::endl;
+        std::cout << "   Ağızdan kulağa: ort " << r.average_latency_ms << " ms, p95 " << r.p95_latency_ms
+                  << " ms (ölçülen jitter " << r.stats.jitter_ms << " ms, hedef " << r.stats.target_delay_ms << " ms)" << std::endl;
+        std::cout << "   Bozulma (geç + buffer kaybı): " << r.degraded_percent << "%, ağ kaybı: "
+                  << r.network_loss_percent << "%, FEC ile kurtarılabilir kayıp: " << r.fec_available_percent << "%" << std::endl;
+        std::cout << "   geç/kayıp/tekrar/atılan/boşalma: " << r.stats.late << "/" << r.stats.lost << "/"
+                  << r.stats.duplicates << "/" << r.stats.discarded << "/" << r.stats.underruns
+                  << ", birleştirilen/eksik/bozuk: " << r.stats.reassembled << "/" << r.stats.incomplete << "/"
+                  << r.corrupted << "  " << (ok ? GREEN "OK" : RED "FAIL") << RESET << std::endl;
+    }
+    return all_ok ? 0 : 1;
+}
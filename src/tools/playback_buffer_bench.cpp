@@ -0,0 +1,158 @@
+// src/tools/playback_buffer_bench.cpp - Playback buffer mikrobenchmark'ı
+//
+// Eski yöntem (std::mutex + std::vector insert/erase) ile kilitsiz SPSC ring buffer'ı
+// karşılaştırır. Üretici thread network thread'ini (decode edilmiş frame'ler), tüketici
+// thread ise PortAudio callback'ini taklit eder. Tüketici tarafındaki her pop'un süresi
+// ölçülür; gerçek zamanlı callback için önemli olan en kötü durum gecikmesidir.
+
+#include "core/spsc_ring_buffer.hpp"
+#include <iostream>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <string>
+
+#define RESET   "\033[0m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define CYAN    "\033[36m"
+
+namespace {
+    constexpr size_t FRAME_SAMPLES = 480;        // 10ms @ 48kHz
+    constexpr size_t MAX_BUFFER_SAMPLES = 48000; // 1 saniye
+
+    struct BenchResult {
+        double avg_pop_ns = 0.0;
+        double p99_pop_ns = 0.0;
+        double max_pop_ns = 0.0;
+        double total_ms = 0.0;
+    };
+
+    // Application'daki eski playback_buffer_ + playback_mutex_ yaklaşımı
+    class VectorPlaybackBuffer {
+    public:
+        void push(const int16_t* data, size_t count) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            buffer_.insert(buffer_.end(), data, data + count);
+            if (buffer_.size() > MAX_BUFFER_SAMPLES) {
+                buffer_.erase(buffer_.begin(), buffer_.begin() + (buffer_.size() - MAX_BUFFER_SAMPLES));
+            }
+        }
+
+        size_t pop(int16_t* data, size_t count) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (buffer_.size() < count) {
+                return 0;
+            }
+            std::memcpy(data, buffer_.data(), count * sizeof(int16_t));
+            buffer_.erase(buffer_.begin(), buffer_.begin() + count);
+            return count;
+        }
+
+    private:
+        std::vector<int16_t> buffer_;
+        std::mutex mutex_;
+    };
+
+    // Application'daki yeni yaklaşım: SPSC ring + tüketici tarafında gecikme sınırı
+    class RingPlaybackBuffer {
+    public:
+        RingPlaybackBuffer() : ring_(MAX_BUFFER_SAMPLES) {}
+
+        void push(const int16_t* data, size_t count) {
+            ring_.push(data, count);
+        }
+
+        size_t pop(int16_t* data, size_t count) {
+            const size_t buffered = ring_.size();
+            if (buffered > MAX_BUFFER_SAMPLES) {
+                ring_.discard(buffered - MAX_BUFFER_SAMPLES);
+            }
+            if (ring_.size() < count) {
+                return 0;
+            }
+            return ring_.pop(data, count);
+        }
+
+    private:
+        core::SpscRingBuffer<int16_t> ring_;
+    };
+
+    template <typename Buffer>
+    BenchResult run_bench(size_t frames) {
+        Buffer buffer;
+        std::atomic<bool> producer_done{false};
+        std::vector<double> pop_times;
+        pop_times.reserve(frames);
+
+        const auto start = std::chrono::steady_clock::now();
+
+        // Üretici biraz daha hızlı üretir, böylece buffer dolu kalır ve
+        // eski yaklaşımda büyük erase işlemleri tetiklenir.
+        std::thread producer([&]() {
+            std::vector<int16_t> frame(FRAME_SAMPLES);
+            for (size_t i = 0; i < frames * 2; ++i) {
+                std::fill(frame.begin(), frame.end(), static_cast<int16_t>(i));
+                buffer.push(frame.data(), frame.size());
+            }
+            producer_done = true;
+        });
+
+        std::vector<int16_t> output(FRAME_SAMPLES);
+        size_t popped = 0;
+        while (popped < frames) {
+            const bool done = producer_done;
+            const auto t0 = std::chrono::steady_clock::now();
+            const size_t got = buffer.pop(output.data(), output.size());
+            const auto t1 = std::chrono::steady_clock::now();
+            pop_times.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count());
+            if (got > 0) {
+                ++popped;
+            } else if (done) {
+                break; // Üretici bitti ve buffer boşaldı
+            }
+        }
+        producer.join();
+
+        const auto end = std::chrono::steady_clock::now();
+
+        BenchResult result;
+        result.total_ms = std::chrono::duration<double, std::milli>(end - start).count();
+        if (!pop_times.empty()) {
+            double sum = 0.0;
+            for (double t : pop_times) { sum += t; }
+            result.avg_pop_ns = sum / pop_times.size();
+            std::sort(pop_times.begin(), pop_times.end());
+            result.p99_pop_ns = pop_times[pop_times.size() * 99 / 100];
+            result.max_pop_ns = pop_times.back();
+        }
+        return result;
+    }
+
+    void print_result(const std::string& name, const BenchResult& r) {
+        std::cout << "   " << GREEN << name << RESET
+                  << "  avg: " << r.avg_pop_ns << " ns"
+                  << ", p99: " << r.p99_pop_ns << " ns"
+                  << ", max: " << r.max_pop_ns << " ns"
+                  << ", total: " << r.total_ms << " ms" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t frames = 20000;
+    if (argc > 1) {
+        frames = static_cast<size_t>(std::stoul(argv[1]));
+    }
+
+    std::cout << CYAN << "🧪 Playback Buffer Benchmark" << RESET << std::endl;
+    std::cout << "   " << YELLOW << "Frames: " << frames << " x " << FRAME_SAMPLES << " samples" << RESET << std::endl;
+
+    print_result("vector + mutex ", run_bench<VectorPlaybackBuffer>(frames));
+    print_result("SPSC ring      ", run_bench<RingPlaybackBuffer>(frames));
+    return 0;
+}
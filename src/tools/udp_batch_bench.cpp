@@ -0,0 +1,164 @@
+// src/tools/udp_batch_bench.cpp - Toplu (sendmmsg/recvmmsg) ve paket başına UDP I/O karşılaştırması
+//
+// Loopback üzerinde:
+//  - Gönderim: UdpSender ile okunmayan bir sokete N paket gönderilir, paket/saniye ölçülür.
+//  - Alım: UdpReceiver çalışırken toplu gönderici N paket gönderir; alınan paket sayısı ve
+//    ilk/son paket arasındaki süreden alım hızı ölçülür (çekirdek buffer'ı taşarsa kayıp olur).
+// Her batch boyutu (1 = paket başına sistem çağrısı) için tekrarlanır.
+
+#include "network/udp_sender.hpp"
+#include "network/udp_receiver.hpp"
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+
+#define RESET   "\033[0m"
+#define RED     "\033[31m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define CYAN    "\033[36m"
+
+namespace {
+    constexpr size_t PACKET_COUNT = 200000;
+    constexpr size_t PAYLOAD_SIZE = 100;         // ~64 kbps Opus frame'i
+    constexpr size_t PACKETS_PER_CALL = 32;      // Bir send() çağrısındaki paket (çok akışlı sunucu)
+    constexpr int SEND_PORT = 47811;
+    constexpr int RECEIVE_PORT = 47812;
+
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<core::Packet> make_packets() {
+        std::vector<core::Packet> packets(PACKETS_PER_CALL);
+        for (size_t i = 0; i < packets.size(); ++i) {
+            packets[i].sequence_number = static_cast<uint32_t>(i);
+            packets[i].data.resize(PAYLOAD_SIZE);
+        }
+        return packets;
+    }
+
+    // Okunmayan hedef soket: gönderim tarafı bağımsız ölçülür
+    int open_sink(int port) {
+        const int sink = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(port);
+        if (sink < 0 || bind(sink, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0) {
+            return -1;
+        }
+        return sink;
+    }
+
+    double measure_send(size_t batch_size) {
+        network::UdpSender sender(batch_size);
+        if (!sender.connect("127.0.0.1", SEND_PORT)) {
+            return 0.0;
+        }
+        auto packets = make_packets();
+
+        const auto start = Clock::now();
+        for (size_t sent = 0; sent < PACKET_COUNT; sent += packets.size()) {
+            sender.send(packets);
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        return PACKET_COUNT / seconds;
+    }
+
+    struct ReceiveResult {
+        size_t received = 0;
+        double packets_per_second = 0.0;
+    };
+
+    ReceiveResult measure_receive(size_t batch_size) {
+        std::atomic<size_t> received{0};
+        std::atomic<int64_t> first_ns{0};
+        std::atomic<int64_t> last_ns{0};
+
+        ReceiveResult result;
+        {
+            network::UdpReceiver receiver(batch_size);
+            const bool started = receiver.start(RECEIVE_PORT, [&](const core::PooledPacket&) {
+                const int64_t now = Clock::now().time_since_epoch().count();
+                if (received.fetch_add(1, std::memory_order_relaxed) == 0) {
+                    first_ns.store(now, std::memory_order_relaxed);
+                }
+                last_ns.store(now, std::memory_order_relaxed);
+            });
+            if (!started) {
+                return result;
+            }
+
+            network::UdpSender sender(network::UdpSender::DEFAULT_BATCH_SIZE);
+            sender.connect("127.0.0.1", RECEIVE_PORT);
+            auto packets = make_packets();
+            for (size_t sent = 0; sent < PACKET_COUNT; sent += packets.size()) {
+                sender.send(packets);
+            }
+
+            // Alıcı kuyruğu boşaltana kadar bekle
+            size_t previous = 0;
+            do {
+                previous = received.load();
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            } while (received.load() != previous);
+            receiver.stop();
+        }
+
+        result.received = received.load();
+        const double seconds = Clock::duration(last_ns.load() - first_ns.load()) / std::chrono::duration<double>(1.0);
+        if (result.received > 1 && seconds > 0.0) {
+            result.packets_per_second = (result.received - 1) / seconds;
+        }
+        return result;
+    }
+}
+
+int main() {
+    std::cout << CYAN << "🧪 UDP Toplu I/O Benchmark'ı (loopback, " << PACKET_COUNT << " paket, "
+              << PAYLOAD_SIZE << " byte payload)" << RESET << std::endl;
+
+    const int sink = open_sink(SEND_PORT);
+    if (sink < 0) {
+        std::cerr << RED << "HATA: Hedef soket açılamadı" << RESET << std::endl;
+        return 1;
+    }
+
+    {
+        network::UdpSender probe(network::UdpSender::DEFAULT_BATCH_SIZE);
+        std::cout << "   Toplu I/O: " << (probe.batching() ? GREEN "sendmmsg/recvmmsg" : YELLOW "mevcut değil (paket başına)")
+                  << RESET << std::endl;
+    }
+
+    bool all_ok = true;
+    double baseline_send = 0.0;
+    double baseline_receive = 0.0;
+    for (size_t batch_size : {size_t(1), size_t(8), size_t(32)}) {
+        const double send_pps = measure_send(batch_size);
+        const ReceiveResult receive = measure_receive(batch_size);
+        if (batch_size == 1) {
+            baseline_send = send_pps;
+            baseline_receive = receive.packets_per_second;
+        }
+        const bool ok = receive.received > 0 && send_pps > 0.0;
+        all_ok = all_ok && ok;
+
+        std::cout << "\n" << YELLOW << "📊 Batch " << batch_size << RESET << std::endl;
+        std::cout << "   Gönderim: " << GREEN << static_cast<uint64_t>(send_pps) << " paket/s" << RESET;
+        if (baseline_send > 0.0) {
+            std::cout << " (" << (send_pps / baseline_send) << "x)";
+        }
+        std::cout << std::endl;
+        std::cout << "   Alım:     " << GREEN << static_cast<uint64_t>(receive.packets_per_second) << " paket/s" << RESET;
+        if (baseline_receive > 0.0) {
+            std::cout << " (" << (receive.packets_per_second / baseline_receive) << "x)";
+        }
+        std::cout << ", alınan " << receive.received << "/" << PACKET_COUNT
+                  << "  " << (ok ? GREEN "OK" : RED "FAIL") << RESET << std::endl;
+    }
+
+    close(sink);
+    return all_ok ? 0 : 1;
+}